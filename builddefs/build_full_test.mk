@@ -27,6 +27,7 @@ $(TEST)_SRC := \
 	tests/test_common/keycode_util.cpp \
 	tests/test_common/keycode_table.cpp \
 	tests/test_common/test_fixture.cpp \
+	tests/test_common/test_benchmark.cpp \
 	tests/test_common/test_keymap_key.cpp \
 	tests/test_common/test_logger.cpp \
 	$(patsubst $(ROOTDIR)/%,%,$(wildcard $(TEST_PATH)/*.cpp))
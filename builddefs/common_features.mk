@@ -597,6 +597,9 @@ ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
         ifeq ($(strip $(WS2812_DRIVER)), pwm)
             OPT_DEFS += -DSTM32_DMA_REQUIRED=TRUE
         endif
+        ifeq ($(strip $(WS2812_DRIVER)), spi)
+            SRC += ws2812_spi_encoder.c
+        endif
     endif
 
     # add extra deps
@@ -686,7 +689,9 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     # Determine which (if any) transport files are required
     ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
         QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c \
-                       $(QUANTUM_DIR)/split_common/transactions.c
+                       $(QUANTUM_DIR)/split_common/transactions.c \
+                       $(QUANTUM_DIR)/split_common/transport_delta.c \
+                       $(QUANTUM_DIR)/split_common/transaction_stats.c
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
 
@@ -815,6 +820,9 @@ ifeq ($(strip $(SEND_STRING_ENABLE)), yes)
     OPT_DEFS += -DSEND_STRING_ENABLE
     COMMON_VPATH += $(QUANTUM_DIR)/send_string
     SRC += $(QUANTUM_DIR)/send_string/send_string.c
+    ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+        OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+    endif
 endif
 
 ifeq ($(strip $(AUTO_SHIFT_ENABLE)), yes)
@@ -31,6 +31,7 @@ GENERIC_FEATURES = \
     KEY_LOCK \
     KEY_OVERRIDE \
     LEADER \
+    OUTPUT_QUEUE \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
     SECURE \
@@ -86,7 +86,9 @@ OTHER_OPTION_NAMES = \
   CAPS_WORD_ENABLE \
   AUTOCORRECT_ENABLE \
   TRI_LAYER_ENABLE \
-  REPEAT_KEY_ENABLE
+  REPEAT_KEY_ENABLE \
+  OUTPUT_QUEUE_ENABLE \
+  SEND_STRING_ASYNC_ENABLE
 
 define NAME_ECHO
        @printf "  %-30s = %-16s # %s\\n" "$1" "$($1)" "$(origin $1)"
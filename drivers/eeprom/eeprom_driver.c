@@ -77,3 +77,11 @@ void eeprom_update_dword(uint32_t *addr, uint32_t value) {
         eeprom_write_dword(addr, value);
     }
 }
+
+__attribute__((weak)) void eeprom_driver_flush(void) {}
+
+__attribute__((weak)) void eeprom_driver_task(void) {}
+
+__attribute__((weak)) bool eeprom_driver_next_flush(uint32_t *flush_time) {
+    return false;
+}
@@ -16,7 +16,14 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include "eeprom.h"
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+/* Write-back caching, for backends which hold writes in RAM before committing them (EEPROM_WRITE_BACK_CACHE). The
+ * default implementations do nothing. */
+void eeprom_driver_flush(void);
+void eeprom_driver_task(void);
+bool eeprom_driver_next_flush(uint32_t *flush_time);
@@ -6,18 +6,140 @@
 #include "eeprom_driver.h"
 #include "wear_leveling.h"
 
+#ifdef EEPROM_WRITE_BACK_CACHE
+#    include "timer.h"
+
+#    ifndef EEPROM_WRITE_BACK_CACHE_SIZE
+#        define EEPROM_WRITE_BACK_CACHE_SIZE 64
+#    endif
+
+#    ifndef EEPROM_WRITE_BACK_FLUSH_DELAY
+#        define EEPROM_WRITE_BACK_FLUSH_DELAY 100
+#    endif
+
+// Unchanged runs shorter than this are written along with the changes either side -- a single unchanged byte costs less
+// than the header of another log entry, anything longer costs more
+#    define EEPROM_WRITE_BACK_MERGE_GAP 2
+
+/*
+    Writes are held back in a RAM window covering a single range of the EEPROM, and written to the wear-leveling layer
+    once EEPROM_WRITE_BACK_FLUSH_DELAY milliseconds pass without further writes, or when a write falls outside the
+    window. Sequential byte-at-a-time updates, such as VIA keymap uploads, then reach the write log as a few block
+    writes instead of one log entry per byte.
+*/
+static struct {
+    uint8_t  data[EEPROM_WRITE_BACK_CACHE_SIZE];
+    uint32_t address;    // Address of data[0]
+    uint32_t length;     // Bytes held in the window, zero when there's nothing to write
+    uint32_t last_write; // Time of the last write into the window
+} write_back;
+
+void eeprom_driver_flush(void) {
+    if (write_back.length == 0) {
+        return;
+    }
+
+    // Only pass on the parts of the window which differ from what's stored
+    uint8_t stored[EEPROM_WRITE_BACK_CACHE_SIZE];
+    wear_leveling_read(write_back.address, stored, write_back.length);
+    uint32_t i = 0;
+    while (i < write_back.length) {
+        if (write_back.data[i] == stored[i]) {
+            i++;
+            continue;
+        }
+        uint32_t start = i;
+        uint32_t end   = i + 1;
+        for (uint32_t j = end; j < write_back.length && j < end + EEPROM_WRITE_BACK_MERGE_GAP; j++) {
+            if (write_back.data[j] != stored[j]) {
+                end = j + 1;
+            }
+        }
+        wear_leveling_write(write_back.address + start, &write_back.data[start], end - start);
+        i = end;
+    }
+
+    write_back.length = 0;
+}
+
+void eeprom_driver_task(void) {
+    if (write_back.length != 0 && timer_elapsed32(write_back.last_write) >= EEPROM_WRITE_BACK_FLUSH_DELAY) {
+        eeprom_driver_flush();
+    }
+}
+
+bool eeprom_driver_next_flush(uint32_t *flush_time) {
+    if (write_back.length == 0) {
+        return false;
+    }
+    *flush_time = write_back.last_write + EEPROM_WRITE_BACK_FLUSH_DELAY;
+    return true;
+}
+#endif // EEPROM_WRITE_BACK_CACHE
+
 void eeprom_driver_init(void) {
+#ifdef EEPROM_WRITE_BACK_CACHE
+    write_back.length = 0;
+#endif
     wear_leveling_init();
 }
 
 void eeprom_driver_erase(void) {
+#ifdef EEPROM_WRITE_BACK_CACHE
+    write_back.length = 0;
+#endif
     wear_leveling_erase();
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    wear_leveling_read((uint32_t)addr, buf, len);
+    uint32_t address = (uint32_t)(uintptr_t)addr;
+    wear_leveling_read(address, buf, len);
+
+#ifdef EEPROM_WRITE_BACK_CACHE
+    // Overlay anything not yet written back
+    uint32_t start = address > write_back.address ? address : write_back.address;
+    uint32_t end   = address + len < write_back.address + write_back.length ? address + len : write_back.address + write_back.length;
+    if (start < end) {
+        memcpy((uint8_t *)buf + (start - address), &write_back.data[start - write_back.address], end - start);
+    }
+#endif
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    wear_leveling_write((uint32_t)addr, buf, len);
+    uint32_t address = (uint32_t)(uintptr_t)addr;
+#ifdef EEPROM_WRITE_BACK_CACHE
+    if (write_back.length != 0) {
+        uint32_t start = address < write_back.address ? address : write_back.address;
+        uint32_t end   = address + len > write_back.address + write_back.length ? address + len : write_back.address + write_back.length;
+        if (end - start > EEPROM_WRITE_BACK_CACHE_SIZE) {
+            eeprom_driver_flush();
+        } else {
+            // Grow the window to cover the write, filling any new space with what's stored
+            if (start < write_back.address) {
+                memmove(&write_back.data[write_back.address - start], write_back.data, write_back.length);
+                wear_leveling_read(start, write_back.data, write_back.address - start);
+            }
+            if (end > write_back.address + write_back.length) {
+                wear_leveling_read(write_back.address + write_back.length, &write_back.data[write_back.address + write_back.length - start], end - (write_back.address + write_back.length));
+            }
+            write_back.address = start;
+            write_back.length  = end - start;
+        }
+    }
+
+    if (len > EEPROM_WRITE_BACK_CACHE_SIZE) {
+        // Too large to hold back, and already a block write
+        wear_leveling_write(address, buf, len);
+        return;
+    }
+
+    if (write_back.length == 0) {
+        write_back.address = address;
+        write_back.length  = len;
+    }
+    memcpy(&write_back.data[address - write_back.address], buf, len);
+    write_back.last_write = timer_read32();
+#else
+    wear_leveling_write(address, buf, len);
+#endif
 }
@@ -74,6 +74,12 @@
 #    define ISSI_GLOBALCURRENT 0xFF
 #endif
 
+// Unchanged registers bridged between two changed ones rather than starting a new transfer,
+// which costs the register address byte plus I2C addressing and start/stop overhead
+#ifndef ISSI_PWM_COALESCE_GAP
+#    define ISSI_PWM_COALESCE_GAP 2
+#endif
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
 
@@ -86,6 +92,11 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[LED_DRIVER_COUNT][192];
 bool    g_pwm_buffer_update_required[LED_DRIVER_COUNT] = {false};
 
+// Tracks which PWM registers differ from the driver, so only those need to be flushed.
+// Until a full page has been written successfully the driver contents are unknown.
+static uint8_t g_pwm_buffer_dirty[LED_DRIVER_COUNT][192 / 8];
+static bool    g_pwm_buffer_synced[LED_DRIVER_COUNT] = {false};
+
 /* There's probably a better way to init this... */
 #if LED_DRIVER_COUNT == 1
 uint8_t g_led_control_registers[LED_DRIVER_COUNT][24] = {{0}};
@@ -146,6 +157,64 @@ bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     return true;
 }
 
+static bool IS31FL3733_write_pwm_registers(uint8_t addr, uint8_t *pwm_buffer, uint8_t first, uint8_t count) {
+    // Assumes PG1 is already selected, and count is at most 16.
+    g_twi_transfer_buffer[0] = first;
+    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + first, count);
+
+#if ISSI_PERSISTENCE > 0
+    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, count + 1, ISSI_TIMEOUT) != 0) {
+            return false;
+        }
+    }
+#else
+    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, count + 1, ISSI_TIMEOUT) != 0) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+static inline void IS31FL3733_set_pwm_register(uint8_t index, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[index][reg] != value) {
+        g_pwm_buffer[index][reg] = value;
+        g_pwm_buffer_dirty[index][reg / 8] |= (1 << (reg % 8));
+        g_pwm_buffer_update_required[index] = true;
+    }
+}
+
+static inline bool IS31FL3733_pwm_register_dirty(uint8_t index, uint8_t reg) {
+    return g_pwm_buffer_dirty[index][reg / 8] & (1 << (reg % 8));
+}
+
+static bool IS31FL3733_write_dirty_pwm_registers(uint8_t addr, uint8_t index) {
+    // Assumes PG1 is already selected.
+    // If any of the transactions fails function returns false.
+    int reg = 0;
+    while (reg < 192) {
+        if (!IS31FL3733_pwm_register_dirty(index, reg)) {
+            reg++;
+            continue;
+        }
+
+        // Extend the run over nearby dirty registers, up to the 16 bytes of a single transfer
+        int start = reg;
+        int end   = reg + 1;
+        for (int probe = end; probe < 192 && probe - start < 16 && probe - end <= ISSI_PWM_COALESCE_GAP; probe++) {
+            if (IS31FL3733_pwm_register_dirty(index, probe)) {
+                end = probe + 1;
+            }
+        }
+
+        if (!IS31FL3733_write_pwm_registers(addr, g_pwm_buffer[index], start, end - start)) {
+            return false;
+        }
+        reg = end;
+    }
+    return true;
+}
+
 void IS31FL3733_init(uint8_t addr, uint8_t sync) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
@@ -190,14 +259,21 @@ void IS31FL3733_init(uint8_t addr, uint8_t sync) {
 
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
+
+    // The PWM registers were cleared above, so the next flush must rewrite the whole page.
+    // Which index this driver is flushed under isn't known here, so resync all of them.
+    memset(g_pwm_buffer_dirty, 0, sizeof(g_pwm_buffer_dirty));
+    memset(g_pwm_buffer_synced, 0, sizeof(g_pwm_buffer_synced));
+    for (int i = 0; i < LED_DRIVER_COUNT; i++) {
+        g_pwm_buffer_update_required[i] = true;
+    }
 }
 
 void IS31FL3733_set_value(int index, uint8_t value) {
     if (index >= 0 && index < LED_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.v]          = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3733_set_pwm_register(led.driver, led.v, value);
     }
 }
 
@@ -228,9 +304,23 @@ void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
+        bool any_dirty = false;
+        for (int i = 0; i < sizeof(g_pwm_buffer_dirty[index]); i++) {
+            any_dirty |= g_pwm_buffer_dirty[index][i];
+        }
+
+        if (!g_pwm_buffer_synced[index] || !any_dirty) {
+            // Driver state unknown, or g_pwm_buffer was modified directly, so rewrite the whole page
+            g_pwm_buffer_synced[index] = IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        } else {
+            // Only send runs of changed registers; on failure fall back to a full page next time
+            g_pwm_buffer_synced[index] = IS31FL3733_write_dirty_pwm_registers(addr, index);
+        }
+        memset(g_pwm_buffer_dirty[index], 0, sizeof(g_pwm_buffer_dirty[index]));
+
         // If any of the transactions fail we risk writing dirty PG0,
         // refresh page 0 just in case.
-        if (!IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        if (!g_pwm_buffer_synced[index]) {
             g_led_control_registers_update_required[index] = true;
         }
         g_pwm_buffer_update_required[index] = false;
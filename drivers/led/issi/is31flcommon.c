@@ -21,6 +21,7 @@
 #include "is31flcommon.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include "util.h"
 #include <string.h>
 
 // Set defaults for Timeout and Persistence
@@ -30,6 +31,16 @@
 #ifndef ISSI_PERSISTENCE
 #    define ISSI_PERSISTENCE 0
 #endif
+// Unchanged registers bridged between two changed ones rather than starting a new transfer,
+// which costs the register address byte plus I2C addressing and start/stop overhead
+#ifndef ISSI_PWM_COALESCE_GAP
+#    define ISSI_PWM_COALESCE_GAP 2
+#endif
+// Most flushes skipped between attempts to rewrite the PWM page of a driver that keeps failing,
+// as each attempt can cost up to ISSI_TIMEOUT
+#ifndef ISSI_PWM_RESYNC_BACKOFF
+#    define ISSI_PWM_RESYNC_BACKOFF 128
+#endif
 
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
@@ -39,6 +50,14 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+// Tracks which PWM registers differ from the driver, so only those need to be flushed.
+// Until a full page has been written successfully the driver contents are unknown.
+static uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][(ISSI_MAX_LEDS + 7) / 8];
+static bool    g_pwm_buffer_synced[DRIVER_COUNT] = {false};
+// Flushes left to skip before the next attempt, and how many to skip after the next failure
+static uint8_t g_pwm_buffer_resync_wait[DRIVER_COUNT]    = {0};
+static uint8_t g_pwm_buffer_resync_backoff[DRIVER_COUNT] = {0};
+
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
 
@@ -118,15 +137,82 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
 
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
+
+    // The PWM registers are back to their reset state, so the next flush must rewrite the whole page.
+    // Which index this driver is flushed under isn't known here, so resync all of them.
+    memset(g_pwm_buffer_dirty, 0, sizeof(g_pwm_buffer_dirty));
+    memset(g_pwm_buffer_synced, 0, sizeof(g_pwm_buffer_synced));
+    memset(g_pwm_buffer_resync_wait, 0, sizeof(g_pwm_buffer_resync_wait));
+    memset(g_pwm_buffer_resync_backoff, 0, sizeof(g_pwm_buffer_resync_backoff));
+}
+
+static inline void IS31FL_set_pwm_register(uint8_t index, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[index][reg] != value) {
+        g_pwm_buffer[index][reg] = value;
+        g_pwm_buffer_dirty[index][reg / 8] |= (1 << (reg % 8));
+        g_pwm_buffer_update_required[index] = true;
+    }
+}
+
+static inline bool IS31FL_pwm_register_dirty(uint8_t index, uint8_t reg) {
+    return g_pwm_buffer_dirty[index][reg / 8] & (1 << (reg % 8));
+}
+
+static bool IS31FL_write_dirty_pwm_registers(uint8_t addr, uint8_t index) {
+    bool success = true;
+    int  reg     = 0;
+    while (reg < ISSI_MAX_LEDS) {
+        if (!IS31FL_pwm_register_dirty(index, reg)) {
+            reg++;
+            continue;
+        }
+
+        // Extend the run over nearby dirty registers, up to the size of a single transfer
+        int start = reg;
+        int end   = reg + 1;
+        for (int probe = end; probe < ISSI_MAX_LEDS && probe - start < ISSI_PWM_TRF_SIZE && probe - end <= ISSI_PWM_COALESCE_GAP; probe++) {
+            if (IS31FL_pwm_register_dirty(index, probe)) {
+                end = probe + 1;
+            }
+        }
+
+        success &= IS31FL_write_multi_registers(addr, g_pwm_buffer[index] + start, end - start, end - start, ISSI_PWM_REG_1ST + start);
+        reg = end;
+    }
+    return success;
 }
 
 void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+    if (g_pwm_buffer_update_required[index] || !g_pwm_buffer_synced[index]) {
+        if (!g_pwm_buffer_synced[index] && g_pwm_buffer_resync_wait[index]) {
+            // Backing off from a driver that failed the last attempts
+            g_pwm_buffer_resync_wait[index]--;
+            return;
+        }
+
+        bool any_dirty = false;
+        for (int i = 0; i < sizeof(g_pwm_buffer_dirty[index]); i++) {
+            any_dirty |= g_pwm_buffer_dirty[index][i];
+        }
+
         // Queue up the correct page
         IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
+        if (!g_pwm_buffer_synced[index] || !any_dirty) {
+            // Driver state unknown, or g_pwm_buffer was modified directly, so rewrite the whole page
+            g_pwm_buffer_synced[index] = IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
+        } else {
+            // Only send runs of changed registers; on failure fall back to a full page next time
+            g_pwm_buffer_synced[index] = IS31FL_write_dirty_pwm_registers(addr, index);
+        }
+        if (g_pwm_buffer_synced[index]) {
+            g_pwm_buffer_resync_backoff[index] = 0;
+        } else {
+            // Retry straight away once, then wait twice as long after each further failure
+            g_pwm_buffer_resync_wait[index]    = g_pwm_buffer_resync_backoff[index];
+            g_pwm_buffer_resync_backoff[index] = g_pwm_buffer_resync_backoff[index] ? MIN(2 * g_pwm_buffer_resync_backoff[index], ISSI_PWM_RESYNC_BACKOFF) : 1;
+        }
         // Update flags that pwm_buffer has been updated
+        memset(g_pwm_buffer_dirty[index], 0, sizeof(g_pwm_buffer_dirty[index]));
         g_pwm_buffer_update_required[index] = false;
     }
 }
@@ -171,10 +257,9 @@ void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm_register(led.driver, led.r, red);
+        IS31FL_set_pwm_register(led.driver, led.g, green);
+        IS31FL_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -220,8 +305,7 @@ void IS31FL_simple_set_scaling_buffer(uint8_t index, bool value) {
 void IS31FL_simple_set_brightness(int index, uint8_t value) {
     if (index >= 0 && index < LED_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
-        g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm_register(led.driver, led.v, value);
     }
 }
 
@@ -0,0 +1,35 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_mock.hpp"
+
+extern "C" {
+#include "i2c_master.h"
+}
+
+I2CMock& I2CMock::instance() {
+    static I2CMock mock;
+    return mock;
+}
+
+void I2CMock::reset() {
+    transfers.clear();
+    fail = false;
+}
+
+size_t I2CMock::bytes_transmitted() const {
+    size_t bytes = 0;
+    for (auto& transfer : transfers) {
+        // Each transfer also clocks out the device address
+        bytes += 1 + transfer.data.size();
+    }
+    return bytes;
+}
+
+extern "C" i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    I2CMock& mock = I2CMock::instance();
+    mock.transfers.push_back({address, std::vector<uint8_t>(data, data + length)});
+    return mock.fail ? I2C_STATUS_ERROR : I2C_STATUS_SUCCESS;
+}
+
+extern "C" void wait_ms(uint32_t ms) {}
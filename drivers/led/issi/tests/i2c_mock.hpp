@@ -0,0 +1,24 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct I2CTransfer {
+    uint8_t              address;
+    std::vector<uint8_t> data;
+};
+
+class I2CMock {
+   public:
+    static I2CMock& instance();
+
+    void   reset();
+    size_t bytes_transmitted() const;
+
+    std::vector<I2CTransfer> transfers;
+    bool                     fail = false;
+};
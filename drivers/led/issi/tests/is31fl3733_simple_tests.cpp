@@ -0,0 +1,76 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "i2c_mock.hpp"
+
+extern "C" {
+#include "is31fl3733-simple.h"
+
+extern bool g_pwm_buffer_update_required[LED_DRIVER_COUNT];
+}
+
+#define ADDR 0x50
+
+// One LED per PWM register
+const is31_led g_is31_leds[LED_MATRIX_LED_COUNT] = {
+#define LED(i) {0, (i)},
+#define LEDS_16(i) LED(i) LED(i + 1) LED(i + 2) LED(i + 3) LED(i + 4) LED(i + 5) LED(i + 6) LED(i + 7) LED(i + 8) LED(i + 9) LED(i + 10) LED(i + 11) LED(i + 12) LED(i + 13) LED(i + 14) LED(i + 15)
+    LEDS_16(0) LEDS_16(16) LEDS_16(32) LEDS_16(48) LEDS_16(64) LEDS_16(80) LEDS_16(96) LEDS_16(112) LEDS_16(128) LEDS_16(144) LEDS_16(160) LEDS_16(176)
+#undef LEDS_16
+#undef LED
+};
+
+// Unlocking the command register and selecting PG1: two transfers of two bytes
+static const size_t page_select_bytes = 2 * (1 + 2);
+// A full page is sent as 12 transfers of 16 registers, each with a register address
+static const size_t full_page_bytes = page_select_bytes + 12 * (1 + 1 + 16);
+
+class IS31FL3733Simple : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // Start every test from a blank, fully synced driver
+        IS31FL3733_set_value_all(0);
+        g_pwm_buffer_update_required[0] = true;
+        IS31FL3733_update_pwm_buffers(ADDR, 0);
+    }
+
+    size_t flush() {
+        I2CMock::instance().reset();
+        IS31FL3733_update_pwm_buffers(ADDR, 0);
+        return I2CMock::instance().bytes_transmitted();
+    }
+};
+
+TEST_F(IS31FL3733Simple, UnchangedFrameSendsNothing) {
+    IS31FL3733_set_value_all(0);
+    EXPECT_EQ(flush(), 0);
+}
+
+TEST_F(IS31FL3733Simple, ChangedLedsSendOnlyTheirRuns) {
+    IS31FL3733_set_value(40, 0x11);
+    IS31FL3733_set_value(42, 0x22);
+    IS31FL3733_set_value(150, 0x33);
+    EXPECT_EQ(flush(), page_select_bytes + (1 + 1 + 3) + (1 + 1 + 1));
+
+    auto &transfers = I2CMock::instance().transfers;
+    ASSERT_EQ(transfers.size(), 4);
+    EXPECT_EQ(transfers[2].data, std::vector<uint8_t>({40, 0x11, 0x00, 0x22}));
+    EXPECT_EQ(transfers[3].data, std::vector<uint8_t>({150, 0x33}));
+}
+
+TEST_F(IS31FL3733Simple, FirstFlushWritesWholePage) {
+    IS31FL3733_set_value_all(0x80);
+    EXPECT_EQ(flush(), full_page_bytes);
+}
+
+TEST_F(IS31FL3733Simple, ReinitRewritesWholePage) {
+    IS31FL3733_set_value(5, 0x80);
+    flush();
+
+    // Init clears the driver's PWM registers, so even unchanged LEDs must be sent again
+    IS31FL3733_init(ADDR, 0);
+    IS31FL3733_set_value(5, 0x80);
+    EXPECT_EQ(flush(), full_page_bytes);
+    EXPECT_EQ(flush(), 0);
+}
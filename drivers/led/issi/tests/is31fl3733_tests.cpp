@@ -0,0 +1,152 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "i2c_mock.hpp"
+
+extern "C" {
+#include "is31fl3733.h"
+
+extern uint8_t g_pwm_buffer[DRIVER_COUNT][192];
+extern bool    g_pwm_buffer_update_required[DRIVER_COUNT];
+extern bool    g_led_control_registers_update_required[DRIVER_COUNT];
+}
+
+#define ADDR 0x50
+
+// Each LED takes three consecutive PWM registers
+#define LED(i) \
+    { 0, (3 * (i)), (3 * (i) + 1), (3 * (i) + 2) }
+
+// clang-format off
+const is31_led PROGMEM g_is31_leds[RGB_MATRIX_LED_COUNT] = {
+    LED(0),  LED(1),  LED(2),  LED(3),  LED(4),  LED(5),  LED(6),  LED(7),  LED(8),  LED(9),  LED(10),
+    LED(11), LED(12), LED(13), LED(14), LED(15), LED(16), LED(17), LED(18), LED(19), LED(20), LED(21),
+    LED(22), LED(23), LED(24), LED(25), LED(26), LED(27), LED(28), LED(29), LED(30), LED(31), LED(32),
+    LED(33), LED(34), LED(35), LED(36), LED(37), LED(38), LED(39), LED(40), LED(41), LED(42), LED(43),
+    LED(44), LED(45), LED(46), LED(47), LED(48), LED(49), LED(50), LED(51), LED(52), LED(53), LED(54),
+    LED(55), LED(56), LED(57), LED(58), LED(59), LED(60), LED(61), LED(62), LED(63),
+};
+// clang-format on
+
+// Unlocking the command register and selecting PG1: two transfers of two bytes
+static const size_t page_select_bytes = 2 * (1 + 2);
+// A full page is sent as 12 transfers of 16 registers, each with a register address
+static const size_t full_page_bytes = page_select_bytes + 12 * (1 + 1 + 16);
+
+class IS31FL3733 : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // Start every test from a blank, fully synced driver
+        IS31FL3733_set_color_all(0, 0, 0);
+        g_pwm_buffer_update_required[0] = true;
+        I2CMock::instance().reset();
+        IS31FL3733_update_pwm_buffers(ADDR, 0);
+        I2CMock::instance().reset();
+        g_led_control_registers_update_required[0] = false;
+    }
+
+    size_t flush() {
+        I2CMock::instance().reset();
+        IS31FL3733_update_pwm_buffers(ADDR, 0);
+        return I2CMock::instance().bytes_transmitted();
+    }
+
+    /* Every PWM register write which reached the bus, as (register, value) */
+    std::vector<std::pair<uint8_t, uint8_t>> pwm_writes() {
+        std::vector<std::pair<uint8_t, uint8_t>> writes;
+        for (auto& transfer : I2CMock::instance().transfers) {
+            uint8_t reg = transfer.data[0];
+            if (reg == 0xFD || reg == 0xFE) {
+                // Command register and its write lock
+                continue;
+            }
+            for (size_t i = 1; i < transfer.data.size(); i++) {
+                writes.push_back({reg + i - 1, transfer.data[i]});
+            }
+        }
+        return writes;
+    }
+};
+
+TEST_F(IS31FL3733, UnchangedFrameSendsNothing) {
+    IS31FL3733_set_color_all(0, 0, 0);
+    EXPECT_EQ(flush(), 0);
+}
+
+TEST_F(IS31FL3733, SingleLedSendsOneRun) {
+    IS31FL3733_set_color(10, 0x11, 0x22, 0x33);
+    EXPECT_EQ(flush(), page_select_bytes + 1 + 1 + 3);
+
+    std::vector<std::pair<uint8_t, uint8_t>> expected = {{30, 0x11}, {31, 0x22}, {32, 0x33}};
+    EXPECT_EQ(pwm_writes(), expected);
+}
+
+TEST_F(IS31FL3733, NearbyChangesAreCoalesced) {
+    // Red of LED 3 and red of LED 4 leave two unchanged registers between them
+    IS31FL3733_set_color(3, 0xFF, 0, 0);
+    IS31FL3733_set_color(4, 0xFF, 0, 0);
+    EXPECT_EQ(flush(), page_select_bytes + 1 + 1 + 4);
+    EXPECT_EQ(I2CMock::instance().transfers.size(), 3);
+
+    // Red of LED 3 and green of LED 4 leave three, which is cheaper as two transfers
+    IS31FL3733_set_color(3, 0x80, 0, 0);
+    IS31FL3733_set_color(4, 0xFF, 0x80, 0);
+    EXPECT_EQ(flush(), page_select_bytes + 2 * (1 + 1 + 1));
+}
+
+TEST_F(IS31FL3733, RunsAreSplitAtTransferSize) {
+    IS31FL3733_set_color_all(0x80, 0x80, 0x80);
+    EXPECT_EQ(flush(), full_page_bytes);
+
+    // Every register made it to the driver exactly once
+    auto writes = pwm_writes();
+    ASSERT_EQ(writes.size(), 192);
+    for (size_t i = 0; i < writes.size(); i++) {
+        EXPECT_EQ(writes[i].first, i);
+        EXPECT_EQ(writes[i].second, 0x80);
+    }
+}
+
+TEST_F(IS31FL3733, FailedFlushRewritesWholePage) {
+    IS31FL3733_set_color(5, 1, 1, 1);
+    I2CMock::instance().fail = true;
+    IS31FL3733_update_pwm_buffers(ADDR, 0);
+    I2CMock::instance().fail = false;
+    EXPECT_TRUE(g_led_control_registers_update_required[0]);
+
+    IS31FL3733_set_color(6, 1, 1, 1);
+    EXPECT_EQ(flush(), full_page_bytes);
+}
+
+TEST_F(IS31FL3733, ReinitRewritesWholePage) {
+    IS31FL3733_set_color(5, 1, 1, 1);
+    flush();
+
+    // Init clears the driver's PWM registers, so even unchanged LEDs must be sent again
+    IS31FL3733_init(ADDR, 0);
+    IS31FL3733_set_color(5, 1, 1, 1);
+    EXPECT_EQ(flush(), full_page_bytes);
+    EXPECT_EQ(flush(), 0);
+}
+
+TEST_F(IS31FL3733, DirectBufferWritesRewriteWholePage) {
+    g_pwm_buffer[0][17]             = 0x42;
+    g_pwm_buffer_update_required[0] = true;
+    EXPECT_EQ(flush(), full_page_bytes);
+}
+
+TEST_F(IS31FL3733, ReactiveFrameBytes) {
+    // A reactive effect: a single key lights up and fades while everything else stays put
+    IS31FL3733_set_color_all(0x10, 0x10, 0x10);
+    IS31FL3733_set_color(20, 0xFF, 0xFF, 0xFF);
+    EXPECT_LE(flush(), full_page_bytes);
+
+    // After the first frame has set the background, each frame only sends the one LED
+    for (int frame = 1; frame < 16; frame++) {
+        uint8_t value = 0xFF - frame * 16;
+        IS31FL3733_set_color_all(0x10, 0x10, 0x10);
+        IS31FL3733_set_color(20, value, value, value);
+        EXPECT_EQ(flush(), page_select_bytes + 1 + 1 + 3) << "frame " << frame;
+    }
+}
@@ -0,0 +1,39 @@
+is31flcommon_DEFS := \
+	-DIS31FLCOMMON \
+	-DIS31FL3743A \
+	-DRGB_MATRIX_ENABLE \
+	-DRGB_MATRIX_LED_COUNT=66 \
+	-DDRIVER_COUNT=1 \
+	-D__flash=
+is31flcommon_INC := \
+	$(DRIVER_PATH)/led/issi/tests \
+	$(DRIVER_PATH)/led/issi
+is31flcommon_SRC := \
+	$(DRIVER_PATH)/led/issi/tests/i2c_mock.cpp \
+	$(DRIVER_PATH)/led/issi/tests/is31flcommon_tests.cpp \
+	$(DRIVER_PATH)/led/issi/is31flcommon.c
+
+is31fl3733_DEFS := \
+	-DRGB_MATRIX_ENABLE \
+	-DRGB_MATRIX_LED_COUNT=64 \
+	-DDRIVER_COUNT=1
+is31fl3733_INC := \
+	$(DRIVER_PATH)/led/issi/tests \
+	$(DRIVER_PATH)/led/issi
+is31fl3733_SRC := \
+	$(DRIVER_PATH)/led/issi/tests/i2c_mock.cpp \
+	$(DRIVER_PATH)/led/issi/tests/is31fl3733_tests.cpp \
+	$(DRIVER_PATH)/led/issi/is31fl3733.c
+
+is31fl3733_simple_DEFS := \
+	-DLED_MATRIX_ENABLE \
+	-DLED_MATRIX_LED_COUNT=192 \
+	-DLED_DRIVER_COUNT=1 \
+	-D__flash=
+is31fl3733_simple_INC := \
+	$(DRIVER_PATH)/led/issi/tests \
+	$(DRIVER_PATH)/led/issi
+is31fl3733_simple_SRC := \
+	$(DRIVER_PATH)/led/issi/tests/i2c_mock.cpp \
+	$(DRIVER_PATH)/led/issi/tests/is31fl3733_simple_tests.cpp \
+	$(DRIVER_PATH)/led/issi/is31fl3733-simple.c
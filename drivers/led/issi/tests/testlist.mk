@@ -0,0 +1,4 @@
+TEST_LIST += \
+	is31flcommon \
+	is31fl3733 \
+	is31fl3733_simple
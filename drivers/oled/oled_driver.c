@@ -384,23 +384,53 @@ void oled_clear(void) {
     oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
+uint8_t crot(uint8_t a, int8_t n) {
+    const uint8_t mask = 0x7;
+    n &= mask;
+    return a << n | a >> (-n & mask);
+}
+
+static void rotate_90(const uint8_t *src, uint8_t *dest) {
+    for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
+        uint8_t selector = (1 << i);
+        for (uint8_t j = 0; j < 8; ++j) {
+            dest[i] |= crot(src[j] & selector, shift - (int8_t)j);
+        }
+    }
+}
+
+// Width of a block once rotated by 90 degrees
+#define OLED_BLOCK_90_COLUMNS ((OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8)
+
+// Rotates a block into the layout the display expects: a row of OLED_BLOCK_90_COLUMNS bytes for each page it covers
+static void rotate_block_90(uint8_t update_start, uint8_t *dest) {
+    const static uint8_t source_map[] = OLED_SOURCE_MAP;
+    const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+    memset(dest, 0, OLED_BLOCK_SIZE);
+    for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+        rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &dest[target_map[i]]);
+    }
+}
+
+#if OLED_RENDER_BUDGET == 0
 static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
     // Calculate commands to set memory addressing bounds.
     uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
     uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
-#if !OLED_IC_HAS_HORIZONTAL_MODE
+#    if !OLED_IC_HAS_HORIZONTAL_MODE
     // Commands for Page Addressing Mode. Sets starting page and column; has no end bound.
     // Column value must be split into high and low nybble and sent as two commands.
     cmd_array[0] = PAM_PAGE_ADDR | start_page;
     cmd_array[1] = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
     cmd_array[2] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
-#else
+#    else
     // Commands for use in Horizontal Addressing mode.
     cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
     cmd_array[4] = start_page;
     cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
     cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
-#endif
+#    endif
 }
 
 static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
@@ -418,120 +448,222 @@ static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
     // Top page number for a block which is at the bottom edge of the screen.
     const uint8_t bottom_block_top_page = (height_in_pages - page_inc_per_block) % height_in_pages;
 
-#if !OLED_IC_HAS_HORIZONTAL_MODE
+#    if !OLED_IC_HAS_HORIZONTAL_MODE
     // Only the Page Addressing Mode is supported
     uint8_t start_page   = bottom_block_top_page - (OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT / 8);
     uint8_t start_column = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_HEIGHT * 8;
     cmd_array[0]         = PAM_PAGE_ADDR | start_page;
     cmd_array[1]         = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
     cmd_array[2]         = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
-#else
+#    else
     cmd_array[1] = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_HEIGHT * 8 + OLED_COLUMN_OFFSET;
     cmd_array[4] = bottom_block_top_page - (OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT / 8);
     cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8 - 1 + cmd_array[1];
     cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) % OLED_DISPLAY_HEIGHT / 8 + cmd_array[4];
-#endif
+#    endif
 }
 
-uint8_t crot(uint8_t a, int8_t n) {
-    const uint8_t mask = 0x7;
-    n &= mask;
-    return a << n | a >> (-n & mask);
-}
+// Sends a single whole block
+static bool oled_render_block(uint8_t update_start) {
+    // Set column & page position
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+    static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
+#    else
+    static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
+#    endif
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+    } else {
+        calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+    }
 
-static void rotate_90(const uint8_t *src, uint8_t *dest) {
-    for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
-        uint8_t selector = (1 << i);
-        for (uint8_t j = 0; j < 8; ++j) {
-            dest[i] |= crot(src[j] & selector, shift - (int8_t)j);
+    // Send column & page position
+    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        print("oled_render offset command failed\n");
+        return false;
+    }
+
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        // Send render data chunk as is
+        if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            print("oled_render data failed\n");
+            return false;
         }
+    } else {
+        // Rotate the render chunks
+        static uint8_t temp_buffer[OLED_BLOCK_SIZE];
+        rotate_block_90(update_start, temp_buffer);
+
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+        // Send render data chunk after rotating
+        if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            print("oled_render90 data failed\n");
+            return false;
+        }
+#    else
+        // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
+        for (uint8_t i = 0; i < OLED_BLOCK_SIZE / OLED_BLOCK_90_COLUMNS; ++i) {
+            // Send column & page position for all pages except the first one
+            if (i > 0) {
+                display_start[1]++;
+                if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                    print("oled_render offset command failed\n");
+                    return false;
+                }
+            }
+            // Send data for the page
+            if (!oled_send_data(&temp_buffer[OLED_BLOCK_90_COLUMNS * i], OLED_BLOCK_90_COLUMNS)) {
+                print("oled_render90 data failed\n");
+                return false;
+            }
+        }
+#    endif
     }
+
+    return true;
+}
+#endif // OLED_RENDER_BUDGET == 0
+
+#if OLED_RENDER_BUDGET > 0
+// Bytes sent along with every transfer -- the device address and control byte over I2C
+#    if defined(OLED_TRANSPORT_SPI)
+#        define OLED_TRANSFER_OVERHEAD 0
+#    else
+#        define OLED_TRANSFER_OVERHEAD 2
+#    endif
+
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+#        define OLED_ADDRESS_COMMAND_COST (OLED_TRANSFER_OVERHEAD + 6)
+#    else
+#        define OLED_ADDRESS_COMMAND_COST (OLED_TRANSFER_OVERHEAD + 3)
+#    endif
+
+#    define OLED_RENDER_BUDGET_BYTES ((uint32_t)OLED_RENDER_BUDGET * 1000 / OLED_BUS_BYTE_TIME_NS)
+
+_Static_assert(OLED_RENDER_BUDGET_BYTES > OLED_ADDRESS_COMMAND_COST + OLED_TRANSFER_OVERHEAD, "OLED_RENDER_BUDGET is too small to send anything to the display");
+
+// Block currently being streamed, and how much of it remains to be sent
+static uint8_t  oled_render_current   = 0;
+static uint16_t oled_render_remaining = 0;
+
+// The current block after rotating, when rotated by 90 degrees
+static uint8_t oled_render_rotated[OLED_BLOCK_SIZE];
+
+// Sends part of a single page of the display
+static bool oled_render_partial(uint8_t page, uint8_t column, const uint8_t *data, uint16_t length) {
+    column += OLED_COLUMN_OFFSET;
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+    uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, column, column + length - 1, PAGE_ADDR, page, page};
+#    else
+    uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR | page, PAM_SETCOLUMN_LSB | (column & 0x0f), PAM_SETCOLUMN_MSB | (column >> 4 & 0x0f)};
+#    endif
+    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        print("oled_render offset command failed\n");
+        return false;
+    }
+    if (!oled_send_data(data, length)) {
+        print("oled_render data failed\n");
+        return false;
+    }
+    return true;
+}
+#endif // OLED_RENDER_BUDGET > 0
+
+// True if there's anything left to send to the display
+static inline bool oled_render_pending(void) {
+#if OLED_RENDER_BUDGET > 0
+    return oled_dirty || oled_render_remaining;
+#else
+    return oled_dirty;
+#endif
 }
 
 void oled_render(void) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
-    if (!oled_dirty || !oled_initialized || oled_scrolling) {
+    if (!oled_render_pending() || !oled_initialized || oled_scrolling) {
         return;
     }
 
     // Turn on display if it is off
     oled_on();
 
-    uint8_t update_start  = 0;
-    uint8_t num_processed = 0;
-    while (oled_dirty && num_processed++ < OLED_UPDATE_PROCESS_LIMIT) { // render all dirty blocks (up to the configured limit)
-        // Find next dirty block
-        while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
-            ++update_start;
+#if OLED_RENDER_BUDGET > 0
+    // Send as much as fits in the budget, resuming part-way through a block where the last render left off
+    uint32_t budget = OLED_RENDER_BUDGET_BYTES;
+    while (true) {
+        if (oled_render_remaining && (oled_dirty & ((OLED_BLOCK_TYPE)1 << oled_render_current))) {
+            // Written to again while being sent, so start it over
+            oled_render_remaining = 0;
         }
-
-        // Set column & page position
-#if OLED_IC_HAS_HORIZONTAL_MODE
-        static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
-#else
-        static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
-#endif
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        } else {
-            calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+        if (!oled_render_remaining) {
+            if (!oled_dirty) {
+                return;
+            }
+            oled_render_current = 0;
+            while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << oled_render_current))) {
+                ++oled_render_current;
+            }
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << oled_render_current);
+            oled_render_remaining = OLED_BLOCK_SIZE;
         }
 
-        // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-            print("oled_render offset command failed\n");
+        // Send up to the end of the block or page, whichever comes first, or as much as the budget allows
+        if (budget <= OLED_ADDRESS_COMMAND_COST + OLED_TRANSFER_OVERHEAD) {
             return;
         }
-
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
-                print("oled_render data failed\n");
-                return;
+        uint16_t       offset = OLED_BLOCK_SIZE - oled_render_remaining;
+        uint16_t       length = oled_render_remaining;
+        uint8_t        page, column;
+        const uint8_t *data;
+        if (HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+            if (offset == 0) {
+                rotate_block_90(oled_render_current, oled_render_rotated);
             }
-        } else {
-            // Rotate the render chunks
-            const static uint8_t source_map[] = OLED_SOURCE_MAP;
-            const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-            static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-            memset(temp_buffer, 0, sizeof(temp_buffer));
-            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+            // Each row of the rotated block goes to the next page down, laid out as calc_bounds_90() does for whole blocks
+            const uint8_t height_in_pages       = OLED_DISPLAY_HEIGHT / 8;
+            const uint8_t bottom_block_top_page = (height_in_pages - OLED_BLOCK_SIZE % OLED_DISPLAY_HEIGHT / 8) % height_in_pages;
+            page   = bottom_block_top_page - (OLED_BLOCK_SIZE * oled_render_current % OLED_DISPLAY_HEIGHT / 8) + offset / OLED_BLOCK_90_COLUMNS;
+            column = OLED_BLOCK_SIZE * oled_render_current / OLED_DISPLAY_HEIGHT * 8 + offset % OLED_BLOCK_90_COLUMNS;
+            data   = &oled_render_rotated[offset];
+            if (length > OLED_BLOCK_90_COLUMNS - offset % OLED_BLOCK_90_COLUMNS) {
+                length = OLED_BLOCK_90_COLUMNS - offset % OLED_BLOCK_90_COLUMNS;
             }
-
-#if OLED_IC_HAS_HORIZONTAL_MODE
-            // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
-                print("oled_render90 data failed\n");
-                return;
+        } else {
+            uint16_t index = OLED_BLOCK_SIZE * oled_render_current + offset;
+            page           = index / OLED_DISPLAY_WIDTH;
+            column         = index % OLED_DISPLAY_WIDTH;
+            data           = &oled_buffer[index];
+            if (length > OLED_DISPLAY_WIDTH - column) {
+                length = OLED_DISPLAY_WIDTH - column;
             }
+        }
+        if (length > budget - OLED_ADDRESS_COMMAND_COST - OLED_TRANSFER_OVERHEAD) {
+            length = budget - OLED_ADDRESS_COMMAND_COST - OLED_TRANSFER_OVERHEAD;
+        }
+        budget -= OLED_ADDRESS_COMMAND_COST + OLED_TRANSFER_OVERHEAD + length;
+        if (!oled_render_partial(page, column, data, length)) {
+            return;
+        }
+        oled_render_remaining -= length;
+    }
 #else
-            // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
-            const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
-            const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
-            for (uint8_t i = 0; i < num_pages; ++i) {
-                // Send column & page position for all pages except the first one
-                if (i > 0) {
-                    display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-                        print("oled_render offset command failed\n");
-                        return;
-                    }
-                }
-                // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
-                    print("oled_render90 data failed\n");
-                    return;
-                }
-            }
-#endif
+    uint8_t update_start  = 0;
+    uint8_t num_processed = 0;
+    while (oled_dirty && num_processed++ < OLED_UPDATE_PROCESS_LIMIT) { // render all dirty blocks (up to the configured limit)
+        // Find next dirty block
+        while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
+            ++update_start;
+        }
+
+        if (!oled_render_block(update_start)) {
+            return;
         }
 
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
     }
+#endif
 }
 
 void oled_set_cursor(uint8_t col, uint8_t line) {
@@ -838,7 +970,7 @@ bool oled_scroll_right(void) {
 
     // Dont enable scrolling if we need to update the display
     // This prevents scrolling of bad data from starting the scroll too early after init
-    if (!oled_dirty && !oled_scrolling) {
+    if (!oled_render_pending() && !oled_scrolling) {
         uint8_t display_scroll_right[] = {I2C_CMD, SCROLL_RIGHT, 0x00, oled_scroll_start, oled_scroll_speed, oled_scroll_end, 0x00, 0xFF, ACTIVATE_SCROLL};
         if (!oled_send_cmd(display_scroll_right, ARRAY_SIZE(display_scroll_right))) {
             print("oled_scroll_right cmd failed\n");
@@ -856,7 +988,7 @@ bool oled_scroll_left(void) {
 
     // Dont enable scrolling if we need to update the display
     // This prevents scrolling of bad data from starting the scroll too early after init
-    if (!oled_dirty && !oled_scrolling) {
+    if (!oled_render_pending() && !oled_scrolling) {
         uint8_t display_scroll_left[] = {I2C_CMD, SCROLL_LEFT, 0x00, oled_scroll_start, oled_scroll_speed, oled_scroll_end, 0x00, 0xFF, ACTIVATE_SCROLL};
         if (!oled_send_cmd(display_scroll_left, ARRAY_SIZE(display_scroll_left))) {
             print("oled_scroll_left cmd failed\n");
@@ -943,7 +1075,7 @@ void oled_task(void) {
 #endif
 
 #if OLED_SCROLL_TIMEOUT > 0
-    if (oled_dirty && oled_scrolling) {
+    if (oled_render_pending() && oled_scrolling) {
         oled_scroll_timeout = timer_read32() + OLED_SCROLL_TIMEOUT;
         oled_scroll_off();
     }
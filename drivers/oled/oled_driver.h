@@ -321,6 +321,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_UPDATE_PROCESS_LIMIT 1
 #endif
 
+// Microseconds of bus time each render may take, streaming partial blocks across calls. 0 renders whole blocks instead, up to OLED_UPDATE_PROCESS_LIMIT.
+#if !defined(OLED_RENDER_BUDGET)
+#    define OLED_RENDER_BUDGET 0
+#endif
+
+// Time taken to send a single byte to the display, used to work out how much fits in OLED_RENDER_BUDGET
+#if !defined(OLED_BUS_BYTE_TIME_NS)
+#    if defined(OLED_TRANSPORT_SPI)
+#        define OLED_BUS_BYTE_TIME_NS 1000
+#    else
+// 9 clocks per byte at 400kHz
+#        define OLED_BUS_BYTE_TIME_NS 22500
+#    endif
+#endif
+
 typedef struct __attribute__((__packed__)) {
     uint8_t *current_element;
     uint16_t remaining_element_count;
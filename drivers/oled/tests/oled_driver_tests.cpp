@@ -0,0 +1,193 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "gtest/gtest.h"
+#include "oled_mock.hpp"
+
+extern "C" {
+#include "oled_driver.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+// Time the rest of each main loop iteration takes, as for a matrix scan and key processing
+constexpr uint64_t scan_time_ns = 250000;
+
+// What oled_task_user() draws
+char status[4][22];
+
+void set_status(uint32_t wpm) {
+    snprintf(status[0], sizeof(status[0]), "Layer: BASE");
+    snprintf(status[1], sizeof(status[1]), "WPM: %3u", (unsigned)wpm);
+    snprintf(status[2], sizeof(status[2]), "%s", wpm % 2 ? "CAPS" : "    ");
+    snprintf(status[3], sizeof(status[3]), "Keys: %6u", (unsigned)(wpm * 37));
+}
+
+bool rotated = false;
+
+bool display_matches_buffer() {
+    oled_buffer_reader_t reader = oled_read_raw(0);
+    auto&                mock   = OledMock::instance();
+    if (reader.remaining_element_count != mock.gddram.size()) {
+        return false;
+    }
+    if (!rotated) {
+        return memcmp(reader.current_element, mock.gddram.data(), mock.gddram.size()) == 0;
+    }
+
+    // Rotated by 90 degrees, the buffer's rows run up the display from its bottom left corner
+    for (uint16_t y = 0; y < OLED_DISPLAY_WIDTH; ++y) {
+        for (uint16_t x = 0; x < OLED_DISPLAY_HEIGHT; ++x) {
+            bool    pixel = reader.current_element[y / 8 * OLED_DISPLAY_HEIGHT + x] & (1 << (y % 8));
+            uint8_t row   = OLED_DISPLAY_HEIGHT - 1 - x;
+            if (pixel != (bool)(mock.gddram[row / 8 * OLED_DISPLAY_WIDTH + y] & (1 << (row % 8)))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+extern "C" bool oled_task_user(void) {
+    for (uint8_t line = 0; line < 4; ++line) {
+        oled_set_cursor(0, line * 2);
+        oled_write(status[line], false);
+    }
+    return false;
+}
+
+class OledDriver : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        OledMock::instance().reset(OLED_DISPLAY_WIDTH, OLED_DISPLAY_HEIGHT);
+        OledMock::instance().byte_time_ns = OLED_BUS_BYTE_TIME_NS;
+        set_status(0);
+        rotated = false;
+        ASSERT_TRUE(oled_init(OLED_ROTATION_0));
+    }
+
+    void rotate() {
+        OledMock::instance().reset(OLED_DISPLAY_WIDTH, OLED_DISPLAY_HEIGHT);
+        rotated = true;
+        ASSERT_TRUE(oled_init(OLED_ROTATION_90));
+    }
+
+    // Runs oled_task() as the main loop would, returning the bus time it took
+    uint64_t task() {
+        auto&    mock   = OledMock::instance();
+        uint64_t before = mock.bus_time_ns;
+        oled_task();
+        advance_time(1);
+        return mock.bus_time_ns - before;
+    }
+
+    // Runs oled_task() until nothing more is sent, returning the number of calls
+    uint32_t run_until_idle() {
+        uint32_t calls = 0;
+        while (task() > 0 && calls < 10000) {
+            ++calls;
+        }
+        return calls;
+    }
+};
+
+TEST_F(OledDriver, DisplayMatchesBuffer) {
+    run_until_idle();
+    EXPECT_TRUE(display_matches_buffer());
+
+    set_status(123);
+    run_until_idle();
+    EXPECT_TRUE(display_matches_buffer());
+}
+
+#if OLED_RENDER_BUDGET > 0
+TEST_F(OledDriver, BusTimeStaysWithinBudget) {
+    run_until_idle();
+    for (uint32_t i = 0; i < 500; ++i) {
+        if (i % 10 == 0) {
+            set_status(i);
+        }
+        uint64_t bus_time = task();
+        ASSERT_LE(bus_time, (uint64_t)OLED_RENDER_BUDGET * 1000) << "Render " << i << " took too long";
+    }
+    run_until_idle();
+    EXPECT_TRUE(display_matches_buffer());
+}
+
+TEST_F(OledDriver, RotatedBusTimeStaysWithinBudget) {
+    rotate();
+    run_until_idle();
+    EXPECT_TRUE(display_matches_buffer());
+
+    for (uint32_t i = 0; i < 500; ++i) {
+        if (i % 10 == 0) {
+            set_status(i);
+        }
+        uint64_t bus_time = task();
+        ASSERT_LE(bus_time, (uint64_t)OLED_RENDER_BUDGET * 1000) << "Render " << i << " took too long";
+    }
+    run_until_idle();
+    EXPECT_TRUE(display_matches_buffer());
+}
+
+TEST_F(OledDriver, RewriteWhileStreamingIsResent) {
+    run_until_idle();
+
+    // Part-way through sending the WPM line, change it again
+    set_status(100);
+    task();
+    set_status(200);
+    run_until_idle();
+    EXPECT_TRUE(display_matches_buffer());
+}
+#endif // OLED_RENDER_BUDGET > 0
+
+TEST_F(OledDriver, RotatedDisplayMatchesBuffer) {
+    rotate();
+    run_until_idle();
+    EXPECT_TRUE(display_matches_buffer());
+
+    set_status(123);
+    run_until_idle();
+    EXPECT_TRUE(display_matches_buffer());
+}
+
+TEST_F(OledDriver, ScanJitter) {
+    run_until_idle();
+
+    uint64_t min_loop = UINT64_MAX, max_loop = 0;
+    uint32_t max_latency = 0, latency = 0;
+    bool     pending = false;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        // Status changes every 50 loops
+        if (i % 50 == 0) {
+            set_status(i / 50);
+            pending = true;
+            latency = 0;
+        }
+        uint64_t loop = scan_time_ns + task();
+        min_loop      = std::min(min_loop, loop);
+        max_loop      = std::max(max_loop, loop);
+
+        // Loops taken for each change to reach the display
+        ++latency;
+        if (pending && display_matches_buffer()) {
+            pending     = false;
+            max_latency = std::max(max_latency, latency);
+        }
+    }
+
+    EXPECT_FALSE(pending) << "Final status never reached the display";
+    EXPECT_LT(max_latency, 50u) << "Status changes should reach the display before the next one";
+#if OLED_RENDER_BUDGET > 0
+    EXPECT_LE(max_loop - min_loop, (uint64_t)OLED_RENDER_BUDGET * 1000);
+#endif
+}
@@ -0,0 +1,129 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "oled_mock.hpp"
+
+#include <algorithm>
+
+extern "C" {
+#include "i2c_master.h"
+}
+
+namespace {
+
+// SSD1306 commands which take parameters, and how many
+uint8_t parameter_count(uint8_t command) {
+    switch (command) {
+        case 0x26: // SCROLL_RIGHT
+        case 0x27: // SCROLL_LEFT
+            return 6;
+        case 0x29: // SCROLL_RIGHT_UP
+        case 0x2A: // SCROLL_LEFT_UP
+            return 5;
+        case 0x21: // COLUMN_ADDR
+        case 0x22: // PAGE_ADDR
+        case 0xA3: // SCROLL_AREA
+            return 2;
+        case 0x20: // MEMORY_MODE
+        case 0x81: // CONTRAST
+        case 0x8D: // CHARGE_PUMP
+        case 0xA8: // MULTIPLEX_RATIO
+        case 0xD3: // DISPLAY_OFFSET
+        case 0xD5: // DISPLAY_CLOCK
+        case 0xD9: // PRE_CHARGE_PERIOD
+        case 0xDA: // COM_PINS
+        case 0xDB: // VCOM_DETECT
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+OledMock& OledMock::instance() {
+    static OledMock mock;
+    return mock;
+}
+
+void OledMock::reset(uint8_t width, uint8_t height) {
+    this->width  = width;
+    this->height = height;
+    gddram.assign(width * height / 8, 0);
+    bus_time_ns      = 0;
+    transfers        = 0;
+    params_needed_   = 0;
+    params_received_ = 0;
+    col_start_ = col_ = 0;
+    col_end_          = width - 1;
+    page_start_ = page_ = 0;
+    page_end_           = height / 8 - 1;
+}
+
+void OledMock::command(uint8_t byte) {
+    if (params_needed_ > params_received_) {
+        params_[params_received_++] = byte;
+        if (params_received_ < params_needed_) {
+            return;
+        }
+        if (command_ == 0x21) {
+            col_start_ = col_ = params_[0];
+            col_end_          = params_[1];
+        } else if (command_ == 0x22) {
+            page_start_ = page_ = params_[0];
+            page_end_           = params_[1];
+        }
+        params_needed_ = 0;
+        return;
+    }
+
+    command_         = byte;
+    params_needed_   = parameter_count(byte);
+    params_received_ = 0;
+}
+
+void OledMock::data(uint8_t byte) {
+    if (col_ < width && page_ < height / 8) {
+        gddram[page_ * width + col_] = byte;
+    }
+    if (col_++ >= col_end_) {
+        col_ = col_start_;
+        if (page_++ >= page_end_) {
+            page_ = page_start_;
+        }
+    }
+}
+
+void OledMock::transmit(const uint8_t* bytes, uint16_t length) {
+    // The device address goes out first
+    bus_time_ns += (uint64_t)(1 + length) * byte_time_ns;
+    ++transfers;
+
+    // The first byte selects between a stream of commands or of data
+    for (uint16_t i = 1; i < length; ++i) {
+        if (bytes[0] & 0x40) {
+            data(bytes[i]);
+        } else {
+            command(bytes[i]);
+        }
+    }
+}
+
+extern "C" {
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    OledMock::instance().transmit(data, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    std::vector<uint8_t> transfer(1 + length);
+    transfer[0] = regaddr;
+    std::copy(data, data + length, transfer.begin() + 1);
+    OledMock::instance().transmit(transfer.data(), transfer.size());
+    return I2C_STATUS_SUCCESS;
+}
+
+} // extern "C"
@@ -0,0 +1,41 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/* An SSD1306 in horizontal addressing mode on an I2C bus, keeping count of the time the bus spends on each transfer. */
+class OledMock {
+   public:
+    static OledMock& instance();
+
+    void reset(uint8_t width, uint8_t height);
+
+    // Time taken to clock out each byte, including its acknowledge
+    uint32_t byte_time_ns = 22500;
+
+    // What the display's memory holds, in the same layout as the driver's buffer
+    uint8_t              width  = 0;
+    uint8_t              height = 0;
+    std::vector<uint8_t> gddram;
+
+    uint64_t bus_time_ns = 0;
+    uint64_t transfers   = 0;
+
+    void transmit(const uint8_t* data, uint16_t length);
+
+   private:
+    void command(uint8_t byte);
+    void data(uint8_t byte);
+
+    uint8_t command_         = 0;
+    uint8_t params_[6]       = {0};
+    uint8_t params_needed_   = 0;
+    uint8_t params_received_ = 0;
+
+    // Addressing window, and the next byte's position within it
+    uint8_t col_start_ = 0, col_end_ = 0, page_start_ = 0, page_end_ = 0;
+    uint8_t col_ = 0, page_ = 0;
+};
@@ -0,0 +1,17 @@
+oled_driver_DEFS := \
+	-DOLED_ENABLE \
+	-DOLED_TRANSPORT_I2C \
+	-DOLED_DISPLAY_128X64 \
+	-DOLED_TIMEOUT=0
+oled_driver_INC := \
+	$(DRIVER_PATH)/oled/tests \
+	$(DRIVER_PATH)/oled
+oled_driver_SRC := \
+	$(DRIVER_PATH)/oled/tests/oled_mock.cpp \
+	$(DRIVER_PATH)/oled/tests/oled_driver_tests.cpp \
+	$(DRIVER_PATH)/oled/oled_driver.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+oled_driver_render_budget_DEFS := $(oled_driver_DEFS) -DOLED_RENDER_BUDGET=500
+oled_driver_render_budget_INC := $(oled_driver_INC)
+oled_driver_render_budget_SRC := $(oled_driver_SRC)
@@ -2,11 +2,20 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #include "color.h"
 #include "qp_rgb565_surface.h"
+#include "qp_comms.h"
 #include "qp_draw.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Common
 
+// Dirty region, inclusive of its edges
+typedef struct rgb565_surface_dirty_rect_t {
+    uint16_t l;
+    uint16_t t;
+    uint16_t r;
+    uint16_t b;
+} rgb565_surface_dirty_rect_t;
+
 // Device definition
 typedef struct rgb565_surface_painter_device_t {
     painter_driver_t base; // must be first, so it can be cast to/from the painter_device_t* type
@@ -24,15 +33,15 @@ typedef struct rgb565_surface_painter_device_t {
     uint16_t pixdata_x;
     uint16_t pixdata_y;
 
-    // Maintain a dirty region so we can stream only what we need
-    bool     is_dirty;
-    uint16_t dirty_l;
-    uint16_t dirty_t;
-    uint16_t dirty_r;
-    uint16_t dirty_b;
+    // Maintain a list of dirty regions so we can stream only what we need
+    uint8_t                     dirty_count;
+    uint8_t                     last_dirty;
+    rgb565_surface_dirty_rect_t dirty[RGB565_SURFACE_DIRTY_RECTS];
 
 } rgb565_surface_painter_device_t;
 
+_Static_assert((RGB565_SURFACE_DIRTY_RECTS) > 0 && (RGB565_SURFACE_DIRTY_RECTS) <= UINT8_MAX, "RGB565_SURFACE_DIRTY_RECTS must be between 1 and 255");
+
 // Driver storage
 rgb565_surface_painter_device_t surface_drivers[RGB565_SURFACE_NUM_DEVICES] = {0};
 
@@ -55,25 +64,94 @@ static inline void increment_pixdata_location(rgb565_surface_painter_device_t *s
     }
 }
 
-static inline void setpixel(rgb565_surface_painter_device_t *surface, uint16_t x, uint16_t y, uint16_t rgb565) {
-    // Skip messing with the dirty info if the original value already matches
-    if (surface->buffer[y * surface->base.panel_width + x] != rgb565) {
-        // Maintain dirty region
-        if (surface->dirty_l > x) {
-            surface->dirty_l = x;
-        }
-        if (surface->dirty_r < x) {
-            surface->dirty_r = x;
-        }
-        if (surface->dirty_t > y) {
-            surface->dirty_t = y;
+static inline uint32_t dirty_area(uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    return (uint32_t)(r - l + 1) * (uint32_t)(b - t + 1);
+}
+
+static inline bool dirty_rect_contains(const rgb565_surface_dirty_rect_t *rect, uint16_t x, uint16_t y) {
+    return x >= rect->l && x <= rect->r && y >= rect->t && y <= rect->b;
+}
+
+// Merges the given dirty rect with any others which are cheaper to transfer together than apart
+static void merge_dirty_rects(rgb565_surface_painter_device_t *surface, uint8_t index) {
+    bool merged;
+    do {
+        merged                            = false;
+        rgb565_surface_dirty_rect_t *rect = &surface->dirty[index];
+        for (uint8_t i = 0; i < surface->dirty_count; ++i) {
+            rgb565_surface_dirty_rect_t *other = &surface->dirty[i];
+            if (i == index) {
+                continue;
+            }
+
+            uint16_t l = QP_MIN(rect->l, other->l);
+            uint16_t t = QP_MIN(rect->t, other->t);
+            uint16_t r = QP_MAX(rect->r, other->r);
+            uint16_t b = QP_MAX(rect->b, other->b);
+            if (dirty_area(l, t, r, b) <= dirty_area(rect->l, rect->t, rect->r, rect->b) + dirty_area(other->l, other->t, other->r, other->b) + (RGB565_SURFACE_VIEWPORT_COST)) {
+                rect->l = l;
+                rect->t = t;
+                rect->r = r;
+                rect->b = b;
+
+                // Drop the other rect by moving the last one into its place
+                surface->dirty[i] = surface->dirty[--surface->dirty_count];
+                if (index == surface->dirty_count) {
+                    index = i;
+                }
+                merged = true;
+                break;
+            }
         }
-        if (surface->dirty_b < y) {
-            surface->dirty_b = y;
+    } while (merged);
+
+    surface->last_dirty = index;
+}
+
+static inline void mark_dirty(rgb565_surface_painter_device_t *surface, uint16_t x, uint16_t y) {
+    // Consecutive writes are usually close together, so check the last rect touched first
+    if (surface->dirty_count > 0 && dirty_rect_contains(&surface->dirty[surface->last_dirty], x, y)) {
+        return;
+    }
+
+    // Find the rect which grows the least to cover the pixel
+    uint8_t  best        = 0;
+    uint32_t best_growth = UINT32_MAX;
+    for (uint8_t i = 0; i < surface->dirty_count; ++i) {
+        rgb565_surface_dirty_rect_t *rect   = &surface->dirty[i];
+        uint32_t                     growth = dirty_area(QP_MIN(rect->l, x), QP_MIN(rect->t, y), QP_MAX(rect->r, x), QP_MAX(rect->b, y)) - dirty_area(rect->l, rect->t, rect->r, rect->b);
+        if (growth < best_growth) {
+            best        = i;
+            best_growth = growth;
         }
+    }
+
+    if (best_growth == 0) {
+        surface->last_dirty = best;
+        return;
+    }
+
+    // Start a new rect if transferring it separately is cheaper than growing an existing one
+    if (surface->dirty_count < (RGB565_SURFACE_DIRTY_RECTS) && best_growth > 1 + (RGB565_SURFACE_VIEWPORT_COST)) {
+        surface->last_dirty                   = surface->dirty_count++;
+        surface->dirty[surface->last_dirty].l = surface->dirty[surface->last_dirty].r = x;
+        surface->dirty[surface->last_dirty].t = surface->dirty[surface->last_dirty].b = y;
+        return;
+    }
 
-        // Always dirty after a setpixel
-        surface->is_dirty = true;
+    rgb565_surface_dirty_rect_t *rect = &surface->dirty[best];
+    rect->l                           = QP_MIN(rect->l, x);
+    rect->t                           = QP_MIN(rect->t, y);
+    rect->r                           = QP_MAX(rect->r, x);
+    rect->b                           = QP_MAX(rect->b, y);
+    merge_dirty_rects(surface, best);
+}
+
+static inline void setpixel(rgb565_surface_painter_device_t *surface, uint16_t x, uint16_t y, uint16_t rgb565) {
+    // Skip messing with the dirty info if the original value already matches
+    if (surface->buffer[y * surface->base.panel_width + x] != rgb565) {
+        // Maintain dirty regions
+        mark_dirty(surface, x, y);
 
         // Update the pixel data in the buffer
         surface->buffer[y * surface->base.panel_width + x] = rgb565;
@@ -115,9 +193,8 @@ static bool qp_rgb565_surface_clear(painter_device_t device) {
 static bool qp_rgb565_surface_flush(painter_device_t device) {
     painter_driver_t *               driver  = (painter_driver_t *)device;
     rgb565_surface_painter_device_t *surface = (rgb565_surface_painter_device_t *)driver;
-    surface->dirty_l = surface->dirty_t = UINT16_MAX;
-    surface->dirty_r = surface->dirty_b = 0;
-    surface->is_dirty                   = false;
+    surface->dirty_count = 0;
+    surface->last_dirty  = 0;
     return true;
 }
 
@@ -231,41 +308,37 @@ painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_hei
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Drawing routine to copy out the dirty region and send it to another device
-
-bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y) {
-    painter_driver_t *               surface_driver = (painter_driver_t *)surface;
-    rgb565_surface_painter_device_t *surface_handle = (rgb565_surface_painter_device_t *)surface_driver;
+// Drawing routine to copy out the dirty regions and send them to another device
 
-    // If we're not dirty... we're done.
-    if (!surface_handle->is_dirty) {
-        return true;
-    }
+static bool qp_rgb565_surface_draw_rect(rgb565_surface_painter_device_t *surface_handle, painter_device_t display, uint16_t x, uint16_t y, const rgb565_surface_dirty_rect_t *rect) {
+    painter_driver_t *display_driver = (painter_driver_t *)display;
 
     // Set the target drawing area
-    bool ok = qp_viewport(display, x + surface_handle->dirty_l, y + surface_handle->dirty_t, x + surface_handle->dirty_r, y + surface_handle->dirty_b);
+    bool ok = display_driver->driver_vtable->viewport(display, x + rect->l, y + rect->t, x + rect->r, y + rect->b);
     if (!ok) {
         return false;
     }
 
     // Housekeeping of the amount of pixels to transfer
-    uint32_t  total_pixel_count = QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE / sizeof(uint16_t);
+    uint32_t  total_pixel_count = QP_INTERNAL_PIXDATA_BUFFER_SIZE / sizeof(uint16_t);
     uint32_t  pixel_counter     = 0;
     uint16_t *target_buffer     = (uint16_t *)qp_internal_global_pixdata_buffer;
 
     // Fill the global pixdata area so that we can start transferring to the panel
-    for (uint16_t y = surface_handle->dirty_t; y <= surface_handle->dirty_b; ++y) {
-        for (uint16_t x = surface_handle->dirty_l; x <= surface_handle->dirty_r; ++x) {
+    for (uint16_t y = rect->t; y <= rect->b; ++y) {
+        for (uint16_t x = rect->l; x <= rect->r; ++x) {
             // Update the target buffer
             target_buffer[pixel_counter++] = surface_handle->buffer[y * surface_handle->base.panel_width + x];
 
             // If we've accumulated enough data, send it
             if (pixel_counter == total_pixel_count) {
-                ok = qp_pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter);
+                ok = display_driver->driver_vtable->pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter);
                 if (!ok) {
                     return false;
                 }
-                // Reset the counter
+                // Carry on in the other half of the buffer while this one's sent, and reset the counter
+                qp_internal_swap_pixdata_buffer();
+                target_buffer = (uint16_t *)qp_internal_global_pixdata_buffer;
                 pixel_counter = 0;
             }
         }
@@ -273,10 +346,43 @@ bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display,
 
     // If there's any leftover data, send it
     if (pixel_counter > 0) {
-        ok = qp_pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter);
+        ok = display_driver->driver_vtable->pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter);
         if (!ok) {
             return false;
         }
+        qp_internal_swap_pixdata_buffer();
+    }
+
+    return true;
+}
+
+bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y) {
+    painter_driver_t *               surface_driver = (painter_driver_t *)surface;
+    rgb565_surface_painter_device_t *surface_handle = (rgb565_surface_painter_device_t *)surface_driver;
+    painter_driver_t *               display_driver = (painter_driver_t *)display;
+
+    // If we're not dirty... we're done.
+    if (surface_handle->dirty_count == 0) {
+        return true;
+    }
+
+    if (!display_driver->validate_ok) {
+        qp_dprintf("qp_rgb565_surface_draw: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    // Send each dirty region separately, keeping the comms open so that transfers can overlap with filling the buffer
+    if (!qp_comms_start(display)) {
+        qp_dprintf("qp_rgb565_surface_draw: fail (could not start comms)\n");
+        return false;
+    }
+    bool ok = true;
+    for (uint8_t i = 0; ok && i < surface_handle->dirty_count; ++i) {
+        ok = qp_rgb565_surface_draw_rect(surface_handle, display, x, y, &surface_handle->dirty[i]);
+    }
+    qp_comms_stop(display);
+    if (!ok) {
+        return false;
     }
 
     // Clear the dirty info for the surface
@@ -13,6 +13,23 @@
 #    define RGB565_SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef RGB565_SURFACE_DIRTY_RECTS
+/**
+ * @def This controls the maximum number of separate dirty regions tracked per surface. Each region is sent to the
+ *      display with its own viewport, so updates to widgets far apart don't re-send everything in between.
+ *      Setting this to 1 tracks a single bounding region.
+ */
+#    define RGB565_SURFACE_DIRTY_RECTS 4
+#endif
+
+#ifndef RGB565_SURFACE_VIEWPORT_COST
+/**
+ * @def The cost of sending a region to the display with its own viewport, in pixels. Dirty regions are merged whenever
+ *      sending the extra pixels between them costs less than this.
+ */
+#    define RGB565_SURFACE_VIEWPORT_COST 32
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -30,7 +47,7 @@ painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_hei
 /**
  * Helper method to draw the dirty contents of the framebuffer to the target device.
  *
- * After successful completion, the dirty area is reset.
+ * Each dirty region is sent separately. After successful completion, the dirty regions are reset.
  *
  * @param surface[in] the surface to copy from
  * @param display[in] the display to copy into
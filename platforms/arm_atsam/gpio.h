@@ -79,3 +79,13 @@ typedef uint8_t pin_t;
 #define readPin(pin) ((PORT->Group[SAMD_PORT(pin)].IN.reg & SAMD_PIN_MASK(pin)) != 0)
 
 #define togglePin(pin) (PORT->Group[SAMD_PORT(pin)].OUTTGL.reg = SAMD_PIN_MASK(pin))
+
+/* Operation of GPIO by port. */
+
+typedef uint8_t  gpio_port_t;
+typedef uint32_t gpio_port_data_t;
+
+#define getPinPort(pin) ((gpio_port_t)SAMD_PORT(pin))
+#define getPinPad(pin) SAMD_PIN(pin)
+
+#define readGpioPort(port) (PORT->Group[(port)].IN.reg)
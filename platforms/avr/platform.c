@@ -15,6 +15,8 @@
  */
 
 #include "platform_deps.h"
+#include <avr/sleep.h>
+#include "timer.h"
 
 static void disable_jtag(void) {
 // To use PF4-7 (PC2-5 on ATmega32A), disable JTAG by writing JTD bit twice within four cycles.
@@ -30,3 +32,20 @@ static void disable_jtag(void) {
 void platform_setup(void) {
     disable_jtag();
 }
+
+void platform_idle_until(uint32_t deadline) {
+    // Timer 0 wakes the MCU every millisecond, as do USB interrupts
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while (true) {
+        cli();
+        if (((int32_t)TIMER_DIFF_32(deadline, timer_read32())) <= 0) {
+            sei();
+            break;
+        }
+        // Interrupts are only re-enabled by the instruction before sleeping, so a wakeup can't be missed
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+}
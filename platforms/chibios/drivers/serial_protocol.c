@@ -12,6 +12,31 @@
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
+/**
+ * @brief Sends a transaction buffer. Framed buffers only send as many bytes as
+ * their first byte announces.
+ */
+static inline bool send_buffer(const uint8_t* buffer, size_t size, bool framed) {
+    if (framed && buffer[0] < size) {
+        size = 1 + buffer[0];
+    }
+    return serial_transport_send(buffer, size);
+}
+
+/**
+ * @brief Receives a transaction buffer. Framed buffers are received in two
+ * steps, the length first and then the bytes that follow.
+ */
+static inline bool receive_buffer(uint8_t* buffer, size_t size, bool framed) {
+    if (!framed) {
+        return serial_transport_receive(buffer, size);
+    }
+    if (unlikely(!serial_transport_receive(buffer, 1) || buffer[0] >= size)) {
+        return false;
+    }
+    return serial_transport_receive(buffer + 1, buffer[0]);
+}
+
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
  * by the master.
@@ -75,19 +100,19 @@ static inline bool react_to_transaction(void) {
 
     /* Receive transaction buffer from the master. If this transaction requires it.*/
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!receive_buffer(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size, transaction->framed))) {
             return false;
         }
     }
 
     /* Allow any slave processing to occur. */
     if (transaction->slave_callback) {
-        transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size, split_trans_target2initiator_buffer(transaction));
+        transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
     }
 
     /* Send transaction buffer to the master. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+        if (unlikely(!send_buffer(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size, transaction->framed))) {
             return false;
         }
     }
@@ -142,7 +167,7 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     /* Send transaction buffer to the slave. If this transaction requires it. */
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!send_buffer(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size, transaction->framed))) {
             serial_dprintf("SPLIT: sending buffer failed\n");
             return false;
         }
@@ -150,7 +175,7 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     /* Receive transaction buffer from the slave. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+        if (unlikely(!receive_buffer(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size, transaction->framed))) {
             serial_dprintf("SPLIT: receiving buffer failed\n");
             return false;
         }
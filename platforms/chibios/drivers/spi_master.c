@@ -277,6 +277,21 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_transmit_wait(void) {
+    // Sleep until the transfer's completion interrupt wakes us, as spiSend() does
+    osalSysLock();
+    if (SPI_DRIVER.state == SPI_ACTIVE) {
+        _spi_wait_s(&SPI_DRIVER);
+    }
+    osalSysUnlock();
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
@@ -0,0 +1,51 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <string.h>
+
+#include "ws2812_spi_encoder.h"
+
+/*
+ * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to the ws2812b protocol, each bit of colour data
+ * becomes 0b1110 or 0b1000 on the wire (with the appropriate timing), most significant bit first. Rather than build each
+ * pattern bit by bit, the two SPI bytes for each nibble of colour data are looked up.
+ */
+#define WS2812_SPI_PAIR(hi, lo) (((hi) ? 0b11100000 : 0b10000000) | ((lo) ? 0b1110 : 0b1000))
+#define WS2812_SPI_NIBBLE(n) \
+    { WS2812_SPI_PAIR((n)&0b1000, (n)&0b0100), WS2812_SPI_PAIR((n)&0b0010, (n)&0b0001) }
+
+static const uint8_t ws2812_spi_nibbles[16][2] = {
+    WS2812_SPI_NIBBLE(0),  WS2812_SPI_NIBBLE(1),  WS2812_SPI_NIBBLE(2),  WS2812_SPI_NIBBLE(3),  //
+    WS2812_SPI_NIBBLE(4),  WS2812_SPI_NIBBLE(5),  WS2812_SPI_NIBBLE(6),  WS2812_SPI_NIBBLE(7),  //
+    WS2812_SPI_NIBBLE(8),  WS2812_SPI_NIBBLE(9),  WS2812_SPI_NIBBLE(10), WS2812_SPI_NIBBLE(11), //
+    WS2812_SPI_NIBBLE(12), WS2812_SPI_NIBBLE(13), WS2812_SPI_NIBBLE(14), WS2812_SPI_NIBBLE(15), //
+};
+
+void ws2812_spi_encode_led(uint8_t *out, const LED_TYPE *color) {
+    // LED_TYPE is laid out in the order the LEDs expect the colours to be sent
+    const uint8_t *data = (const uint8_t *)color;
+    for (uint8_t i = 0; i < sizeof(LED_TYPE); i++) {
+        const uint8_t *hi = ws2812_spi_nibbles[data[i] >> 4];
+        const uint8_t *lo = ws2812_spi_nibbles[data[i] & 0x0F];
+        out[0]            = hi[0];
+        out[1]            = hi[1];
+        out[2]            = lo[0];
+        out[3]            = lo[1];
+        out += WS2812_SPI_BYTES_PER_COLOR;
+    }
+}
+
+uint16_t ws2812_spi_encoder_update(ws2812_spi_encoder_t *encoder, const LED_TYPE *leds, uint16_t count) {
+    uint16_t updated = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        if (i < encoder->encoded && memcmp(&encoder->colors[i], &leds[i], sizeof(LED_TYPE)) == 0) {
+            continue;
+        }
+        encoder->colors[i] = leds[i];
+        ws2812_spi_encode_led(&encoder->buffer[WS2812_SPI_BYTES_PER_LED * i], &leds[i]);
+        updated++;
+    }
+    if (count > encoder->encoded) {
+        encoder->encoded = count;
+    }
+    return updated;
+}
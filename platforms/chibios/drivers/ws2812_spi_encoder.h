@@ -0,0 +1,23 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include "color.h"
+
+// Each bit of colour data is sent as a 4-bit SPI pattern, so each byte of colour data takes 4 bytes of SPI data
+#define WS2812_SPI_BYTES_PER_COLOR 4
+#define WS2812_SPI_BYTES_PER_LED (WS2812_SPI_BYTES_PER_COLOR * sizeof(LED_TYPE))
+
+typedef struct {
+    uint8_t * buffer;  // WS2812_SPI_BYTES_PER_LED bytes for each LED
+    LED_TYPE *colors;  // The colour each LED in buffer was last encoded with
+    uint16_t  encoded; // Number of leading LEDs in buffer which have been encoded
+} ws2812_spi_encoder_t;
+
+/* Encodes a single LED's colour into WS2812_SPI_BYTES_PER_LED bytes of SPI data. */
+void ws2812_spi_encode_led(uint8_t *out, const LED_TYPE *color);
+
+/* Encodes the colours of the first count LEDs into the encoder's buffer, skipping any which are unchanged since they were
+ * last encoded. Returns the number of LEDs actually encoded. */
+uint16_t ws2812_spi_encoder_update(ws2812_spi_encoder_t *encoder, const LED_TYPE *leds, uint16_t count);
@@ -43,3 +43,13 @@ typedef ioline_t pin_t;
 #define readPin(pin) palReadLine(pin)
 
 #define togglePin(pin) palToggleLine(pin)
+
+/* Operation of GPIO by port. */
+
+typedef ioportid_t   gpio_port_t;
+typedef ioportmask_t gpio_port_data_t;
+
+#define getPinPort(pin) PAL_PORT(pin)
+#define getPinPad(pin) PAL_PAD(pin)
+
+#define readGpioPort(port) palReadPort(port)
@@ -15,8 +15,58 @@
  */
 
 #include "platform_deps.h"
+#include "timer.h"
+#include "gpio.h"
+
+// Signalled by pin wakeups, to end platform_idle_until() early
+static binary_semaphore_t idle_wakeup;
 
 void platform_setup(void) {
     halInit();
     chSysInit();
-}
\ No newline at end of file
+    chBSemObjectInit(&idle_wakeup, true);
+}
+
+void platform_idle_until(uint32_t deadline) {
+    // Sleeping the main thread lets the idle thread halt the core until the next interrupt
+    int32_t remaining = (int32_t)TIMER_DIFF_32(deadline, timer_read32());
+    if (remaining > 0) {
+        chBSemWaitTimeout(&idle_wakeup, TIME_MS2I(remaining));
+    }
+}
+
+#if PAL_USE_CALLBACKS == TRUE
+static void (*pin_wakeup_callback)(void);
+static uint32_t pin_wakeup_pads; // Most MCUs share one interrupt between the same pad of every port
+
+static void pin_wakeup_isr(void *arg) {
+    pin_wakeup_callback();
+
+    chSysLockFromISR();
+    chBSemSignalI(&idle_wakeup);
+    chSysUnlockFromISR();
+}
+
+bool platform_pin_wakeup_arm(pin_t pin, void (*callback)(void)) {
+    uint32_t pad = (uint32_t)1 << PAL_PAD(pin);
+    if (pin_wakeup_pads & pad) {
+        return false;
+    }
+#    ifdef pal_lld_ispadeventenabled
+    // Another driver (e.g. PS/2) owns the interrupt for this pad, which arming would take over, and disarming turn off
+    if (palIsLineEventEnabledX(pin)) {
+        return false;
+    }
+#    endif
+    pin_wakeup_pads |= pad;
+    pin_wakeup_callback = callback;
+    palEnableLineEvent(pin, PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallback(pin, pin_wakeup_isr, NULL);
+    return true;
+}
+
+void platform_pin_wakeup_disarm(pin_t pin) {
+    palDisableLineEvent(pin);
+    pin_wakeup_pads &= ~((uint32_t)1 << PAL_PAD(pin));
+}
+#endif
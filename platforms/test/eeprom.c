@@ -16,10 +16,20 @@
 
 #include "eeprom.h"
 
-static uint8_t buffer[TOTAL_EEPROM_BYTE_COUNT];
+static uint8_t  buffer[TOTAL_EEPROM_BYTE_COUNT];
+static uint32_t read_count = 0;
+
+uint32_t eeprom_get_read_count(void) {
+    return read_count;
+}
+
+void eeprom_reset_read_count(void) {
+    read_count = 0;
+}
 
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uintptr_t offset = (uintptr_t)addr;
+    read_count++;
     return buffer[offset];
 }
 
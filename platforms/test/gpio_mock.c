@@ -0,0 +1,129 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <string.h>
+#include "gpio_mock.h"
+
+#define GPIO_MOCK_PINS (GPIO_MOCK_PORTS * GPIO_MOCK_PADS)
+
+static gpio_mock_mode_t modes[GPIO_MOCK_PINS];
+static bool             outputs[GPIO_MOCK_PINS];
+static uint64_t         switches[GPIO_MOCK_PINS]; // Bit n set when a switch to pin n is closed
+
+static uint64_t armed;        // Bit n set when pin n has an interrupt armed
+static uint64_t armed_levels; // Levels of the armed pins when last looked at
+static void (*wakeup_callbacks[GPIO_MOCK_PINS])(void);
+
+uint32_t gpio_mock_pin_reads;
+uint32_t gpio_mock_port_reads;
+bool     gpio_mock_wakeup_supported = true;
+
+static int8_t pin_index(pin_t pin) {
+    if (getPinPort(pin) >= GPIO_MOCK_PORTS) {
+        return -1;
+    }
+    return getPinPort(pin) * GPIO_MOCK_PADS + getPinPad(pin);
+}
+
+static bool level(int8_t index) {
+    if (modes[index] == GPIO_MOCK_OUTPUT) {
+        return outputs[index];
+    }
+    // A closed switch to a driven output wins over the pull resistor
+    for (uint8_t i = 0; i < GPIO_MOCK_PINS; i++) {
+        if ((switches[index] & ((uint64_t)1 << i)) && modes[i] == GPIO_MOCK_OUTPUT) {
+            return outputs[i];
+        }
+    }
+    return modes[index] != GPIO_MOCK_INPUT_LOW;
+}
+
+/* Raises an interrupt for each armed pin whose level has changed. */
+static void check_wakeups(void) {
+    for (uint8_t i = 0; i < GPIO_MOCK_PINS; i++) {
+        uint64_t bit = (uint64_t)1 << i;
+        if ((armed & bit) && ((armed_levels & bit) != 0) != level(i)) {
+            armed_levels ^= bit;
+            wakeup_callbacks[i]();
+        }
+    }
+}
+
+void gpio_mock_set_mode(pin_t pin, gpio_mock_mode_t mode) {
+    int8_t index = pin_index(pin);
+    if (index >= 0) {
+        modes[index] = mode;
+        check_wakeups();
+    }
+}
+
+void gpio_mock_write_pin(pin_t pin, bool level) {
+    int8_t index = pin_index(pin);
+    if (index >= 0) {
+        outputs[index] = level;
+        check_wakeups();
+    }
+}
+
+bool gpio_mock_read_pin(pin_t pin) {
+    gpio_mock_pin_reads++;
+    int8_t index = pin_index(pin);
+    return index >= 0 ? level(index) : true;
+}
+
+gpio_port_data_t gpio_mock_read_port(gpio_port_t port) {
+    gpio_mock_port_reads++;
+    gpio_port_data_t data = 0;
+    if (port >= GPIO_MOCK_PORTS) {
+        return (gpio_port_data_t)~0;
+    }
+    for (uint8_t pad = 0; pad < GPIO_MOCK_PADS; pad++) {
+        if (level(port * GPIO_MOCK_PADS + pad)) {
+            data |= (gpio_port_data_t)1 << pad;
+        }
+    }
+    return data;
+}
+
+bool platform_pin_wakeup_arm(pin_t pin, void (*callback)(void)) {
+    int8_t index = pin_index(pin);
+    if (!gpio_mock_wakeup_supported || index < 0) {
+        return false;
+    }
+    uint64_t bit = (uint64_t)1 << index;
+    armed |= bit;
+    armed_levels = level(index) ? armed_levels | bit : armed_levels & ~bit;
+    wakeup_callbacks[index] = callback;
+    return true;
+}
+
+void platform_pin_wakeup_disarm(pin_t pin) {
+    int8_t index = pin_index(pin);
+    if (index >= 0) {
+        armed &= ~((uint64_t)1 << index);
+    }
+}
+
+void gpio_mock_reset(void) {
+    memset(modes, 0, sizeof(modes));
+    memset(outputs, 0, sizeof(outputs));
+    memset(switches, 0, sizeof(switches));
+    armed                      = 0;
+    gpio_mock_pin_reads        = 0;
+    gpio_mock_port_reads       = 0;
+    gpio_mock_wakeup_supported = true;
+}
+
+void gpio_mock_set_switch(pin_t a, pin_t b, bool closed) {
+    int8_t ia = pin_index(a), ib = pin_index(b);
+    if (ia < 0 || ib < 0) {
+        return;
+    }
+    if (closed) {
+        switches[ia] |= (uint64_t)1 << ib;
+        switches[ib] |= (uint64_t)1 << ia;
+    } else {
+        switches[ia] &= ~((uint64_t)1 << ib);
+        switches[ib] &= ~((uint64_t)1 << ia);
+    }
+    check_wakeups();
+}
@@ -0,0 +1,71 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+    Simulated GPIO for unit tests, laid out as GPIO_MOCK_PORTS ports of 16 pads each. Switches can be closed between
+    any two pins, so that an input reads low while a closed switch connects it to an output driven low -- enough to
+    scan a diode matrix in either direction, and to raise pin interrupts from it.
+*/
+
+#define GPIO_MOCK_PORTS 4
+#define GPIO_MOCK_PADS 16
+
+typedef uint8_t  pin_t;
+typedef uint8_t  gpio_port_t;
+typedef uint16_t gpio_port_data_t;
+
+#define GPIO_MOCK_PIN(port, pad) ((pin_t)(((port) << 4) | (pad)))
+
+typedef enum {
+    GPIO_MOCK_INPUT,
+    GPIO_MOCK_INPUT_HIGH,
+    GPIO_MOCK_INPUT_LOW,
+    GPIO_MOCK_OUTPUT,
+} gpio_mock_mode_t;
+
+/* Operation of GPIO by pin. */
+
+#define setPinInput(pin) gpio_mock_set_mode((pin), GPIO_MOCK_INPUT)
+#define setPinInputHigh(pin) gpio_mock_set_mode((pin), GPIO_MOCK_INPUT_HIGH)
+#define setPinInputLow(pin) gpio_mock_set_mode((pin), GPIO_MOCK_INPUT_LOW)
+#define setPinOutputPushPull(pin) gpio_mock_set_mode((pin), GPIO_MOCK_OUTPUT)
+#define setPinOutputOpenDrain(pin) gpio_mock_set_mode((pin), GPIO_MOCK_OUTPUT)
+#define setPinOutput(pin) setPinOutputPushPull(pin)
+
+#define writePinHigh(pin) gpio_mock_write_pin((pin), true)
+#define writePinLow(pin) gpio_mock_write_pin((pin), false)
+#define writePin(pin, level) gpio_mock_write_pin((pin), (level))
+
+#define readPin(pin) gpio_mock_read_pin(pin)
+
+#define togglePin(pin) gpio_mock_write_pin((pin), !gpio_mock_read_pin(pin))
+
+/* Operation of GPIO by port. */
+
+#define getPinPort(pin) ((gpio_port_t)((pin) >> 4))
+#define getPinPad(pin) ((pin)&0xF)
+
+#define readGpioPort(port) gpio_mock_read_port(port)
+
+void             gpio_mock_set_mode(pin_t pin, gpio_mock_mode_t mode);
+void             gpio_mock_write_pin(pin_t pin, bool level);
+bool             gpio_mock_read_pin(pin_t pin);
+gpio_port_data_t gpio_mock_read_port(gpio_port_t port);
+
+/* Edge interrupts, calling back as soon as an armed pin's level changes. Arming fails while gpio_mock_wakeup_supported is false. */
+bool platform_pin_wakeup_arm(pin_t pin, void (*callback)(void));
+void platform_pin_wakeup_disarm(pin_t pin);
+
+extern bool gpio_mock_wakeup_supported;
+
+/* Puts every pin back to a floating input with all switches open and nothing armed, and clears the read counts. */
+void gpio_mock_reset(void);
+void gpio_mock_set_switch(pin_t a, pin_t b, bool closed);
+
+/* How many times readPin() and readGpioPort() were called since the last reset. */
+extern uint32_t gpio_mock_pin_reads;
+extern uint32_t gpio_mock_port_reads;
@@ -0,0 +1,181 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+#if (DIODE_DIRECTION == COL2ROW)
+const pin_t *output_pins  = row_pins;
+uint8_t      output_count = MATRIX_ROWS;
+#else
+const pin_t *output_pins  = col_pins;
+uint8_t      output_count = MATRIX_COLS;
+#endif
+
+void set_key(uint8_t row, uint8_t col, bool pressed) {
+    gpio_mock_set_switch(row_pins[row], col_pins[col], pressed);
+}
+
+/* Scans once a millisecond, as the main loop would without idle sleep. */
+void scan_for(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        advance_time(1);
+        matrix_scan();
+    }
+}
+
+bool press_during_scan = false;
+
+uint32_t reads() {
+    return gpio_mock_pin_reads + gpio_mock_port_reads;
+}
+
+} // namespace
+
+extern "C" void matrix_scan_kb(void) {
+    if (press_during_scan) {
+        press_during_scan = false;
+        set_key(0, 1, true);
+    }
+}
+
+class MatrixIdleWakeup : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        gpio_mock_reset();
+        press_during_scan = false;
+        set_time(1000);
+        matrix_init();
+    }
+
+    void arm() {
+        scan_for(MATRIX_IDLE_WAKEUP_SCANS);
+        ASSERT_TRUE(matrix_wakeup_is_armed());
+    }
+};
+
+TEST_F(MatrixIdleWakeup, ArmsAfterQuietScans) {
+    scan_for(MATRIX_IDLE_WAKEUP_SCANS - 1);
+    EXPECT_FALSE(matrix_wakeup_is_armed());
+    scan_for(1);
+    EXPECT_TRUE(matrix_wakeup_is_armed());
+
+    // Every output is selected at once
+    for (uint8_t i = 0; i < output_count; i++) {
+        EXPECT_FALSE(readPin(output_pins[i])) << "Output " << (int)i;
+    }
+
+    // ...and scans stop touching the matrix
+    uint32_t before = reads();
+    scan_for(1000);
+    EXPECT_EQ(reads(), before);
+    EXPECT_TRUE(matrix_wakeup_is_armed());
+}
+
+TEST_F(MatrixIdleWakeup, HeldKeyKeepsScanning) {
+    set_key(1, 2, true);
+    scan_for(MATRIX_IDLE_WAKEUP_SCANS * 3);
+    EXPECT_FALSE(matrix_wakeup_is_armed());
+    EXPECT_EQ(matrix_get_row(1), MATRIX_ROW_SHIFTER << 2);
+}
+
+TEST_F(MatrixIdleWakeup, FirstPressIsReadOnTheNextScan) {
+    arm();
+
+    // Every key wakes the matrix, and is the only key seen
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (row_pins[row] == NO_PIN || col_pins[col] == NO_PIN) {
+                continue;
+            }
+            set_key(row, col, true);
+            EXPECT_TRUE(matrix_wakeup_is_armed()) << "Nothing should happen until the next scan";
+            matrix_scan();
+            EXPECT_FALSE(matrix_wakeup_is_armed());
+            for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+                EXPECT_EQ(matrix_get_row(r), r == row ? (matrix_row_t)(MATRIX_ROW_SHIFTER << col) : 0) << "Key " << (int)row << "," << (int)col << ", row " << (int)r;
+            }
+            EXPECT_EQ(matrix_wakeup_get_stats()->last_latency, 0);
+
+            set_key(row, col, false);
+            arm();
+        }
+    }
+}
+
+TEST_F(MatrixIdleWakeup, LatencyIsCounted) {
+    arm();
+    set_key(0, 0, true);
+    advance_time(7);
+    matrix_scan();
+    EXPECT_EQ(matrix_get_row(0), MATRIX_ROW_SHIFTER);
+    EXPECT_EQ(matrix_wakeup_get_stats()->wakeups, 1);
+    EXPECT_EQ(matrix_wakeup_get_stats()->last_latency, 7);
+    EXPECT_EQ(matrix_wakeup_get_stats()->max_latency, 7);
+
+    set_key(0, 0, false);
+    arm();
+    set_key(1, 1, true);
+    advance_time(2);
+    matrix_scan();
+    EXPECT_EQ(matrix_wakeup_get_stats()->wakeups, 2);
+    EXPECT_EQ(matrix_wakeup_get_stats()->last_latency, 2);
+    EXPECT_EQ(matrix_wakeup_get_stats()->max_latency, 7);
+}
+
+TEST_F(MatrixIdleWakeup, KeyDownWhileArmingWakesStraightAway) {
+    scan_for(MATRIX_IDLE_WAKEUP_SCANS - 1);
+
+    // Goes down after the matrix was read, but before the inputs are armed, so raises no interrupt
+    press_during_scan = true;
+    scan_for(1);
+    EXPECT_TRUE(matrix_wakeup_is_armed());
+    EXPECT_EQ(matrix_get_row(0), 0);
+
+    scan_for(1);
+    EXPECT_FALSE(matrix_wakeup_is_armed());
+    EXPECT_EQ(matrix_get_row(0), MATRIX_ROW_SHIFTER << 1);
+    EXPECT_EQ(matrix_wakeup_get_stats()->wakeups, 1);
+}
+
+TEST_F(MatrixIdleWakeup, KeepsScanningWithoutPinInterrupts) {
+    gpio_mock_wakeup_supported = false;
+    scan_for(MATRIX_IDLE_WAKEUP_SCANS * 3);
+    EXPECT_FALSE(matrix_wakeup_is_armed());
+
+    // The outputs are left unselected, and keys are still read
+    for (uint8_t i = 0; i < output_count; i++) {
+        EXPECT_TRUE(readPin(output_pins[i])) << "Output " << (int)i;
+    }
+    set_key(1, 0, true);
+    scan_for(1);
+    EXPECT_EQ(matrix_get_row(1), MATRIX_ROW_SHIFTER);
+}
+
+TEST_F(MatrixIdleWakeup, IdleReadsPerSecond) {
+    gpio_mock_wakeup_supported = false;
+    gpio_mock_pin_reads        = 0;
+    gpio_mock_port_reads       = 0;
+    scan_for(1);
+    uint32_t per_scan = reads();
+    scan_for(999);
+    EXPECT_EQ(reads(), 1000 * per_scan);
+
+    // Armed, the matrix is only read until it arms, and each input once more as it does
+    gpio_mock_reset();
+    matrix_init();
+    scan_for(1000);
+    EXPECT_LE(reads(), MATRIX_IDLE_WAKEUP_SCANS * per_scan + MATRIX_ROWS + MATRIX_COLS);
+    EXPECT_LT(reads() * 20, 1000 * per_scan);
+}
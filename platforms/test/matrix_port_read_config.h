@@ -0,0 +1,43 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gpio_mock.h"
+
+#ifdef __cplusplus
+};
+#endif
+
+#if defined(MATRIX_TEST_ROW2COL)
+/* Rows mostly in order on one port, with a gap and a straggler on another */
+#    define MATRIX_ROWS 6
+#    define MATRIX_COLS 4
+#    define DIODE_DIRECTION ROW2COL
+#    define MATRIX_ROW_PINS \
+        { GPIO_MOCK_PIN(2, 2), GPIO_MOCK_PIN(2, 3), NO_PIN, GPIO_MOCK_PIN(2, 5), GPIO_MOCK_PIN(2, 6), GPIO_MOCK_PIN(1, 0) }
+#    define MATRIX_COL_PINS \
+        { GPIO_MOCK_PIN(0, 0), GPIO_MOCK_PIN(0, 1), GPIO_MOCK_PIN(0, 2), GPIO_MOCK_PIN(0, 3) }
+#elif defined(MATRIX_TEST_SPREAD)
+/* Cols spread over more ports than MATRIX_PORT_READ_MAX_PORTS */
+#    define MATRIX_ROWS 2
+#    define MATRIX_COLS 6
+#    define DIODE_DIRECTION COL2ROW
+#    define MATRIX_PORT_READ_MAX_PORTS 2
+#    define MATRIX_ROW_PINS \
+        { GPIO_MOCK_PIN(3, 0), GPIO_MOCK_PIN(3, 1) }
+#    define MATRIX_COL_PINS \
+        { GPIO_MOCK_PIN(0, 0), GPIO_MOCK_PIN(0, 1), GPIO_MOCK_PIN(1, 0), GPIO_MOCK_PIN(1, 1), GPIO_MOCK_PIN(2, 0), GPIO_MOCK_PIN(2, 1) }
+#else
+/* A wide board: cols in order on one port, a reversed group on another, a gap, then a few more back on the first port */
+#    define MATRIX_ROWS 5
+#    define MATRIX_COLS 16
+#    define DIODE_DIRECTION COL2ROW
+#    define MATRIX_ROW_PINS \
+        { GPIO_MOCK_PIN(3, 10), GPIO_MOCK_PIN(3, 11), GPIO_MOCK_PIN(3, 12), GPIO_MOCK_PIN(3, 13), GPIO_MOCK_PIN(3, 14) }
+#    define MATRIX_COL_PINS \
+        { GPIO_MOCK_PIN(0, 0), GPIO_MOCK_PIN(0, 1), GPIO_MOCK_PIN(0, 2), GPIO_MOCK_PIN(0, 3), GPIO_MOCK_PIN(0, 4), GPIO_MOCK_PIN(0, 5), GPIO_MOCK_PIN(0, 6), GPIO_MOCK_PIN(0, 7), GPIO_MOCK_PIN(1, 15), GPIO_MOCK_PIN(1, 14), GPIO_MOCK_PIN(1, 13), GPIO_MOCK_PIN(1, 12), NO_PIN, GPIO_MOCK_PIN(0, 8), GPIO_MOCK_PIN(0, 9), GPIO_MOCK_PIN(0, 10) }
+#endif
@@ -0,0 +1,120 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <random>
+#include <set>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+}
+
+#ifndef MATRIX_PORT_READ_MAX_PORTS
+#    define MATRIX_PORT_READ_MAX_PORTS 4 // As matrix.c
+#endif
+
+namespace {
+
+const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+#if (DIODE_DIRECTION == COL2ROW)
+const pin_t *input_pins   = col_pins;
+uint8_t      input_count  = MATRIX_COLS;
+uint8_t      output_count = MATRIX_ROWS;
+const pin_t *output_pins  = row_pins;
+#else
+const pin_t *input_pins   = row_pins;
+uint8_t      input_count  = MATRIX_ROWS;
+uint8_t      output_count = MATRIX_COLS;
+const pin_t *output_pins  = col_pins;
+#endif
+
+bool is_wired(uint8_t row, uint8_t col) {
+    return row_pins[row] != NO_PIN && col_pins[col] != NO_PIN;
+}
+
+void set_key(uint8_t row, uint8_t col, bool pressed) {
+    gpio_mock_set_switch(row_pins[row], col_pins[col], pressed);
+}
+
+uint8_t count_pins(const pin_t *pins, uint8_t count) {
+    uint8_t wired = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        wired += pins[i] != NO_PIN;
+    }
+    return wired;
+}
+
+uint8_t count_ports(const pin_t *pins, uint8_t count) {
+    std::set<gpio_port_t> ports;
+    for (uint8_t i = 0; i < count; i++) {
+        if (pins[i] != NO_PIN) {
+            ports.insert(getPinPort(pins[i]));
+        }
+    }
+    return ports.size();
+}
+
+} // namespace
+
+class MatrixPortRead : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        gpio_mock_reset();
+        matrix_init();
+        matrix_scan();
+    }
+};
+
+TEST_F(MatrixPortRead, EveryKey) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            set_key(row, col, true);
+            matrix_scan();
+            for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+                matrix_row_t expected = (r == row && is_wired(row, col)) ? (matrix_row_t)(MATRIX_ROW_SHIFTER << col) : 0;
+                EXPECT_EQ(matrix_get_row(r), expected) << "Key " << (int)row << "," << (int)col << ", row " << (int)r;
+            }
+            set_key(row, col, false);
+        }
+    }
+}
+
+TEST_F(MatrixPortRead, RandomChords) {
+    std::mt19937 rng(1);
+    for (int i = 0; i < 200; i++) {
+        matrix_row_t expected[MATRIX_ROWS] = {0};
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                bool pressed = rng() % 4 == 0;
+                set_key(row, col, pressed);
+                if (pressed && is_wired(row, col)) {
+                    expected[row] |= MATRIX_ROW_SHIFTER << col;
+                }
+            }
+        }
+        matrix_scan();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            EXPECT_EQ(matrix_get_row(row), expected[row]) << "Chord " << i << ", row " << (int)row;
+        }
+    }
+}
+
+TEST_F(MatrixPortRead, ReadsPerScan) {
+    uint32_t selects = count_pins(output_pins, output_count);
+    uint32_t pins    = count_pins(input_pins, input_count);
+    uint32_t ports   = count_ports(input_pins, input_count);
+
+    gpio_mock_pin_reads  = 0;
+    gpio_mock_port_reads = 0;
+    matrix_scan();
+
+    if (ports <= MATRIX_PORT_READ_MAX_PORTS) {
+        EXPECT_EQ(gpio_mock_pin_reads, 0);
+        EXPECT_EQ(gpio_mock_port_reads, selects * ports);
+    } else {
+        // Too spread out, falls back to reading pin by pin
+        EXPECT_EQ(gpio_mock_pin_reads, selects * pins);
+        EXPECT_EQ(gpio_mock_port_reads, 0);
+    }
+}
@@ -23,3 +23,48 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+ws2812_spi_encoder_DEFS := -DWS2812_SPI_ENCODER_BENCHMARK_NAME=\"ws2812_spi_encoder\"
+ws2812_spi_encoder_INC := \
+	$(PLATFORM_PATH)/chibios/drivers \
+	$(TOP_DIR)/tests/test_common
+ws2812_spi_encoder_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/ws2812_spi_encoder_tests.cpp \
+	$(PLATFORM_PATH)/chibios/drivers/ws2812_spi_encoder.c \
+	$(TOP_DIR)/tests/test_common/test_benchmark.cpp
+
+ws2812_spi_encoder_rgbw_DEFS := -DRGBW -DWS2812_SPI_ENCODER_BENCHMARK_NAME=\"ws2812_spi_encoder_rgbw\"
+ws2812_spi_encoder_rgbw_INC := $(ws2812_spi_encoder_INC)
+ws2812_spi_encoder_rgbw_SRC := $(ws2812_spi_encoder_SRC)
+
+matrix_port_read_DEFS := -DIGNORE_ATOMIC_BLOCK -DNO_PRINT
+matrix_port_read_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_port_read_config.h
+matrix_port_read_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_port_read_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/gpio_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/matrix_common.c \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_port_read_row2col_DEFS := $(matrix_port_read_DEFS) -DMATRIX_TEST_ROW2COL
+matrix_port_read_row2col_CONFIG := $(matrix_port_read_CONFIG)
+matrix_port_read_row2col_SRC := $(matrix_port_read_SRC)
+
+matrix_port_read_spread_DEFS := $(matrix_port_read_DEFS) -DMATRIX_TEST_SPREAD
+matrix_port_read_spread_CONFIG := $(matrix_port_read_CONFIG)
+matrix_port_read_spread_SRC := $(matrix_port_read_SRC)
+
+matrix_idle_wakeup_DEFS := $(matrix_port_read_DEFS) -DMATRIX_IDLE_WAKEUP -DMATRIX_IDLE_WAKEUP_SCANS=5
+matrix_idle_wakeup_CONFIG := $(matrix_port_read_CONFIG)
+matrix_idle_wakeup_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_idle_wakeup_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/gpio_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/matrix_common.c \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_idle_wakeup_row2col_DEFS := $(matrix_idle_wakeup_DEFS) -DMATRIX_TEST_ROW2COL
+matrix_idle_wakeup_row2col_CONFIG := $(matrix_idle_wakeup_CONFIG)
+matrix_idle_wakeup_row2col_SRC := $(matrix_idle_wakeup_SRC)
@@ -1 +1 @@
-TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large ws2812_spi_encoder ws2812_spi_encoder_rgbw matrix_port_read matrix_port_read_row2col matrix_port_read_spread matrix_idle_wakeup matrix_idle_wakeup_row2col
@@ -16,6 +16,7 @@
 
 #include "timer.h"
 #include <stdatomic.h>
+#include <time.h>
 
 static atomic_uint_least32_t current_time = 0;
 
@@ -50,3 +51,10 @@ void advance_time(uint32_t ms) {
 void wait_ms(uint32_t ms) {
     advance_time(ms);
 }
+
+uint32_t timer_read_profiling(void) {
+    // Real time, unlike the simulated millisecond timer above
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
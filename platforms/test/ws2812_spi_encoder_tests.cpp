@@ -0,0 +1,175 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_benchmark.hpp"
+
+extern "C" {
+#include "ws2812_spi_encoder.h"
+}
+
+namespace {
+
+constexpr uint16_t led_count = 256;
+
+/* The bit-by-bit encoding ws2812_spi.c used to do, as the reference the lookup table is held to. */
+uint8_t get_protocol_eq(uint8_t data, int pos) {
+    uint8_t eq = 0;
+    if (data & (1 << (2 * (3 - pos))))
+        eq = 0b1110;
+    else
+        eq = 0b1000;
+    if (data & (2 << (2 * (3 - pos))))
+        eq += 0b11100000;
+    else
+        eq += 0b10000000;
+    return eq;
+}
+
+void reference_encode_led(uint8_t *out, const LED_TYPE &color) {
+    const uint8_t *data = (const uint8_t *)&color;
+    for (size_t i = 0; i < sizeof(LED_TYPE); i++) {
+        for (int j = 0; j < 4; j++) {
+            out[WS2812_SPI_BYTES_PER_COLOR * i + j] = get_protocol_eq(data[i], j);
+        }
+    }
+}
+
+std::vector<uint8_t> reference_encode(const std::vector<LED_TYPE> &leds) {
+    std::vector<uint8_t> out(WS2812_SPI_BYTES_PER_LED * leds.size());
+    for (size_t i = 0; i < leds.size(); i++) {
+        reference_encode_led(&out[WS2812_SPI_BYTES_PER_LED * i], leds[i]);
+    }
+    return out;
+}
+
+std::vector<LED_TYPE> random_frame(std::mt19937 &rng) {
+    std::vector<LED_TYPE> leds(led_count);
+    for (auto &led : leds) {
+        uint8_t *data = (uint8_t *)&led;
+        for (size_t i = 0; i < sizeof(LED_TYPE); i++) {
+            data[i] = rng();
+        }
+    }
+    return leds;
+}
+
+} // namespace
+
+class Ws2812SpiEncoder : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        buffer.assign(WS2812_SPI_BYTES_PER_LED * led_count, 0);
+        colors.assign(led_count, LED_TYPE{});
+        encoder = {buffer.data(), colors.data(), 0};
+    }
+
+    std::vector<uint8_t>  buffer;
+    std::vector<LED_TYPE> colors;
+    ws2812_spi_encoder_t  encoder;
+};
+
+TEST_F(Ws2812SpiEncoder, EveryByteMatchesReference) {
+    for (int value = 0; value < 256; value++) {
+        LED_TYPE color;
+        memset(&color, value, sizeof(color));
+        uint8_t expected[WS2812_SPI_BYTES_PER_LED];
+        uint8_t actual[WS2812_SPI_BYTES_PER_LED];
+        reference_encode_led(expected, color);
+        ws2812_spi_encode_led(actual, &color);
+        ASSERT_EQ(memcmp(actual, expected, sizeof(actual)), 0) << "value " << value;
+    }
+}
+
+TEST_F(Ws2812SpiEncoder, ChannelOrderMatchesWire) {
+    // Each pair of bits, high first, goes out as 0x88, 0x8E, 0xE8 or 0xEE for 00, 01, 10 or 11
+    LED_TYPE color;
+    color.r = 0x12;
+    color.g = 0x34;
+    color.b = 0x56;
+#ifdef RGBW
+    color.w = 0x78;
+#endif
+    const uint8_t expected[] = {
+        0x88, 0xEE, 0x8E, 0x88, // G 0x34
+        0x88, 0x8E, 0x88, 0xE8, // R 0x12
+        0x8E, 0x8E, 0x8E, 0xE8, // B 0x56
+#ifdef RGBW
+        0x8E, 0xEE, 0xE8, 0x88, // W 0x78
+#endif
+    };
+    ASSERT_EQ(sizeof(expected), WS2812_SPI_BYTES_PER_LED);
+
+    uint8_t actual[WS2812_SPI_BYTES_PER_LED];
+    ws2812_spi_encode_led(actual, &color);
+    EXPECT_EQ(std::vector<uint8_t>(actual, actual + sizeof(actual)), std::vector<uint8_t>(expected, expected + sizeof(expected)));
+}
+
+TEST_F(Ws2812SpiEncoder, OnlyChangedLedsAreEncoded) {
+    std::mt19937 rng(1);
+    auto         leds = random_frame(rng);
+
+    EXPECT_EQ(ws2812_spi_encoder_update(&encoder, leds.data(), led_count), led_count) << "First frame should encode every LED";
+    EXPECT_EQ(buffer, reference_encode(leds));
+    EXPECT_EQ(ws2812_spi_encoder_update(&encoder, leds.data(), led_count), 0) << "Unchanged frame should encode nothing";
+
+    leds[3].r ^= 0x01;
+    leds[200].b ^= 0x80;
+    EXPECT_EQ(ws2812_spi_encoder_update(&encoder, leds.data(), led_count), 2);
+    EXPECT_EQ(buffer, reference_encode(leds));
+}
+
+TEST_F(Ws2812SpiEncoder, GrowingCountEncodesNewLeds) {
+    // A black LED past the end of the previous update must still be encoded, as its buffer hasn't been written
+    std::vector<LED_TYPE> leds(led_count, LED_TYPE{});
+    EXPECT_EQ(ws2812_spi_encoder_update(&encoder, leds.data(), 10), 10);
+    EXPECT_EQ(encoder.encoded, 10);
+    EXPECT_EQ(ws2812_spi_encoder_update(&encoder, leds.data(), led_count), led_count - 10);
+    EXPECT_EQ(ws2812_spi_encoder_update(&encoder, leds.data(), 10), 0);
+    EXPECT_EQ(encoder.encoded, led_count);
+    EXPECT_EQ(buffer, reference_encode(leds));
+}
+
+TEST_F(Ws2812SpiEncoder, RandomFramesMatchReference) {
+    std::mt19937 rng(2);
+    auto         leds = random_frame(rng);
+    for (int frame = 0; frame < 100; frame++) {
+        // A few LEDs change each frame, much like an animation
+        for (int i = 0; i < 20; i++) {
+            ((uint8_t *)&leds[rng() % led_count])[rng() % sizeof(LED_TYPE)] = rng();
+        }
+        ws2812_spi_encoder_update(&encoder, leds.data(), led_count);
+        ASSERT_EQ(buffer, reference_encode(leds)) << "frame " << frame;
+    }
+}
+
+TEST_F(Ws2812SpiEncoder, EncodeThroughput) {
+    std::mt19937   rng(3);
+    auto           frames     = std::vector<std::vector<LED_TYPE>>{random_frame(rng), random_frame(rng)};
+    auto           expected   = std::vector<uint8_t>(buffer.size());
+    const uint32_t iterations = BenchmarkRecorder::loops(2000);
+    auto          &recorder   = BenchmarkRecorder::instance();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint16_t led = 0; led < led_count; led++) {
+            reference_encode_led(&expected[WS2812_SPI_BYTES_PER_LED * led], frames[i & 1][led]);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        recorder.record("bit_by_bit", std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    // Every LED changes every frame, so nothing is skipped
+    for (uint32_t i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        ws2812_spi_encoder_update(&encoder, frames[i & 1].data(), led_count);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        recorder.record("lookup_table", std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+    EXPECT_EQ(buffer, expected);
+
+    EXPECT_TRUE(recorder.write_json(BenchmarkRecorder::output_path(WS2812_SPI_ENCODER_BENCHMARK_NAME), {{"benchmark", WS2812_SPI_ENCODER_BENCHMARK_NAME}, {"frames", std::to_string(iterations)}, {"led_count", std::to_string(led_count)}}));
+}
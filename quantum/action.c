@@ -521,9 +521,9 @@ void process_action(keyrecord_t *record, action_t action) {
                         if (tap_count > 0) {
                             ac_dprintf("MODS_TAP: Tap: unregister_code\n");
                             if (action.layer_tap.code == KC_CAPS_LOCK) {
-                                wait_ms(TAP_HOLD_CAPS_DELAY);
+                                output_queue_wait_ms(TAP_HOLD_CAPS_DELAY);
                             } else {
-                                wait_ms(TAP_CODE_DELAY);
+                                output_queue_wait_ms(TAP_CODE_DELAY);
                             }
                             unregister_code(action.key.code);
                         } else {
@@ -696,9 +696,9 @@ void process_action(keyrecord_t *record, action_t action) {
                         if (tap_count > 0) {
                             ac_dprintf("KEYMAP_TAP_KEY: Tap: unregister_code\n");
                             if (action.layer_tap.code == KC_CAPS_LOCK) {
-                                wait_ms(TAP_HOLD_CAPS_DELAY);
+                                output_queue_wait_ms(TAP_HOLD_CAPS_DELAY);
                             } else {
-                                wait_ms(TAP_CODE_DELAY);
+                                output_queue_wait_ms(TAP_CODE_DELAY);
                             }
                             unregister_code(action.layer_tap.code);
                         } else {
@@ -713,9 +713,9 @@ void process_action(keyrecord_t *record, action_t action) {
                     } else {
                         ac_dprintf("KEYMAP_TAP_KEY: Tap: unregister_code\n");
                         if (action.layer_tap.code == KC_CAPS) {
-                            wait_ms(TAP_HOLD_CAPS_DELAY);
+                            output_queue_wait_ms(TAP_HOLD_CAPS_DELAY);
                         } else {
-                            wait_ms(TAP_CODE_DELAY);
+                            output_queue_wait_ms(TAP_CODE_DELAY);
                         }
                         unregister_code(action.layer_tap.code);
                     }
@@ -785,7 +785,7 @@ void process_action(keyrecord_t *record, action_t action) {
                         if (event.pressed) {
                             register_code(action.swap.code);
                         } else {
-                            wait_ms(TAP_CODE_DELAY);
+                            output_queue_wait_ms(TAP_CODE_DELAY);
                             unregister_code(action.swap.code);
                             *record = (keyrecord_t){}; // hack: reset tap mode
                         }
@@ -886,7 +886,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
 #    endif
         add_key(KC_CAPS_LOCK);
         send_keyboard_report();
-        wait_ms(TAP_HOLD_CAPS_DELAY);
+        output_queue_wait_ms(TAP_HOLD_CAPS_DELAY);
         del_key(KC_CAPS_LOCK);
         send_keyboard_report();
 
@@ -896,7 +896,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
 #    endif
         add_key(KC_NUM_LOCK);
         send_keyboard_report();
-        wait_ms(100);
+        output_queue_wait_ms(100);
         del_key(KC_NUM_LOCK);
         send_keyboard_report();
 
@@ -906,7 +906,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
 #    endif
         add_key(KC_SCROLL_LOCK);
         send_keyboard_report();
-        wait_ms(100);
+        output_queue_wait_ms(100);
         del_key(KC_SCROLL_LOCK);
         send_keyboard_report();
 #endif
@@ -1004,9 +1004,13 @@ __attribute__((weak)) void unregister_code(uint8_t code) {
  */
 __attribute__((weak)) void tap_code_delay(uint8_t code, uint16_t delay) {
     register_code(code);
+#ifdef OUTPUT_QUEUE_ENABLE
+    output_queue_wait_ms(delay);
+#else
     for (uint16_t i = delay; i > 0; i--) {
         wait_ms(1);
     }
+#endif
     unregister_code(code);
 }
 
@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -316,11 +317,60 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+#    define LAYER_UNRESOLVED 0xFF
+
+/** \brief effective layers cache
  *
- * Gets the layer based on key info
+ * The layer each key resolves to, for the layer state the cache was last used with
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
+static uint8_t       effective_layers_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t effective_layers_cache_state;
+static bool          effective_layers_cache_valid = false;
+#    ifdef ENCODER_MAP_ENABLE
+static uint8_t encoder_effective_layers_cache[NUM_ENCODERS][2];
+#    endif // ENCODER_MAP_ENABLE
+
+/** \brief clear effective layers cache
+ *
+ * Forgets every resolved layer, call when the keymap changes
+ */
+void clear_effective_layers_cache(void) {
+    effective_layers_cache_valid = false;
+}
+
+/** \brief get effective layers cache entry
+ *
+ * Returns the cache entry of a key, emptying the cache first if the layer state changed since its last use
+ */
+static uint8_t *effective_layers_cache_entry(keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    if (!effective_layers_cache_valid || effective_layers_cache_state != layers) {
+        memset(effective_layers_cache, LAYER_UNRESOLVED, sizeof(effective_layers_cache));
+#    ifdef ENCODER_MAP_ENABLE
+        memset(encoder_effective_layers_cache, LAYER_UNRESOLVED, sizeof(encoder_effective_layers_cache));
+#    endif // ENCODER_MAP_ENABLE
+        effective_layers_cache_state = layers;
+        effective_layers_cache_valid = true;
+    }
+
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return &effective_layers_cache[key.row][key.col];
+    }
+#    ifdef ENCODER_MAP_ENABLE
+    else if ((key.row == KEYLOC_ENCODER_CW || key.row == KEYLOC_ENCODER_CCW) && key.col < NUM_ENCODERS) {
+        return &encoder_effective_layers_cache[key.col][key.row == KEYLOC_ENCODER_CW];
+    }
+#    endif // ENCODER_MAP_ENABLE
+    return NULL;
+}
+#endif
+
+/** \brief Layer switch walk layers
+ *
+ * Finds the topmost active layer where the key isn't transparent
+ */
+static uint8_t layer_switch_walk_layers(keypos_t key) {
 #ifndef NO_ACTION_LAYER
     action_t action;
     action.code = ACTION_TRANSPARENT;
@@ -342,6 +392,23 @@ uint8_t layer_switch_get_layer(keypos_t key) {
 #endif
 }
 
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    uint8_t *cached = effective_layers_cache_entry(key);
+    if (cached) {
+        if (*cached == LAYER_UNRESOLVED) {
+            *cached = layer_switch_walk_layers(key);
+        }
+        return *cached;
+    }
+#endif
+    return layer_switch_walk_layers(key);
+}
+
 /** \brief Layer switch get layer
  *
  * Gets action code based on key position
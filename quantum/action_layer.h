@@ -165,5 +165,14 @@ action_t store_or_get_action(bool pressed, keypos_t key);
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
+#ifdef LAYER_LOOKUP_CACHE
+#    ifndef NO_ACTION_LAYER
+/* forget the layers keys resolved to, as the keymap changed */
+void clear_effective_layers_cache(void);
+#    else
+#        define clear_effective_layers_cache()
+#    endif
+#endif
+
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
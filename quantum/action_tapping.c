@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
@@ -59,25 +60,64 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
-static keyrecord_t tapping_key                         = {};
-static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
-static uint8_t     waiting_buffer_head                 = 0;
-static uint8_t     waiting_buffer_tail                 = 0;
+#    define WAITING_BUFFER_MASK (WAITING_BUFFER_SIZE - 1)
+_Static_assert((WAITING_BUFFER_SIZE & WAITING_BUFFER_MASK) == 0, "WAITING_BUFFER_SIZE must be a power of two");
+
+// Queued presses and releases are counted per bucket of keys, so asking whether a key has a queued event is answered
+// without walking the buffer whenever its bucket is empty
+#    define WAITING_BUFFER_KEY_BUCKETS 16
+#    define WAITING_BUFFER_BUCKET(key) (((key).row * 3 + (key).col) % WAITING_BUFFER_KEY_BUCKETS)
+
+// Whether a queued record held back by process_tapping() is left alone until something it depends on changes: a key
+// event, the tapping key, the layers or g_tapping_term. Per key callbacks whose answer can change in between, say with
+// a timer or state set outside of key processing, need this turned off so the record is examined every tick.
+#    ifndef WAITING_BUFFER_SETTLE
+#        define WAITING_BUFFER_SETTLE true
+#    endif
+
+static keyrecord_t tapping_key                                        = {};
+static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE]                = {};
+static uint8_t     waiting_buffer_head                                = 0;
+static uint8_t     waiting_buffer_tail                                = 0;
+static uint8_t     waiting_buffer_keys[2][WAITING_BUFFER_KEY_BUCKETS] = {};
+static bool        waiting_buffer_settled                             = false;
 
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
 static void waiting_buffer_clear(void);
+static bool waiting_buffer_has_key(keypos_t key, bool pressed);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
+/** \brief Tapping key changed
+ *
+ * Returns whether the tapping key is a different key, or the same key in a different state, than it was.
+ */
+static bool tapping_key_changed(const keyrecord_t *last) {
+    return !KEYEQ(last->event.key, tapping_key.event.key) || last->event.pressed != tapping_key.event.pressed || last->event.time != tapping_key.event.time || last->tap.count != tapping_key.tap.count || last->tap.interrupted != tapping_key.tap.interrupted
+#    if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+           || last->keycode != tapping_key.keycode
+#    endif
+        ;
+}
+
 /** \brief Action Tapping Process
  *
  * FIXME: Needs doc
  */
 void action_tapping_process(keyrecord_t record) {
+    keyrecord_t last_tapping_key = tapping_key;
+#    ifndef NO_ACTION_LAYER
+    layer_state_t last_layer_state = layer_state | default_layer_state;
+#    endif
+#    ifdef DYNAMIC_TAPPING_TERM_ENABLE
+    uint16_t last_tapping_term = g_tapping_term;
+#    endif
+
     if (process_tapping(&record)) {
         if (IS_EVENT(record.event)) {
             ac_dprintf("processed: ");
@@ -94,16 +134,39 @@ void action_tapping_process(keyrecord_t record) {
         }
     }
 
+    // A queued record is only examined again once something it depends on has changed. Its own time is fixed, so on a
+    // tick which left the tapping key, layers and tapping term alone it would be held back again, exactly as it was last
+    // time -- as long as the per key callbacks answer the same, see WAITING_BUFFER_SETTLE.
+    if (IS_EVENT(record.event) || tapping_key_changed(&last_tapping_key)) {
+        waiting_buffer_settled = false;
+    }
+#    ifndef NO_ACTION_LAYER
+    if (last_layer_state != (layer_state | default_layer_state)) {
+        waiting_buffer_settled = false;
+    }
+#    endif
+#    ifdef DYNAMIC_TAPPING_TERM_ENABLE
+    // Written directly by keymaps as well as by the DT_* keycodes
+    if (last_tapping_term != g_tapping_term) {
+        waiting_buffer_settled = false;
+    }
+#    endif
+    if (WAITING_BUFFER_SETTLE && waiting_buffer_settled) {
+        return;
+    }
+
     // process waiting_buffer
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_deq()) {
+        last_tapping_key = tapping_key;
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
             ac_dprintf("\n\n");
         } else {
+            waiting_buffer_settled = !tapping_key_changed(&last_tapping_key);
             break;
         }
     }
@@ -156,6 +219,14 @@ void action_tapping_process(keyrecord_t record) {
 #        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS false
 #    endif
 
+/** \brief Reports when tick events are next needed to resolve a tapping key or the waiting buffer
+ */
+void action_tapping_next_deadline(uint32_t *deadline) {
+    if (IS_EVENT(tapping_key.event) || waiting_buffer_head != waiting_buffer_tail) {
+        keyboard_update_deadline(deadline, timer_read32() + 1);
+    }
+}
+
 /** \brief Tapping
  *
  * Rule: Tap key is typed(pressed and released) within TAPPING_TERM.
@@ -448,47 +519,71 @@ bool waiting_buffer_enq(keyrecord_t record) {
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if (((waiting_buffer_head + 1) & WAITING_BUFFER_MASK) == waiting_buffer_tail) {
         ac_dprintf("waiting_buffer_enq: Over flow.\n");
         return false;
     }
 
     waiting_buffer[waiting_buffer_head] = record;
-    waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    waiting_buffer_head                 = (waiting_buffer_head + 1) & WAITING_BUFFER_MASK;
+    waiting_buffer_keys[record.event.pressed][WAITING_BUFFER_BUCKET(record.event.key)]++;
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest record from the waiting buffer.
+ */
+void waiting_buffer_deq(void) {
+    keyevent_t event = waiting_buffer[waiting_buffer_tail].event;
+    waiting_buffer_keys[event.pressed][WAITING_BUFFER_BUCKET(event.key)]--;
+    waiting_buffer_tail = (waiting_buffer_tail + 1) & WAITING_BUFFER_MASK;
+}
+
 /** \brief Waiting buffer clear
  *
  * FIXME: Needs docs
  */
 void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+    waiting_buffer_head    = 0;
+    waiting_buffer_tail    = 0;
+    waiting_buffer_settled = false;
+    memset(waiting_buffer_keys, 0, sizeof(waiting_buffer_keys));
 }
 
-/** \brief Waiting buffer typed
+/** \brief Waiting buffer has key
  *
- * FIXME: Needs docs
+ * Returns whether a press or release of the key is queued in the waiting buffer.
  */
-bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
+bool waiting_buffer_has_key(keypos_t key, bool pressed) {
+    if (!waiting_buffer_keys[pressed][WAITING_BUFFER_BUCKET(key)]) {
+        return false;
+    }
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) & WAITING_BUFFER_MASK) {
+        if (KEYEQ(key, waiting_buffer[i].event.key) && pressed == waiting_buffer[i].event.pressed) {
             return true;
         }
     }
     return false;
 }
 
+/** \brief Waiting buffer typed
+ *
+ * Returns whether the opposite event of the same key is queued in the waiting buffer.
+ */
+bool waiting_buffer_typed(keyevent_t event) {
+    return waiting_buffer_has_key(event.key, !event.pressed);
+}
+
 /** \brief Waiting buffer has anykey pressed
  *
  * FIXME: Needs docs
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) & WAITING_BUFFER_MASK) {
         if (waiting_buffer[i].event.pressed) return true;
     }
     return false;
@@ -502,11 +597,12 @@ void waiting_buffer_scan_tap(void) {
     // early return if:
     // - tapping already is settled
     // - invalid state: tapping_key released && tap.count == 0
-    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed) {
+    // - no release of the tapping key is queued
+    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed || !waiting_buffer_has_key(tapping_key.event.key, false)) {
         return;
     }
 
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) & WAITING_BUFFER_MASK) {
         keyrecord_t *candidate = &waiting_buffer[i];
         if (IS_EVENT(candidate->event) && KEYEQ(candidate->event.key, tapping_key.event.key) && !candidate->event.pressed && WITHIN_TAPPING_TERM(candidate->event)) {
             tapping_key.tap.count = 1;
@@ -536,7 +632,7 @@ static void debug_tapping_key(void) {
  */
 static void debug_waiting_buffer(void) {
     ac_dprintf("{ ");
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) & WAITING_BUFFER_MASK) {
         ac_dprintf("[%u]=", i);
         debug_record(waiting_buffer[i]);
         ac_dprintf(" ");
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
 
+#include <stdint.h>
+
 /*
     This API allows for basic profiling information to be printed out over console.
 
@@ -19,6 +21,11 @@
         PROFILE_CALL_NAMED(1000, "matrix_task", {
             matrix_task();
         });
+
+    Alternatively, PROFILE_TASK() / PROFILE_TASK_NAMED() time every single call and hand the
+    measurement to profile_task_record(), which must be supplied by whoever consumes the data,
+    e.g. the host-side benchmarks in tests/benchmark. keyboard_task() uses these for each of its
+    subsystems when KEYBOARD_TASK_PROFILING is defined.
 */
 
 #if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
@@ -27,6 +34,10 @@
 #    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
 #elif defined(PROTOCOL_ARM_ATSAM)
 #    error arm_atsam not currently supported
+#elif defined(PROTOCOL_TEST)
+// Host builds count nanoseconds of a monotonic clock
+uint32_t timer_read_profiling(void);
+#    define TIMESTAMP_GETTER timer_read_profiling()
 #else
 #    error Unknown protocol in use
 #endif
@@ -67,3 +78,16 @@
 #endif // CONSOLE_ENABLE
 
 #define PROFILE_CALL(count, call) PROFILE_CALL_NAMED(count, #call, call)
+
+void profile_task_record(const char *name, uint32_t elapsed);
+
+#define PROFILE_TASK_NAMED(name, call)                                      \
+    do {                                                                    \
+        uint32_t start_ts = TIMESTAMP_GETTER;                               \
+        do {                                                                \
+            call;                                                           \
+        } while (0);                                                        \
+        profile_task_record((name), (uint32_t)TIMESTAMP_GETTER - start_ts); \
+    } while (0)
+
+#define PROFILE_TASK(task) PROFILE_TASK_NAMED(#task, task())
@@ -40,8 +40,16 @@ void caps_word_task(void) {
 void caps_word_reset_idle_timer(void) {
     idle_timer = timer_read() + CAPS_WORD_IDLE_TIMEOUT;
 }
+
+void caps_word_next_deadline(uint32_t *deadline) {
+    if (caps_word_active) {
+        const uint32_t now = timer_read32();
+        keyboard_update_deadline(deadline, now + (timer_expired((uint16_t)now, idle_timer) ? 0 : (uint16_t)(idle_timer - now)));
+    }
+}
 #else
 void caps_word_task(void) {}
+void caps_word_next_deadline(uint32_t *deadline) {}
 #endif // CAPS_WORD_IDLE_TIMEOUT > 0
 
 void caps_word_on(void) {
@@ -109,6 +109,54 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+/* Which of v, p, q and t ends up in red, green and blue for each hue region of hsv_to_rgb_impl() */
+enum { HSV_V, HSV_P, HSV_Q, HSV_T };
+static const uint8_t PROGMEM hsv_region_channels[7][3] = {
+    {HSV_V, HSV_T, HSV_P}, {HSV_Q, HSV_V, HSV_P}, {HSV_P, HSV_V, HSV_T}, {HSV_P, HSV_Q, HSV_V}, {HSV_T, HSV_P, HSV_V}, {HSV_V, HSV_P, HSV_Q}, {HSV_V, HSV_T, HSV_P},
+};
+
+static void hsv_to_rgb_batch_impl(const HSV *hsv, RGB *rgb, uint8_t count, bool use_cie) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t h = hsv[i].h;
+        uint16_t s = hsv[i].s;
+        uint16_t v = hsv[i].v;
+#ifdef USE_CIE1931_CURVE
+        if (use_cie) {
+            v = pgm_read_byte(&CIE1931_CURVE[v]);
+        }
+#endif
+
+        uint8_t region    = h * 6 / 255;
+        uint8_t remainder = (h * 2 - region * 85) * 3;
+
+        // Compute every candidate and pick through the table rather than branching per region
+        uint8_t channel[4];
+        channel[HSV_V] = v;
+        channel[HSV_P] = (v * (255 - s)) >> 8;
+        channel[HSV_Q] = (v * (255 - ((s * remainder) >> 8))) >> 8;
+        channel[HSV_T] = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+        if (s == 0) {
+            channel[HSV_P] = channel[HSV_Q] = channel[HSV_T] = v;
+        }
+
+        rgb[i].r = channel[pgm_read_byte(&hsv_region_channels[region][0])];
+        rgb[i].g = channel[pgm_read_byte(&hsv_region_channels[region][1])];
+        rgb[i].b = channel[pgm_read_byte(&hsv_region_channels[region][2])];
+    }
+}
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
+
+void hsv_to_rgb_batch_nocie(const HSV *hsv, RGB *rgb, uint8_t count) {
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+}
+
 #ifdef RGBW
 void convert_rgb_to_rgbw(LED_TYPE *led) {
     // Determine lowest value in all three colors, put that into
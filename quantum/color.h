@@ -145,6 +145,9 @@ typedef struct PACKED {
 
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
+/* Converts `count` colours at once, giving the same results as hsv_to_rgb() for each */
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count);
+void hsv_to_rgb_batch_nocie(const HSV *hsv, RGB *rgb, uint8_t count);
 #ifdef RGBW
 void convert_rgb_to_rgbw(LED_TYPE *led);
 #endif
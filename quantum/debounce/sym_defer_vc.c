@@ -0,0 +1,173 @@
+/*
+Copyright 2023 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-key algorithm using vertical counters. Behaves like sym_defer_pk:
+when no state changes have occured on a key for DEBOUNCE milliseconds, its
+state is pushed. Rather than a byte per key, bit b of every counter in a row
+is kept together in one matrix_row_t, so a whole row is counted down with a
+few word-wide operations, and only as many bits are kept per key as DEBOUNCE
+needs.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE < 2
+#    define COUNTER_BITS 1
+#elif DEBOUNCE < 4
+#    define COUNTER_BITS 2
+#elif DEBOUNCE < 8
+#    define COUNTER_BITS 3
+#elif DEBOUNCE < 16
+#    define COUNTER_BITS 4
+#elif DEBOUNCE < 32
+#    define COUNTER_BITS 5
+#elif DEBOUNCE < 64
+#    define COUNTER_BITS 6
+#elif DEBOUNCE < 128
+#    define COUNTER_BITS 7
+#else
+#    define COUNTER_BITS 8
+#endif
+
+#if DEBOUNCE > 0
+// [bit][row] milliseconds until each key's state is considered debounced, zero when not debouncing
+static matrix_row_t counters[COUNTER_BITS][MATRIX_ROWS];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    memset(counters, 0, sizeof(counters));
+    counters_need_update = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t active = 0;
+        for (uint8_t bit = 0; bit < COUNTER_BITS; bit++) {
+            active |= counters[bit][row];
+        }
+        if (!active) {
+            continue;
+        }
+
+        matrix_row_t expired = active;
+        if (elapsed_time < DEBOUNCE) {
+            // Subtract elapsed_time from every counter of the row at once, keeping the borrow of each
+            matrix_row_t borrow    = 0;
+            matrix_row_t remaining = 0;
+            for (uint8_t bit = 0; bit < COUNTER_BITS; bit++) {
+                matrix_row_t counter = counters[bit][row];
+                if (elapsed_time & (1 << bit)) {
+                    counters[bit][row] = ~(counter ^ borrow);
+                    borrow             = ~counter | borrow;
+                } else {
+                    counters[bit][row] = counter ^ borrow;
+                    borrow             = ~counter & borrow;
+                }
+                remaining |= counters[bit][row];
+            }
+            // Counters that went below zero or reached it have expired
+            expired = active & (borrow | ~remaining);
+        }
+
+        for (uint8_t bit = 0; bit < COUNTER_BITS; bit++) {
+            counters[bit][row] &= active & ~expired;
+        }
+        if (active & ~expired) {
+            counters_need_update = true;
+        }
+
+        matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+        cooked_changed |= cooked[row] ^ cooked_next;
+        cooked[row] = cooked_next;
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta  = raw[row] ^ cooked[row];
+        matrix_row_t active = 0;
+        for (uint8_t bit = 0; bit < COUNTER_BITS; bit++) {
+            active |= counters[bit][row];
+        }
+
+        // Keys that differ start counting unless they already are, keys that don't stop
+        matrix_row_t start = delta & ~active;
+        for (uint8_t bit = 0; bit < COUNTER_BITS; bit++) {
+            counters[bit][row] &= delta;
+            if (DEBOUNCE & (1 << bit)) {
+                counters[bit][row] |= start;
+            }
+        }
+        if (start) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,149 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "test_benchmark.hpp"
+
+extern "C" {
+#include "quantum.h"
+#include "timer.h"
+#include "debounce.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+/* sym_defer_pk, one byte per key, as the reference the algorithm under test is held to. */
+class ReferenceDebounce {
+   public:
+    ReferenceDebounce() : counters_(MATRIX_ROWS * MATRIX_COLS, 0) {}
+
+    void scan(const matrix_row_t raw[], matrix_row_t cooked[], bool changed, fast_timer_t now) {
+        bool updated_last = false;
+        if (need_update_) {
+            fast_timer_t elapsed = TIMER_DIFF_FAST(now, last_time_);
+            last_time_           = now;
+            updated_last         = true;
+            if (elapsed > UINT8_MAX) {
+                elapsed = UINT8_MAX;
+            }
+            if (elapsed > 0) {
+                need_update_ = false;
+                for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                        uint8_t &counter = counters_[row * MATRIX_COLS + col];
+                        if (!counter) {
+                            continue;
+                        }
+                        if (counter <= elapsed) {
+                            counter     = 0;
+                            cooked[row] = (cooked[row] & ~(MATRIX_ROW_SHIFTER << col)) | (raw[row] & (MATRIX_ROW_SHIFTER << col));
+                        } else {
+                            counter -= elapsed;
+                            need_update_ = true;
+                        }
+                    }
+                }
+            }
+        }
+        if (changed) {
+            if (!updated_last) {
+                last_time_ = now;
+            }
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    uint8_t &counter = counters_[row * MATRIX_COLS + col];
+                    if ((raw[row] ^ cooked[row]) & (MATRIX_ROW_SHIFTER << col)) {
+                        if (!counter) {
+                            counter      = DEBOUNCE;
+                            need_update_ = true;
+                        }
+                    } else {
+                        counter = 0;
+                    }
+                }
+            }
+        }
+    }
+
+   private:
+    std::vector<uint8_t> counters_;
+    fast_timer_t         last_time_   = 0;
+    bool                 need_update_ = false;
+};
+
+/* Scans of a matrix with a few keys bouncing at a time, and now and then a long idle gap. */
+struct Scan {
+    matrix_row_t raw[MATRIX_ROWS];
+    bool         changed;
+    uint32_t     advance;
+};
+
+std::vector<Scan> bouncing_scans(uint32_t count) {
+    std::mt19937      rng(42);
+    std::vector<Scan> scans(count);
+    matrix_row_t      raw[MATRIX_ROWS] = {0};
+
+    for (auto &scan : scans) {
+        scan.changed = false;
+        if (rng() % 4 == 0) {
+            uint8_t row = rng() % MATRIX_ROWS;
+            raw[row] ^= MATRIX_ROW_SHIFTER << (rng() % MATRIX_COLS);
+            scan.changed = true;
+        }
+        memcpy(scan.raw, raw, sizeof(raw));
+        scan.advance = (rng() % 500 == 0) ? 300 : rng() % 3;
+    }
+    return scans;
+}
+
+} // namespace
+
+TEST(DebounceBenchmark, MatchesPerKeyReference) {
+    auto              scans                 = bouncing_scans(20000);
+    matrix_row_t      cooked[MATRIX_ROWS]   = {0};
+    matrix_row_t      expected[MATRIX_ROWS] = {0};
+    ReferenceDebounce reference;
+
+    set_time(1000);
+    debounce_init(MATRIX_ROWS);
+    for (size_t i = 0; i < scans.size(); i++) {
+        debounce(scans[i].raw, cooked, MATRIX_ROWS, scans[i].changed);
+        reference.scan(scans[i].raw, expected, scans[i].changed, timer_read_fast());
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            ASSERT_EQ(cooked[row], expected[row]) << "scan " << i << " row " << +row;
+        }
+        advance_time(scans[i].advance);
+    }
+    debounce_free();
+}
+
+TEST(DebounceBenchmark, ScanThroughput) {
+    constexpr size_t batch               = 1000; // Scans timed together, as a single one is over too quickly
+    auto             scans               = bouncing_scans(BenchmarkRecorder::loops(200000));
+    matrix_row_t     cooked[MATRIX_ROWS] = {0};
+    auto            &recorder            = BenchmarkRecorder::instance();
+
+    set_time(1000);
+    debounce_init(MATRIX_ROWS);
+    for (size_t i = 0; i + batch <= scans.size(); i += batch) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t j = i; j < i + batch; j++) {
+            debounce(scans[j].raw, cooked, MATRIX_ROWS, scans[j].changed);
+            advance_time(scans[j].advance);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        recorder.record("debounce", std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / batch);
+    }
+    debounce_free();
+
+    EXPECT_TRUE(recorder.write_json(BenchmarkRecorder::output_path(DEBOUNCE_BENCHMARK_NAME), {{"benchmark", DEBOUNCE_BENCHMARK_NAME}, {"scans", std::to_string(scans.size())}, {"matrix", std::to_string(MATRIX_ROWS) + "x" + std::to_string(MATRIX_COLS)}, {"debounce", std::to_string(DEBOUNCE)}}));
+}
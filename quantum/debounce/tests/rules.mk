@@ -28,6 +28,17 @@ debounce_sym_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp
 
+debounce_sym_defer_vc_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_vc_tests.cpp
+
+debounce_sym_defer_vc_2bit_DEFS := -DMATRIX_ROWS=4 -DMATRIX_COLS=10 -DDEBOUNCE=3
+debounce_sym_defer_vc_2bit_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_vc_tests.cpp
+
 debounce_sym_defer_pr_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_defer_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pr.c \
@@ -47,3 +58,21 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+DEBOUNCE_BENCHMARK_DEFS := -DMATRIX_ROWS=32 -DMATRIX_COLS=32 -DDEBOUNCE=5
+
+DEBOUNCE_BENCHMARK_INC := $(TOP_DIR)/tests/test_common
+
+DEBOUNCE_BENCHMARK_SRC := $(QUANTUM_PATH)/debounce/tests/debounce_benchmark.cpp \
+	$(TOP_DIR)/tests/test_common/test_benchmark.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+debounce_benchmark_sym_defer_pk_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_NAME=\"debounce_sym_defer_pk\"
+debounce_benchmark_sym_defer_pk_INC := $(DEBOUNCE_BENCHMARK_INC)
+debounce_benchmark_sym_defer_pk_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk.c
+
+debounce_benchmark_sym_defer_vc_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_NAME=\"debounce_sym_defer_vc\"
+debounce_benchmark_sym_defer_vc_INC := $(DEBOUNCE_BENCHMARK_INC)
+debounce_benchmark_sym_defer_vc_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c
@@ -0,0 +1,98 @@
+/* Copyright 2023 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include "debounce_test_common.h"
+
+/* The behaviour shared with sym_defer_pk is covered by sym_defer_pk_tests.cpp, which is built into this test as
+ * well. These cover the vertical counters themselves, and are also run with a DEBOUNCE needing only 2 counter bits. */
+
+#define D DEBOUNCE
+
+TEST_F(DebounceTest, BounceRestartsCounter) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        /* Bounce back up just before the counter runs out, which stops it */
+        {D - 1, {{0, 1, UP}}, {}},
+        /* Counting starts over from DEBOUNCE, instead of carrying on from where it was */
+        {D, {{0, 1, DOWN}}, {}},
+
+        {2 * D, {}, {{0, 1, DOWN}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, LateScanUnderflowsOneCounter) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        /* Leaves 1ms on the first counter while the second starts at DEBOUNCE, in the same row */
+        {D - 1, {{0, 2, DOWN}}, {}},
+        /* 2ms later the first counter borrows past zero and expires, the second still has some left */
+        {D + 1, {}, {{0, 1, DOWN}}},
+
+        {2 * D - 1, {}, {{0, 2, DOWN}}},
+    });
+    time_jumps_ = true;
+    runEvents();
+}
+
+TEST_F(DebounceTest, LongScanGapExpiresCounter) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        /* Far more time than the counter can hold, or an 8-bit elapsed time */
+        {300, {}, {{0, 1, DOWN}}},
+        {301, {{0, 1, UP}}, {}},
+
+        {301 + D, {}, {{0, 1, UP}}},
+    });
+    time_jumps_ = true;
+    runEvents();
+}
+
+TEST_F(DebounceTest, RowOfKeysStaggered) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 0, DOWN}}, {}},
+        {1, {{0, 3, DOWN}}, {}},
+        {2, {{0, 9, DOWN}, {1, 3, DOWN}, {0, 3, UP}}, {}},
+
+        {D, {}, {{0, 0, DOWN}}},
+        {D + 1, {{0, 0, UP}}, {}},
+        {D + 2, {}, {{0, 9, DOWN}, {1, 3, DOWN}}},
+
+        {2 * D + 1, {}, {{0, 0, UP}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, AllKeysAtOnce) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 0, DOWN}, {0, 9, DOWN}, {1, 0, DOWN}, {1, 9, DOWN}, {2, 0, DOWN}, {2, 9, DOWN}, {3, 0, DOWN}, {3, 9, DOWN}}, {}},
+
+        {D, {}, {{0, 0, DOWN}, {0, 9, DOWN}, {1, 0, DOWN}, {1, 9, DOWN}, {2, 0, DOWN}, {2, 9, DOWN}, {3, 0, DOWN}, {3, 9, DOWN}}},
+        {D + 1, {{0, 0, UP}, {1, 9, UP}}, {}},
+        {D + 3, {{2, 0, UP}, {3, 9, UP}}, {}},
+
+        {2 * D + 1, {}, {{0, 0, UP}, {1, 9, UP}}},
+        {2 * D + 3, {}, {{2, 0, UP}, {3, 9, UP}}},
+    });
+    runEvents();
+}
@@ -39,6 +39,238 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
     return current_token;
 }
 
+static inline void clear_entry(deferred_executor_t *entry) {
+    entry->token        = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
+}
+
+static inline bool trigger_time_before(uint32_t a, uint32_t b) {
+    return ((int32_t)TIMER_DIFF_32(a, b)) < 0;
+}
+
+#ifdef DEFERRED_EXEC_MIN_HEAP
+
+//------------------------------------
+// Min-heap backend: live entries are packed at the start of the table, ordered as a binary heap on trigger_time. The
+// next executor to fire is always at table[0], so an idle tick only needs to look at a single entry.
+//
+
+static inline size_t heap_count(deferred_executor_t *table, size_t table_count) {
+    // Live entries are contiguous, so the first free slot can be found with a binary search
+    size_t lo = 0;
+    size_t hi = table_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (table[mid].token != INVALID_DEFERRED_TOKEN) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static inline void heap_swap(deferred_executor_t *table, size_t a, size_t b) {
+    deferred_executor_t tmp = table[a];
+    table[a]                = table[b];
+    table[b]                = tmp;
+}
+
+static size_t heap_sift_up(deferred_executor_t *table, size_t idx) {
+    while (idx > 0) {
+        size_t parent = (idx - 1) / 2;
+        if (!trigger_time_before(table[idx].trigger_time, table[parent].trigger_time)) {
+            break;
+        }
+        heap_swap(table, idx, parent);
+        idx = parent;
+    }
+    return idx;
+}
+
+static void heap_sift_down(deferred_executor_t *table, size_t count, size_t idx) {
+    while (true) {
+        size_t left     = 2 * idx + 1;
+        size_t right    = left + 1;
+        size_t earliest = idx;
+        if (left < count && trigger_time_before(table[left].trigger_time, table[earliest].trigger_time)) {
+            earliest = left;
+        }
+        if (right < count && trigger_time_before(table[right].trigger_time, table[earliest].trigger_time)) {
+            earliest = right;
+        }
+        if (earliest == idx) {
+            break;
+        }
+        heap_swap(table, idx, earliest);
+        idx = earliest;
+    }
+}
+
+static inline void heap_fix(deferred_executor_t *table, size_t count, size_t idx) {
+    if (heap_sift_up(table, idx) == idx) {
+        heap_sift_down(table, count, idx);
+    }
+}
+
+static inline int heap_find(deferred_executor_t *table, size_t count, deferred_token token) {
+    for (int i = 0; i < count; ++i) {
+        if (table[i].token == token) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void heap_remove(deferred_executor_t *table, size_t count, size_t idx) {
+    size_t last = count - 1;
+    if (idx != last) {
+        table[idx] = table[last];
+        clear_entry(&table[last]);
+        heap_fix(table, last, idx);
+    } else {
+        clear_entry(&table[last]);
+    }
+}
+
+//------------------------------------
+// Advanced API: used when a custom-allocated table is used, primarily for core code.
+//
+
+deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
+    // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
+    if (!table || table_count == 0 || delay_ms == 0 || !callback) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    // The first unused slot is directly after the live entries
+    size_t count = heap_count(table, table_count);
+    if (count == table_count) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    // Work out the new token value, dropping out if none were available
+    deferred_token token = allocate_token(table, count);
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    // Set up the executor table entry, then move it into position
+    deferred_executor_t *entry = &table[count];
+    entry->token               = token;
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+    heap_sift_up(table, count);
+    return token;
+}
+
+bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
+    // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
+    if (!table || table_count == 0 || delay_ms == 0 || token == INVALID_DEFERRED_TOKEN) {
+        return false;
+    }
+
+    size_t count = heap_count(table, table_count);
+    int    idx   = heap_find(table, count, token);
+    if (idx < 0) {
+        return false;
+    }
+
+    table[idx].trigger_time = timer_read32() + delay_ms;
+    heap_fix(table, count, idx);
+    return true;
+}
+
+bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    // Ignore request if the table/token are not valid
+    if (!table || table_count == 0 || token == INVALID_DEFERRED_TOKEN) {
+        return false;
+    }
+
+    size_t count = heap_count(table, table_count);
+    int    idx   = heap_find(table, count, token);
+    if (idx < 0) {
+        return false;
+    }
+
+    heap_remove(table, count, idx);
+    return true;
+}
+
+void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
+    uint32_t now = timer_read32();
+
+    // Throttle only once per millisecond
+    if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
+        *last_execution_time = now;
+
+        // Nothing is due yet, which is the common case
+        if (table_count == 0 || table[0].token == INVALID_DEFERRED_TOKEN || ((int32_t)TIMER_DIFF_32(table[0].trigger_time, now)) > 0) {
+            return;
+        }
+
+        // Snapshot the executors due this tick. Each is invoked at most once, same as the linear backend when running
+        // behind schedule -- a repeating executor that is still due once requeued can't starve the others.
+        uint8_t pending[256 / 8] = {0};
+        size_t  count            = heap_count(table, table_count);
+        for (size_t i = 0; i < count; ++i) {
+            if (((int32_t)TIMER_DIFF_32(table[i].trigger_time, now)) <= 0) {
+                pending[table[i].token / 8] |= (1 << (table[i].token % 8));
+            }
+        }
+
+        while (true) {
+            // Fire the earliest pending executor that's still due; callbacks may have extended or cancelled some of them
+            int next = -1;
+            count    = heap_count(table, table_count);
+            for (int i = 0; i < count; ++i) {
+                deferred_token token = table[i].token;
+                if ((pending[token / 8] & (1 << (token % 8))) && ((int32_t)TIMER_DIFF_32(table[i].trigger_time, now)) <= 0 && (next < 0 || trigger_time_before(table[i].trigger_time, table[next].trigger_time))) {
+                    next = i;
+                }
+            }
+            if (next < 0) {
+                break;
+            }
+
+            deferred_token token = table[next].token;
+            pending[token / 8] &= ~(1 << (token % 8));
+
+            // Invoke the callback and work out if we should be requeued
+            uint32_t delay_ms = table[next].callback(table[next].trigger_time, table[next].cb_arg);
+
+            // The callback may have queued, extended or cancelled executors, so find this one again
+            count   = heap_count(table, table_count);
+            int idx = table[next].token == token ? next : heap_find(table, count, token);
+            if (idx < 0) {
+                continue;
+            }
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Relative to the previous trigger, same as the linear backend below
+                table[idx].trigger_time += delay_ms;
+                heap_fix(table, count, idx);
+            } else {
+                heap_remove(table, count, idx);
+            }
+        }
+    }
+}
+
+bool deferred_exec_advanced_next_trigger(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    if (!table || table_count == 0 || table[0].token == INVALID_DEFERRED_TOKEN) {
+        return false;
+    }
+    *trigger_time = table[0].trigger_time;
+    return true;
+}
+
+#else // DEFERRED_EXEC_MIN_HEAP
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //
@@ -103,10 +335,7 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
         deferred_executor_t *entry = &table[i];
         if (entry->token == token) {
             // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
+            clear_entry(entry);
             return true;
         }
     }
@@ -140,16 +369,30 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
                     entry->trigger_time += delay_ms;
                 } else {
                     // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
+                    clear_entry(entry);
                 }
             }
         }
     }
 }
 
+bool deferred_exec_advanced_next_trigger(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    bool found = false;
+    if (!table) {
+        return false;
+    }
+    for (int i = 0; i < table_count; ++i) {
+        deferred_executor_t *entry = &table[i];
+        if (entry->token != INVALID_DEFERRED_TOKEN && (!found || trigger_time_before(entry->trigger_time, *trigger_time))) {
+            *trigger_time = entry->trigger_time;
+            found         = true;
+        }
+    }
+    return found;
+}
+
+#endif // DEFERRED_EXEC_MIN_HEAP
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -169,3 +412,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+bool deferred_exec_next_trigger(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_trigger(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
@@ -65,6 +65,14 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Reports the earliest trigger time of any pending deferred execution, allowing the main loop to work out how long it may stay idle.
+ *
+ * @param trigger_time[out] the earliest trigger time -- equivalent time-space as timer_read32(); untouched if nothing is pending
+ * @return true if a deferred execution is pending, otherwise false
+ */
+bool deferred_exec_next_trigger(uint32_t *trigger_time);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
@@ -119,3 +127,13 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  * @param last_execution_time[in,out] the last execution time -- this will be checked first to determine if execution is needed, and updated if execution occurred
  */
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time);
+
+/**
+ * Reports the earliest trigger time of any pending deferred execution within a custom table.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @param trigger_time[out] the earliest trigger time -- equivalent time-space as timer_read32(); untouched if nothing is pending
+ * @return true if a deferred execution is pending, otherwise false
+ */
+bool deferred_exec_advanced_next_trigger(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time);
@@ -18,6 +18,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+// Loads the RAM copy of the keymap from EEPROM when DYNAMIC_KEYMAP_RAM_CACHE is defined.
+// Called by QMK core during keyboard_init(); anything that writes the keymap area of
+// EEPROM without going through the dynamic_keymap_set_*() functions must call it again.
+void     dynamic_keymap_init(void);
 uint8_t  dynamic_keymap_get_layer_count(void);
 void *   dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column);
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column);
@@ -68,6 +68,24 @@ static uint8_t thatCount;
 
 static uint8_t encoder_value[NUM_ENCODERS] = {0};
 
+#ifdef ENCODER_MAP_ENABLE
+/*
+    Detents are queued per encoder, and each queue is worked through from encoder_read() rather than tapped in-line:
+    press, release once ENCODER_MAP_KEY_DELAY has passed, and the next press once it has passed again. The delays cater
+    for Windows and its wonderful requirements, but no longer stall the main loop, so detents keep being counted while a
+    fast spin is delivered. Detents in opposite directions cancel out while still queued.
+*/
+typedef struct {
+    int8_t   queued;    // Detents not yet delivered, positive clockwise
+    bool     pressed;   // Whether the detent being delivered has been pressed but not released
+    bool     clockwise; // Direction of the detent being delivered
+    bool     waiting;   // Whether the last press or release is less than ENCODER_MAP_KEY_DELAY ago
+    uint16_t timer;     // When the last press or release was delivered
+} encoder_queue_t;
+
+static encoder_queue_t encoder_queues[NUM_ENCODERS];
+#endif // ENCODER_MAP_ENABLE
+
 __attribute__((weak)) void encoder_wait_pullup_charge(void) {
     wait_us(100);
 }
@@ -124,6 +142,9 @@ void encoder_init(void) {
     memset(encoder_value, 0, sizeof(encoder_value));
     memset(encoder_state, 0, sizeof(encoder_state));
     memset(encoder_pulses, 0, sizeof(encoder_pulses));
+#    ifdef ENCODER_MAP_ENABLE
+    memset(encoder_queues, 0, sizeof(encoder_queues));
+#    endif
     static const pin_t encoders_pad_a_left[] = ENCODERS_PAD_A;
     static const pin_t encoders_pad_b_left[] = ENCODERS_PAD_B;
     for (uint8_t i = 0; i < thisCount; i++) {
@@ -167,17 +188,40 @@ void encoder_init(void) {
 }
 
 #ifdef ENCODER_MAP_ENABLE
-static void encoder_exec_mapping(uint8_t index, bool clockwise) {
-    // The delays below cater for Windows and its wonderful requirements.
-    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
+static inline bool encoder_queue_ready(encoder_queue_t *queue) {
 #    if ENCODER_MAP_KEY_DELAY > 0
-    wait_ms(ENCODER_MAP_KEY_DELAY);
+    return !queue->waiting || timer_elapsed(queue->timer) >= ENCODER_MAP_KEY_DELAY;
+#    else
+    return true;
 #    endif // ENCODER_MAP_KEY_DELAY > 0
+}
 
-    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
-#    if ENCODER_MAP_KEY_DELAY > 0
-    wait_ms(ENCODER_MAP_KEY_DELAY);
-#    endif // ENCODER_MAP_KEY_DELAY > 0
+static void encoder_exec_queued(uint8_t index) {
+    encoder_queue_t *queue = &encoder_queues[index];
+    while (encoder_queue_ready(queue)) {
+        if (queue->pressed) {
+            queue->pressed = false;
+            action_exec(queue->clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
+        } else if (queue->queued != 0) {
+            queue->clockwise = queue->queued > 0;
+            queue->queued += queue->clockwise ? -1 : 1;
+            queue->pressed = true;
+            action_exec(queue->clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
+        } else {
+            queue->waiting = false;
+            return;
+        }
+        queue->waiting = true;
+        queue->timer   = timer_read();
+    }
+}
+
+static void encoder_exec_mapping(uint8_t index, bool clockwise) {
+    encoder_queue_t *queue = &encoder_queues[index];
+    if (clockwise ? queue->queued < INT8_MAX : queue->queued > INT8_MIN) {
+        queue->queued += clockwise ? 1 : -1;
+    }
+    encoder_exec_queued(index);
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -249,6 +293,11 @@ bool encoder_read(void) {
             changed |= encoder_update(i, encoder_state[i]);
         }
     }
+#ifdef ENCODER_MAP_ENABLE
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        encoder_exec_queued(i);
+    }
+#endif // ENCODER_MAP_ENABLE
     return changed;
 }
 
@@ -0,0 +1,130 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+
+// The encoder map is declared using NUM_ENCODERS, which util.h's ARRAY_SIZE can't compute in C++
+#define ARRAY_SIZE(array) (sizeof((array)) / sizeof((array)[0]))
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct event {
+    uint8_t  index;
+    bool     clockwise;
+    bool     pressed;
+    uint16_t time;
+};
+
+std::vector<event> events;
+
+extern "C" void action_exec(keyevent_t e) {
+    events.push_back({e.key.col, e.type == ENCODER_CW_EVENT, e.pressed, e.time});
+}
+
+bool setAndRead(pin_t pin, bool val) {
+    setPin(pin, val);
+    return encoder_read();
+}
+
+void detent(bool clockwise) {
+    pin_t first = clockwise ? 0 : 1, second = clockwise ? 1 : 0;
+    setAndRead(first, false);
+    setAndRead(second, false);
+    setAndRead(first, true);
+    setAndRead(second, true);
+}
+
+/* Runs encoder_read() once a millisecond for the given time, as the main loop would. */
+void run_for(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        advance_time(1);
+        encoder_read();
+    }
+}
+
+class EncoderMapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        events.clear();
+        set_time(1000);
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderMapTest, TestOneDetent) {
+    detent(true);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].index, 0);
+    EXPECT_EQ(events[0].clockwise, true);
+    EXPECT_EQ(events[0].pressed, true);
+
+    // The release waits its turn without blocking
+    run_for(ENCODER_MAP_KEY_DELAY - 1);
+    EXPECT_EQ(events.size(), 1);
+    run_for(1);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[1].clockwise, true);
+    EXPECT_EQ(events[1].pressed, false);
+    EXPECT_EQ(events[1].time - events[0].time, ENCODER_MAP_KEY_DELAY);
+
+    run_for(ENCODER_MAP_KEY_DELAY * 4);
+    EXPECT_EQ(events.size(), 2);
+}
+
+TEST_F(EncoderMapTest, TestBurstSpinIsQueued) {
+    // A fast spin, entirely within one millisecond
+    uint16_t start = timer_read();
+    for (int i = 0; i < 20; i++) {
+        detent(false);
+    }
+    EXPECT_EQ(timer_read(), start) << "Reading the encoder shouldn't have waited";
+    EXPECT_EQ(events.size(), 1);
+
+    run_for(ENCODER_MAP_KEY_DELAY * 2 * 20);
+    ASSERT_EQ(events.size(), 40) << "Every detent should have been delivered";
+    for (size_t i = 0; i < events.size(); i++) {
+        EXPECT_EQ(events[i].clockwise, false);
+        EXPECT_EQ(events[i].pressed, i % 2 == 0);
+        if (i > 0) {
+            EXPECT_GE(events[i].time - events[i - 1].time, ENCODER_MAP_KEY_DELAY) << "event " << i;
+        }
+    }
+}
+
+TEST_F(EncoderMapTest, TestDetentsDuringDeliveryAreQueued) {
+    detent(true);
+    run_for(ENCODER_MAP_KEY_DELAY / 2);
+    detent(true);
+    run_for(ENCODER_MAP_KEY_DELAY / 2);
+    detent(true);
+    run_for(ENCODER_MAP_KEY_DELAY * 2 * 3);
+    ASSERT_EQ(events.size(), 6);
+    for (size_t i = 0; i < events.size(); i++) {
+        EXPECT_EQ(events[i].clockwise, true);
+        EXPECT_EQ(events[i].pressed, i % 2 == 0);
+    }
+}
+
+TEST_F(EncoderMapTest, TestReversalCancelsQueuedDetents) {
+    for (int i = 0; i < 5; i++) {
+        detent(true);
+    }
+    for (int i = 0; i < 3; i++) {
+        detent(false);
+    }
+    run_for(ENCODER_MAP_KEY_DELAY * 2 * 8);
+
+    // The first detent was already pressed, and one of the remaining four is left after the reversal
+    ASSERT_EQ(events.size(), 4);
+    for (auto &e : events) {
+        EXPECT_EQ(e.clockwise, true);
+    }
+}
@@ -0,0 +1,141 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+
+// The encoder map is declared using NUM_ENCODERS, which util.h's ARRAY_SIZE can't compute in C++
+#define ARRAY_SIZE(array) (sizeof((array)) / sizeof((array)[0]))
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock_split.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct event {
+    uint8_t  index;
+    bool     clockwise;
+    bool     pressed;
+    uint16_t time;
+};
+
+std::vector<event> events;
+
+// Index of the first right hand encoder, after the three on the left
+constexpr uint8_t right_first = 3;
+
+bool isLeftHand;
+
+extern "C" bool is_keyboard_master(void) {
+    return isLeftHand;
+}
+
+extern "C" void action_exec(keyevent_t e) {
+    events.push_back({e.key.col, e.type == ENCODER_CW_EVENT, e.pressed, e.time});
+}
+
+bool setAndRead(pin_t pin, bool val) {
+    setPin(pin, val);
+    return encoder_read();
+}
+
+/* Runs encoder_read() once a millisecond for the given time, as the main loop would. */
+void run_for(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        advance_time(1);
+        encoder_read();
+    }
+}
+
+std::vector<event> events_for(uint8_t index) {
+    std::vector<event> result;
+    for (auto &e : events) {
+        if (e.index == index) {
+            result.push_back(e);
+        }
+    }
+    return result;
+}
+
+class EncoderMapSplitTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        events.clear();
+        for (int i = 0; i < 32; i++) {
+            pinIsInputHigh[i] = 0;
+            pins[i]           = 0;
+        }
+        set_time(1000);
+    }
+};
+
+TEST_F(EncoderMapSplitTest, TestBurstFromRightIsQueued) {
+    isLeftHand = true;
+    encoder_init();
+
+    // A burst of detents on both right hand encoders arrives in one transaction
+    uint8_t  slave_state[32] = {5, (uint8_t)-3};
+    uint16_t start           = timer_read();
+    encoder_update_raw(slave_state);
+    EXPECT_EQ(timer_read(), start) << "Receiving the encoder state shouldn't have waited";
+    EXPECT_EQ(events.size(), 2) << "Each encoder's first detent should be pressed straight away";
+
+    run_for(ENCODER_MAP_KEY_DELAY * 2 * 5);
+    auto first = events_for(right_first);
+    ASSERT_EQ(first.size(), 10);
+    for (size_t i = 0; i < first.size(); i++) {
+        EXPECT_EQ(first[i].clockwise, false);
+        EXPECT_EQ(first[i].pressed, i % 2 == 0);
+    }
+    auto second = events_for(right_first + 1);
+    ASSERT_EQ(second.size(), 6);
+    for (size_t i = 0; i < second.size(); i++) {
+        EXPECT_EQ(second[i].clockwise, true);
+        EXPECT_EQ(second[i].pressed, i % 2 == 0);
+    }
+
+    // The two encoders are delivered alongside each other
+    EXPECT_EQ(first[5].time, second[5].time);
+}
+
+TEST_F(EncoderMapSplitTest, TestLeftAndRightTogether) {
+    isLeftHand = true;
+    encoder_init();
+
+    setAndRead(0, false);
+    setAndRead(1, false);
+    setAndRead(0, true);
+    setAndRead(1, true);
+    uint8_t slave_state[32] = {1};
+    encoder_update_raw(slave_state);
+    run_for(ENCODER_MAP_KEY_DELAY * 2);
+
+    auto left  = events_for(0);
+    auto right = events_for(right_first);
+    ASSERT_EQ(left.size(), 2);
+    ASSERT_EQ(right.size(), 2);
+    EXPECT_EQ(left[0].clockwise, true);
+    EXPECT_EQ(right[0].clockwise, false);
+}
+
+TEST_F(EncoderMapSplitTest, TestSlaveOnlyCounts) {
+    isLeftHand = false;
+    encoder_init();
+
+    for (int i = 0; i < 3; i++) {
+        setAndRead(6, false);
+        setAndRead(7, false);
+        setAndRead(6, true);
+        setAndRead(7, true);
+    }
+    run_for(ENCODER_MAP_KEY_DELAY * 2 * 3);
+    EXPECT_EQ(events.size(), 0) << "Only the master should deliver encoder events";
+
+    uint8_t slave_state[32] = {0};
+    encoder_state_raw(slave_state);
+    EXPECT_EQ(slave_state[0], (uint8_t)-3);
+}
@@ -7,6 +7,25 @@ encoder_SRC := \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests.cpp \
 	$(QUANTUM_PATH)/encoder.c
 
+encoder_map_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MAP_ENABLE -DENCODER_MAP_KEY_DELAY=10 -DENCODER_MOCK_SINGLE
+encoder_map_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
+
+encoder_map_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_map_tests.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
+encoder_map_split_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MAP_ENABLE -DENCODER_MAP_KEY_DELAY=10 -DENCODER_MOCK_SPLIT
+encoder_map_split_INC := $(QUANTUM_PATH)/split_common
+encoder_map_split_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_left_gt_right.h
+
+encoder_map_split_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_map_tests_split.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
 encoder_split_left_eq_right_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SPLIT
 encoder_split_left_eq_right_INC := $(QUANTUM_PATH)/split_common
 encoder_split_left_eq_right_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_left_eq_right.h
@@ -87,6 +87,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DEFERRED_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -108,6 +111,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef LEADER_ENABLE
 #    include "leader.h"
 #endif
+#ifdef KEYBOARD_TASK_PROFILING
+#    include "basic_profiling.h"
+#    define PROFILED_TASK(task) PROFILE_TASK(task)
+#    define PROFILED_CALL(name, call) PROFILE_TASK_NAMED(name, call)
+#else
+#    define PROFILED_TASK(task) task()
+#    define PROFILED_CALL(name, call) call
+#endif
+
+#ifndef KEYBOARD_IDLE_SCAN_INTERVAL
+#    define KEYBOARD_IDLE_SCAN_INTERVAL 1
+#endif
+#ifndef MATRIX_IDLE_WAKEUP_INTERVAL
+#    define MATRIX_IDLE_WAKEUP_INTERVAL 100
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -339,6 +357,12 @@ __attribute__((weak)) void housekeeping_task_user(void) {}
  * Invokes hooks for executing code after QMK is done after each loop iteration.
  */
 void housekeeping_task(void) {
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_BACK_CACHE)
+    eeprom_driver_task();
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DEFERRED_CONSOLIDATION)
+    wear_leveling_task();
+#endif
     housekeeping_task_kb();
     housekeeping_task_user();
 }
@@ -388,6 +412,10 @@ void keyboard_init(void) {
 #endif
     matrix_init();
     quantum_init();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    // after quantum_init() so that any eeconfig reset has already happened
+    dynamic_keymap_init();
+#endif
 #if defined(CRC_ENABLE)
     crc_init();
 #endif
@@ -560,101 +588,115 @@ void quantum_task(void) {
 #endif
 
 #if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
-    music_task();
+    PROFILED_TASK(music_task);
+#endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+    PROFILED_TASK(send_string_task);
+#endif
+
+#ifdef OUTPUT_QUEUE_ENABLE
+    PROFILED_TASK(output_queue_task);
 #endif
 
 #ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
+    PROFILED_TASK(key_override_task);
 #endif
 
 #ifdef SEQUENCER_ENABLE
-    sequencer_task();
+    PROFILED_TASK(sequencer_task);
 #endif
 
 #ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
+    PROFILED_TASK(tap_dance_task);
 #endif
 
 #ifdef COMBO_ENABLE
-    combo_task();
+    PROFILED_TASK(combo_task);
 #endif
 
 #ifdef LEADER_ENABLE
-    leader_task();
+    PROFILED_TASK(leader_task);
 #endif
 
 #ifdef WPM_ENABLE
-    decay_wpm();
+    PROFILED_TASK(decay_wpm);
 #endif
 
 #ifdef HAPTIC_ENABLE
-    haptic_task();
+    PROFILED_TASK(haptic_task);
 #endif
 
 #ifdef DIP_SWITCH_ENABLE
-    dip_switch_read(false);
+    PROFILED_CALL("dip_switch_read", dip_switch_read(false));
 #endif
 
 #ifdef AUTO_SHIFT_ENABLE
-    autoshift_matrix_scan();
+    PROFILED_TASK(autoshift_matrix_scan);
 #endif
 
 #ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+    PROFILED_TASK(caps_word_task);
 #endif
 
 #ifdef SECURE_ENABLE
-    secure_task();
+    PROFILED_TASK(secure_task);
 #endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+    bool                         matrix_changed;
+    PROFILED_CALL("matrix_task", matrix_changed = matrix_task());
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
-    quantum_task();
+    PROFILED_TASK(quantum_task);
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
+    PROFILED_TASK(split_watchdog_task);
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    PROFILED_TASK(rgblight_task);
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    PROFILED_TASK(led_matrix_task);
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    PROFILED_TASK(rgb_matrix_task);
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
+    PROFILED_TASK(backlight_task);
 #    endif
 #endif
 
 #ifdef ENCODER_ENABLE
-    if (encoder_read()) {
+    bool encoder_changed;
+    PROFILED_CALL("encoder_read", encoder_changed = encoder_read());
+    if (encoder_changed) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    bool pointing_device_changed;
+    PROFILED_CALL("pointing_device_task", pointing_device_changed = pointing_device_task());
+    if (pointing_device_changed) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef OLED_ENABLE
-    oled_task();
+    PROFILED_TASK(oled_task);
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -662,7 +704,7 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
-    st7565_task();
+    PROFILED_TASK(st7565_task);
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
@@ -671,15 +713,15 @@ void keyboard_task(void) {
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
-    mousekey_task();
+    PROFILED_TASK(mousekey_task);
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
-    ps2_mouse_task();
+    PROFILED_TASK(ps2_mouse_task);
 #endif
 
 #ifdef MIDI_ENABLE
-    midi_task();
+    PROFILED_TASK(midi_task);
 #endif
 
 #ifdef VELOCIKEY_ENABLE
@@ -689,12 +731,145 @@ void keyboard_task(void) {
 #endif
 
 #ifdef JOYSTICK_ENABLE
-    joystick_task();
+    PROFILED_TASK(joystick_task);
 #endif
 
 #ifdef BLUETOOTH_ENABLE
-    bluetooth_task();
+    PROFILED_TASK(bluetooth_task);
+#endif
+
+    PROFILED_TASK(led_task);
+}
+
+/** \brief Works out the latest time keyboard_task() needs to run again.
+ *
+ * Tasks with timed work pending report their own deadline; anything which needs regular ticks keeps the deadline at the next
+ * millisecond, and anything which needs continuous polling keeps it at the current time. Otherwise the matrix is polled
+ * every KEYBOARD_IDLE_SCAN_INTERVAL milliseconds, or every MATRIX_IDLE_WAKEUP_INTERVAL milliseconds while it's armed to
+ * wake the MCU itself.
+ */
+uint32_t keyboard_next_deadline(void) {
+    const uint32_t now      = timer_read32();
+    uint32_t       deadline = now + KEYBOARD_IDLE_SCAN_INTERVAL;
+
+    // An armed matrix wakes the MCU itself, though the other half of a split keyboard can't, so that's still polled
+#if defined(MATRIX_IDLE_WAKEUP) && !defined(SPLIT_KEYBOARD)
+    if (matrix_wakeup_is_armed() && MATRIX_IDLE_WAKEUP_INTERVAL > KEYBOARD_IDLE_SCAN_INTERVAL) {
+        deadline = now + MATRIX_IDLE_WAKEUP_INTERVAL;
+    }
+#endif
+
+#if defined(PS2_MOUSE_ENABLE) || defined(MIDI_ENABLE) || defined(BLUETOOTH_ENABLE) || (defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)))
+    // Polled continuously, never idle
+    return now;
+#endif
+
+#if defined(AUDIO_ENABLE) || defined(SEQUENCER_ENABLE) || defined(HAPTIC_ENABLE) || defined(AUTO_SHIFT_ENABLE) || defined(ENCODER_ENABLE) || defined(POINTING_DEVICE_ENABLE) || defined(JOYSTICK_ENABLE) || defined(QUANTUM_PAINTER_ENABLE) || (defined(MOUSEKEY_ENABLE) && defined(MOUSEKEY_INERTIA))
+    // Timed internally, but doesn't report when it next needs to run
+    keyboard_update_deadline(&deadline, now + 1);
+#endif
+
+    // Held keys drive repeats, key overrides and the like
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            keyboard_update_deadline(&deadline, now + 1);
+            break;
+        }
+    }
+
+#ifndef NO_ACTION_TAPPING
+    action_tapping_next_deadline(&deadline);
+#endif
+#if !defined(NO_ACTION_ONESHOT) && (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+    // One-shot timeouts are checked on tick events
+    if (keymap_config.oneshot_enable) {
+#    ifdef SWAP_HANDS_ENABLE
+        keyboard_update_deadline(&deadline, now + 1);
+#    endif
+        if (get_oneshot_mods() || get_oneshot_layer_state()) {
+            keyboard_update_deadline(&deadline, now + 1);
+        }
+    }
+#endif
+#ifdef TAP_DANCE_ENABLE
+    tap_dance_next_deadline(&deadline);
+#endif
+#ifdef COMBO_ENABLE
+    combo_next_deadline(&deadline);
+#endif
+#ifdef LEADER_ENABLE
+    if (leader_sequence_active()) {
+        keyboard_update_deadline(&deadline, now + 1);
+    }
+#endif
+#ifdef CAPS_WORD_ENABLE
+    caps_word_next_deadline(&deadline);
+#endif
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_BACK_CACHE)
+    uint32_t flush_time;
+    if (eeprom_driver_next_flush(&flush_time)) {
+        keyboard_update_deadline(&deadline, flush_time);
+    }
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DEFERRED_CONSOLIDATION)
+    // Consolidation steps run from housekeeping_task()
+    if (wear_leveling_consolidation_pending()) {
+        keyboard_update_deadline(&deadline, now);
+    }
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+    uint32_t trigger_time;
+    if (deferred_exec_next_trigger(&trigger_time)) {
+        keyboard_update_deadline(&deadline, trigger_time);
+    }
+#endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+    uint32_t step_time;
+    if (send_string_async_next_step(&step_time)) {
+        keyboard_update_deadline(&deadline, step_time);
+    }
+#endif
+#ifdef OUTPUT_QUEUE_ENABLE
+    uint32_t send_time;
+    if (output_queue_next_send(&send_time)) {
+        keyboard_update_deadline(&deadline, send_time);
+    }
 #endif
 
-    led_task();
+#ifdef RGBLIGHT_ENABLE
+    if (rgblight_is_enabled()) {
+        keyboard_update_deadline(&deadline, now + 1);
+    }
+#endif
+#ifdef LED_MATRIX_ENABLE
+    if (led_matrix_is_enabled()) {
+        keyboard_update_deadline(&deadline, now + 1);
+    }
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    if (rgb_matrix_is_enabled()) {
+        keyboard_update_deadline(&deadline, now + 1);
+    }
+#endif
+#ifdef OLED_ENABLE
+    if (is_oled_on()) {
+        keyboard_update_deadline(&deadline, now + 1);
+    }
+#endif
+#ifdef ST7565_ENABLE
+    if (st7565_is_on()) {
+        keyboard_update_deadline(&deadline, now + 1);
+    }
+#endif
+#ifdef VELOCIKEY_ENABLE
+    if (velocikey_enabled()) {
+        keyboard_update_deadline(&deadline, now + 1);
+    }
+#endif
+
+    // Anything due has already had its chance to run during the current millisecond
+    if (((int32_t)TIMER_DIFF_32(deadline, now)) <= 0) {
+        deadline = now + 1;
+    }
+    return deadline;
 }
@@ -63,6 +63,13 @@ static inline bool IS_ENCODEREVENT(const keyevent_t event) {
     return event.type == ENCODER_CW_EVENT || event.type == ENCODER_CCW_EVENT;
 }
 
+/* Lowers the deadline to the given time if it is sooner, used by tasks reporting when they next need to run */
+static inline void keyboard_update_deadline(uint32_t *deadline, uint32_t time) {
+    if ((int32_t)(time - *deadline) < 0) {
+        *deadline = time;
+    }
+}
+
 /* Common keypos_t object factory */
 #define MAKE_KEYPOS(row_num, col_num) ((keypos_t){.row = (row_num), .col = (col_num)})
 
@@ -96,6 +103,8 @@ void keyboard_setup(void);
 void keyboard_init(void);
 /* it runs repeatedly in main loop */
 void keyboard_task(void);
+/* it reports the time keyboard_task() next needs to run, so the main loop may idle until then */
+uint32_t keyboard_next_deadline(void);
 /* it runs whenever code has to behave differently on a slave */
 bool is_keyboard_master(void);
 /* it runs whenever code has to behave differently on left vs right split */
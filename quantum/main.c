@@ -17,6 +17,7 @@
 #include "keyboard.h"
 
 void platform_setup(void);
+void platform_idle_until(uint32_t deadline);
 
 void protocol_setup(void);
 void protocol_pre_init(void);
@@ -43,6 +44,12 @@ void protocol_task(void) {
     protocol_post_task();
 }
 
+/** \brief Idles the MCU until the deadline has passed
+ *
+ * Platforms without a low-power wait fall back to busy-looping.
+ */
+__attribute__((weak)) void platform_idle_until(uint32_t deadline) {}
+
 /** \brief Main
  *
  * FIXME: Needs doc
@@ -72,5 +79,10 @@ int main(void) {
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef KEYBOARD_IDLE_SLEEP
+        // Idle until something next needs to run
+        platform_idle_until(keyboard_next_deadline());
+#endif
     }
 }
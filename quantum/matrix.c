@@ -103,6 +103,115 @@ static inline uint8_t readMatrixPin(pin_t pin) {
     }
 }
 
+#if defined(readGpioPort) && !defined(DIRECT_PINS) && defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+#    define MATRIX_PORT_READ
+
+#    ifndef MATRIX_PORT_READ_MAX_PORTS
+#        define MATRIX_PORT_READ_MAX_PORTS 4
+#    endif
+
+#    if (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_PORT_READ_INPUTS MATRIX_COLS
+typedef matrix_row_t matrix_inputs_t;
+#    elif ROWS_PER_HAND <= 8
+#        define MATRIX_PORT_READ_INPUTS ROWS_PER_HAND
+typedef uint8_t matrix_inputs_t;
+#    elif ROWS_PER_HAND <= 16
+#        define MATRIX_PORT_READ_INPUTS ROWS_PER_HAND
+typedef uint16_t matrix_inputs_t;
+#    elif ROWS_PER_HAND <= 32
+#        define MATRIX_PORT_READ_INPUTS ROWS_PER_HAND
+typedef uint32_t matrix_inputs_t;
+#    else
+#        undef MATRIX_PORT_READ
+#    endif
+#endif
+
+#ifdef MATRIX_PORT_READ
+/*
+    Rather than reading the input pins one at a time, each GPIO port they're on is read once and the pins' bits moved
+    into place. Pins on the same port whose pad is the same distance from their input index form a run, which takes a
+    single mask and shift, so columns wired in order to one port cost one read and one shift in total. The plan is
+    worked out by matrix_init_pins(); if the pins are spread over more than MATRIX_PORT_READ_MAX_PORTS ports, or the
+    pins were set up by an override, it's left empty and the pins are read one at a time.
+*/
+typedef struct {
+    uint8_t          port;  // Index into port_read.ports
+    int8_t           shift; // Input index minus pad, shifting left when positive
+    gpio_port_data_t mask;  // Pads in this run
+} matrix_port_run_t;
+
+static struct {
+    uint8_t           port_count; // Zero when reading pin by pin
+    uint8_t           run_count;
+    gpio_port_t       ports[MATRIX_PORT_READ_MAX_PORTS];
+    matrix_port_run_t runs[MATRIX_PORT_READ_INPUTS];
+} port_read;
+
+static void matrix_port_read_plan(const pin_t pins[], uint8_t count) {
+    port_read.port_count = 0;
+    port_read.run_count  = 0;
+
+    uint8_t port_count = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        pin_t pin = pins[i];
+        if (pin == NO_PIN) {
+            continue; // never pressed, so there's nothing to read
+        }
+
+        gpio_port_t port = getPinPort(pin);
+        uint8_t     port_index;
+        for (port_index = 0; port_index < port_count; port_index++) {
+            if (port_read.ports[port_index] == port) {
+                break;
+            }
+        }
+        if (port_index == port_count) {
+            if (port_count == MATRIX_PORT_READ_MAX_PORTS) {
+                port_read.run_count = 0;
+                return; // too spread out, read pin by pin
+            }
+            port_read.ports[port_count++] = port;
+        }
+
+        int8_t  shift = (int8_t)i - (int8_t)getPinPad(pin);
+        uint8_t run;
+        for (run = 0; run < port_read.run_count; run++) {
+            if (port_read.runs[run].port == port_index && port_read.runs[run].shift == shift) {
+                break;
+            }
+        }
+        if (run == port_read.run_count) {
+            port_read.runs[run] = (matrix_port_run_t){.port = port_index, .shift = shift, .mask = 0};
+            port_read.run_count++;
+        }
+        port_read.runs[run].mask |= (gpio_port_data_t)1 << getPinPad(pin);
+    }
+
+    port_read.port_count = port_count;
+}
+
+/* Returns the planned inputs which are pressed, one bit per input. */
+static matrix_inputs_t matrix_port_read_inputs(void) {
+    gpio_port_data_t data[MATRIX_PORT_READ_MAX_PORTS];
+    for (uint8_t i = 0; i < port_read.port_count; i++) {
+#    if MATRIX_INPUT_PRESSED_STATE == 0
+        data[i] = ~readGpioPort(port_read.ports[i]);
+#    else
+        data[i] = readGpioPort(port_read.ports[i]);
+#    endif
+    }
+
+    matrix_inputs_t pressed = 0;
+    for (uint8_t i = 0; i < port_read.run_count; i++) {
+        const matrix_port_run_t *run  = &port_read.runs[i];
+        gpio_port_data_t         bits = data[run->port] & run->mask;
+        pressed |= run->shift >= 0 ? (matrix_inputs_t)bits << run->shift : (matrix_inputs_t)(bits >> -run->shift);
+    }
+    return pressed;
+}
+#endif // MATRIX_PORT_READ
+
 // matrix code
 
 #ifdef DIRECT_PINS
@@ -169,6 +278,9 @@ __attribute__((weak)) void matrix_init_pins(void) {
             setPinInputHigh_atomic(col_pins[x]);
         }
     }
+#            ifdef MATRIX_PORT_READ
+    matrix_port_read_plan(col_pins, MATRIX_COLS);
+#            endif
 }
 
 __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
@@ -180,13 +292,21 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
-    // For each col...
-    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
-    for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
-        uint8_t pin_state = readMatrixPin(col_pins[col_index]);
-
-        // Populate the matrix row with the state of the col pin
-        current_row_value |= pin_state ? 0 : row_shifter;
+#            ifdef MATRIX_PORT_READ
+    if (port_read.port_count != 0) {
+        // Read all the cols at once, port by port
+        current_row_value = matrix_port_read_inputs();
+    } else
+#            endif
+    {
+        // For each col...
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
+            uint8_t pin_state = readMatrixPin(col_pins[col_index]);
+
+            // Populate the matrix row with the state of the col pin
+            current_row_value |= pin_state ? 0 : row_shifter;
+        }
     }
 
     // Unselect row
@@ -232,6 +352,9 @@ __attribute__((weak)) void matrix_init_pins(void) {
             setPinInputHigh_atomic(row_pins[x]);
         }
     }
+#            ifdef MATRIX_PORT_READ
+    matrix_port_read_plan(row_pins, ROWS_PER_HAND);
+#            endif
 }
 
 __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[], uint8_t current_col, matrix_row_t row_shifter) {
@@ -243,10 +366,20 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_PORT_READ
+    // Read all the rows at once, port by port
+    matrix_inputs_t rows_pressed = port_read.port_count != 0 ? matrix_port_read_inputs() : 0;
+#            endif
+
     // For each row...
     for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
         // Check row pin state
-        if (readMatrixPin(row_pins[row_index]) == 0) {
+#            ifdef MATRIX_PORT_READ
+        bool pressed = port_read.port_count != 0 ? (rows_pressed >> row_index) & 1 : readMatrixPin(row_pins[row_index]) == 0;
+#            else
+        bool pressed = readMatrixPin(row_pins[row_index]) == 0;
+#            endif
+        if (pressed) {
             // Pin LO, set col bit
             current_matrix[row_index] |= row_shifter;
             key_pressed = true;
@@ -269,6 +402,143 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_IDLE_WAKEUP
+#    if defined(DIRECT_PINS) || !defined(MATRIX_ROW_PINS) || !defined(MATRIX_COL_PINS)
+#        error MATRIX_IDLE_WAKEUP requires a diode matrix with MATRIX_ROW_PINS and MATRIX_COL_PINS
+#    endif
+
+#    ifndef MATRIX_IDLE_WAKEUP_SCANS
+#        define MATRIX_IDLE_WAKEUP_SCANS 20
+#    endif
+
+#    if (DIODE_DIRECTION == COL2ROW)
+#        define WAKEUP_INPUT_PINS col_pins
+#        define WAKEUP_INPUT_COUNT MATRIX_COLS
+#        define WAKEUP_OUTPUT_COUNT ROWS_PER_HAND
+#        define wakeup_select_output select_row
+#        define wakeup_unselect_outputs unselect_rows
+#    else
+#        define WAKEUP_INPUT_PINS row_pins
+#        define WAKEUP_INPUT_COUNT ROWS_PER_HAND
+#        define WAKEUP_OUTPUT_COUNT MATRIX_COLS
+#        define wakeup_select_output select_col
+#        define wakeup_unselect_outputs unselect_cols
+#    endif
+
+// Provided by platforms which can interrupt on an input pin changing, the callback being run from the interrupt
+__attribute__((weak)) bool platform_pin_wakeup_arm(pin_t pin, void (*callback)(void)) {
+    return false;
+}
+__attribute__((weak)) void platform_pin_wakeup_disarm(pin_t pin) {}
+
+/*
+    Once the matrix has been quiet for MATRIX_IDLE_WAKEUP_SCANS scans, every output line is selected at once and the
+    inputs armed to interrupt on a change, so a key going down is caught without scanning. Scans then skip reading the
+    matrix until the interrupt arrives, when it's disarmed and read in full straight away. If the platform can't arm
+    one of the inputs, the matrix carries on being scanned.
+*/
+static enum {
+    WAKEUP_SCANNING,
+    WAKEUP_ARMED,
+    WAKEUP_UNAVAILABLE,
+} wakeup_state;
+
+static uint8_t               idle_scans;   // Consecutive scans with every key up
+static bool                  woken;        // The matrix is being read following a wakeup
+static volatile bool         wakeup_pending;
+static volatile uint32_t     wakeup_time;  // When the waking edge arrived
+static matrix_wakeup_stats_t wakeup_stats;
+
+static void matrix_wakeup_isr(void) {
+    if (!wakeup_pending) {
+        wakeup_time    = timer_read32();
+        wakeup_pending = true;
+    }
+}
+
+static void matrix_wakeup_disarm(uint8_t armed_count) {
+    for (uint8_t x = 0; x < armed_count; x++) {
+        if (WAKEUP_INPUT_PINS[x] != NO_PIN) {
+            platform_pin_wakeup_disarm(WAKEUP_INPUT_PINS[x]);
+        }
+    }
+    wakeup_unselect_outputs();
+}
+
+static void matrix_wakeup_arm(void) {
+    wakeup_pending = false;
+    for (uint8_t x = 0; x < WAKEUP_OUTPUT_COUNT; x++) {
+        wakeup_select_output(x);
+    }
+    for (uint8_t x = 0; x < WAKEUP_INPUT_COUNT; x++) {
+        pin_t pin = WAKEUP_INPUT_PINS[x];
+        if (pin != NO_PIN && !platform_pin_wakeup_arm(pin, matrix_wakeup_isr)) {
+            matrix_wakeup_disarm(x);
+            wakeup_state = WAKEUP_UNAVAILABLE;
+            return;
+        }
+    }
+    wakeup_state = WAKEUP_ARMED;
+
+    // A key which went down before its input was armed won't raise an interrupt
+    matrix_output_select_delay();
+    for (uint8_t x = 0; x < WAKEUP_INPUT_COUNT; x++) {
+        if (readMatrixPin(WAKEUP_INPUT_PINS[x]) == 0) {
+            matrix_wakeup_isr();
+            break;
+        }
+    }
+}
+
+/* Returns whether the matrix needs to be read, disarming it if it's been woken. */
+static bool matrix_wakeup_poll(void) {
+    if (wakeup_state != WAKEUP_ARMED) {
+        return true;
+    }
+    if (!wakeup_pending) {
+        return false;
+    }
+
+    matrix_wakeup_disarm(WAKEUP_INPUT_COUNT);
+    matrix_output_unselect_delay(0, true); // wait for the inputs to recover from every output being selected
+    wakeup_state = WAKEUP_SCANNING;
+    woken        = true;
+    wakeup_stats.wakeups++;
+    return true;
+}
+
+static void matrix_wakeup_update(const matrix_row_t current_matrix[], const matrix_row_t debounced_matrix[]) {
+    bool raw_pressed = false, pressed = false;
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        raw_pressed |= current_matrix[row] != 0;
+        pressed |= debounced_matrix[row] != 0;
+    }
+
+    if (woken && raw_pressed) {
+        wakeup_stats.last_latency = timer_elapsed32(wakeup_time);
+        if (wakeup_stats.last_latency > wakeup_stats.max_latency) {
+            wakeup_stats.max_latency = wakeup_stats.last_latency;
+        }
+    }
+    woken = false;
+
+    if (raw_pressed || pressed) {
+        idle_scans = 0;
+    } else if (wakeup_state == WAKEUP_SCANNING && ++idle_scans >= MATRIX_IDLE_WAKEUP_SCANS) {
+        idle_scans = 0;
+        matrix_wakeup_arm();
+    }
+}
+
+bool matrix_wakeup_is_armed(void) {
+    return wakeup_state == WAKEUP_ARMED;
+}
+
+const matrix_wakeup_stats_t *matrix_wakeup_get_stats(void) {
+    return &wakeup_stats;
+}
+#endif // MATRIX_IDLE_WAKEUP
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -299,6 +569,13 @@ void matrix_init(void) {
     thatHand = ROWS_PER_HAND - thisHand;
 #endif
 
+#ifdef MATRIX_IDLE_WAKEUP
+    wakeup_state = WAKEUP_SCANNING;
+    idle_scans   = 0;
+    woken        = false;
+    memset(&wakeup_stats, 0, sizeof(wakeup_stats));
+#endif
+
     // initialize key pins
     matrix_init_pins();
 
@@ -319,9 +596,7 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
-uint8_t matrix_scan(void) {
-    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
-
+static void matrix_read(matrix_row_t curr_matrix[]) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
@@ -334,6 +609,19 @@ uint8_t matrix_scan(void) {
         matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
     }
 #endif
+}
+
+uint8_t matrix_scan(void) {
+    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
+
+#ifdef MATRIX_IDLE_WAKEUP
+    // While armed, every key is up until an interrupt says otherwise
+    if (matrix_wakeup_poll()) {
+        matrix_read(curr_matrix);
+    }
+#else
+    matrix_read(curr_matrix);
+#endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
@@ -343,6 +631,14 @@ uint8_t matrix_scan(void) {
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
+#endif
+
+#ifdef MATRIX_IDLE_WAKEUP
+#    ifdef SPLIT_KEYBOARD
+    matrix_wakeup_update(curr_matrix, matrix + thisHand);
+#    else
+    matrix_wakeup_update(curr_matrix, matrix);
+#    endif
 #endif
     return (uint8_t)changed;
 }
@@ -81,6 +81,19 @@ void matrix_slave_scan_kb(void);
 void matrix_slave_scan_user(void);
 #endif
 
+/* whether the matrix is idle, waiting on a pin interrupt rather than being scanned */
+bool matrix_wakeup_is_armed(void);
+
+#ifdef MATRIX_IDLE_WAKEUP
+typedef struct {
+    uint32_t wakeups;      // times a key woke the matrix from idle
+    uint32_t last_latency; // milliseconds from the waking edge to the scan which read the key
+    uint32_t max_latency;
+} matrix_wakeup_stats_t;
+
+const matrix_wakeup_stats_t *matrix_wakeup_get_stats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,144 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "output_queue.h"
+#include "host.h"
+#include "timer.h"
+
+/*
+    Taps with a delay used to block in wait_ms() between the press and the release, during which the matrix wasn't
+    scanned. Instead, a pause is queued, and every report sent until it has elapsed is queued behind it. The keyboard
+    state itself moves on straight away -- only what the host sees is held back, so the host receives the same reports in
+    the same order, just without stalling the rest of the firmware.
+*/
+
+enum {
+    OUTPUT_QUEUE_WAIT,
+    OUTPUT_QUEUE_KEYBOARD,
+    OUTPUT_QUEUE_MOUSE,
+    OUTPUT_QUEUE_SYSTEM,
+    OUTPUT_QUEUE_CONSUMER,
+};
+
+typedef struct {
+    uint8_t type;
+    union {
+        report_keyboard_t keyboard;
+        report_mouse_t    mouse;
+        uint16_t          usage;
+        uint16_t          wait;
+    };
+} output_queue_entry_t;
+
+static output_queue_entry_t queue[OUTPUT_QUEUE_SIZE];
+static uint8_t              queue_head  = 0;
+static uint8_t              queue_count = 0;
+static uint32_t             wait_start  = 0; // When the entry at the head of the queue became the head
+static bool                 sending     = false;
+
+static output_queue_entry_t *output_queue_push(uint8_t type) {
+    if (queue_count == OUTPUT_QUEUE_SIZE) {
+        output_queue_flush();
+    }
+    if (queue_count == 0) {
+        wait_start = timer_read32();
+    }
+    output_queue_entry_t *entry = &queue[(queue_head + queue_count++) % OUTPUT_QUEUE_SIZE];
+    entry->type                 = type;
+    return entry;
+}
+
+/* Whether a report should be queued, rather than sent now. Reports are only held back behind a pause, and once the queue
+ * is full, it's emptied the old way, by waiting. */
+static bool output_queue_holding(void) {
+    if (sending) {
+        return false;
+    }
+    if (queue_count == OUTPUT_QUEUE_SIZE) {
+        output_queue_flush();
+    }
+    return queue_count > 0;
+}
+
+void output_queue_wait_ms(uint16_t ms) {
+    if (ms == 0) {
+        return;
+    }
+    output_queue_push(OUTPUT_QUEUE_WAIT)->wait = ms;
+}
+
+bool output_queue_keyboard(report_keyboard_t *report) {
+    if (!output_queue_holding()) {
+        return false;
+    }
+    output_queue_entry_t *entry = output_queue_push(OUTPUT_QUEUE_KEYBOARD);
+    entry->keyboard             = *report;
+    return true;
+}
+
+bool output_queue_mouse(report_mouse_t *report) {
+    if (!output_queue_holding()) {
+        return false;
+    }
+    output_queue_entry_t *entry = output_queue_push(OUTPUT_QUEUE_MOUSE);
+    entry->mouse                = *report;
+    return true;
+}
+
+bool output_queue_extra(uint8_t report_id, uint16_t usage) {
+    if (!output_queue_holding()) {
+        return false;
+    }
+    output_queue_push(report_id == REPORT_ID_SYSTEM ? OUTPUT_QUEUE_SYSTEM : OUTPUT_QUEUE_CONSUMER)->usage = usage;
+    return true;
+}
+
+void output_queue_task(void) {
+    sending = true;
+    while (queue_count > 0) {
+        output_queue_entry_t *entry = &queue[queue_head];
+        switch (entry->type) {
+            case OUTPUT_QUEUE_WAIT:
+                if (timer_elapsed32(wait_start) < entry->wait) {
+                    sending = false;
+                    return;
+                }
+                break;
+            case OUTPUT_QUEUE_KEYBOARD:
+                host_keyboard_send(&entry->keyboard);
+                break;
+            case OUTPUT_QUEUE_MOUSE:
+                host_mouse_send(&entry->mouse);
+                break;
+            case OUTPUT_QUEUE_SYSTEM:
+                host_system_send(entry->usage);
+                break;
+            case OUTPUT_QUEUE_CONSUMER:
+                host_consumer_send(entry->usage);
+                break;
+        }
+        queue_head = (queue_head + 1) % OUTPUT_QUEUE_SIZE;
+        queue_count--;
+        wait_start = timer_read32();
+    }
+    sending = false;
+}
+
+void output_queue_flush(void) {
+    output_queue_task();
+    while (queue_count > 0) {
+        wait_ms(1);
+        output_queue_task();
+    }
+}
+
+bool output_queue_next_send(uint32_t *send_time) {
+    if (queue_count == 0) {
+        return false;
+    }
+    *send_time = wait_start;
+    if (queue[queue_head].type == OUTPUT_QUEUE_WAIT) {
+        *send_time += queue[queue_head].wait;
+    }
+    return true;
+}
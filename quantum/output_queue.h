@@ -0,0 +1,70 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "report.h"
+#include "wait.h"
+
+#ifdef OUTPUT_QUEUE_ENABLE
+
+#    ifndef OUTPUT_QUEUE_SIZE
+#        define OUTPUT_QUEUE_SIZE 16
+#    endif
+
+/**
+ * Pauses output for the given number of milliseconds without blocking. Keyboard, mouse, system and consumer reports sent
+ * after this are held back and sent from output_queue_task() once the pause has elapsed, in the order they were sent.
+ *
+ * @param ms[in] the number of milliseconds to pause for
+ */
+void output_queue_wait_ms(uint16_t ms);
+
+/**
+ * Holds back a keyboard report if output is paused.
+ *
+ * @param report[in] the report to send
+ * @return true if the report was queued, false if it should be sent now
+ */
+bool output_queue_keyboard(report_keyboard_t *report);
+
+/**
+ * Holds back a mouse report if output is paused.
+ *
+ * @param report[in] the report to send
+ * @return true if the report was queued, false if it should be sent now
+ */
+bool output_queue_mouse(report_mouse_t *report);
+
+/**
+ * Holds back a system or consumer usage if output is paused.
+ *
+ * @param report_id[in] REPORT_ID_SYSTEM or REPORT_ID_CONSUMER
+ * @param usage[in] the usage to send
+ * @return true if the usage was queued, false if it should be sent now
+ */
+bool output_queue_extra(uint8_t report_id, uint16_t usage);
+
+/**
+ * Blocks until everything queued has been sent.
+ */
+void output_queue_flush(void);
+
+/**
+ * Sends any queued reports whose pause has elapsed.
+ */
+void output_queue_task(void);
+
+/**
+ * Reports when output_queue_task() next has something to send.
+ *
+ * @param send_time[out] the time the next queued report is due, in the time-space of timer_read32()
+ * @return true if anything is queued
+ */
+bool output_queue_next_send(uint32_t *send_time);
+
+#else
+#    define output_queue_wait_ms(ms) wait_ms(ms)
+#endif
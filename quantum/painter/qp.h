@@ -56,6 +56,23 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+/**
+ * @def This controls the number of bytes of RAM set aside for caching decoded glyphs, in the display's native pixel
+ *      format. Redrawing text using glyphs already in the cache skips reading and decompressing the font data. Least
+ *      recently used glyphs are evicted to make room. Defaults to 0, which disables the cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 0
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of glyphs held in the glyph cache, regardless of how much of
+ *      \ref QUANTUM_PAINTER_GLYPH_CACHE_SIZE they use.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 32
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -72,6 +89,15 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#if defined(QUANTUM_PAINTER_SPI_ASYNC) && !defined(QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER)
+/**
+ * @def Splits the pixel data buffer in two, so that the next block of pixel data can be prepared in one half whilst the
+ *      other half is still being transmitted. Required by \ref QUANTUM_PAINTER_SPI_ASYNC, which transmits pixel data in
+ *      the background.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -453,6 +479,29 @@ int16_t qp_drawtext(painter_device_t device, uint16_t x, uint16_t y, painter_fon
  */
 int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_font_handle_t font, const char *str, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+/**
+ * @typedef Statistics gathered by the glyph cache, queried by \ref qp_glyph_cache_get_stats.
+ */
+typedef struct qp_glyph_cache_stats_t {
+    uint32_t hits;      ///< Glyphs drawn from the cache
+    uint32_t misses;    ///< Glyphs decoded from the font
+    uint32_t evictions; ///< Glyphs removed from the cache to make room for others
+} qp_glyph_cache_stats_t;
+
+/**
+ * Retrieves the glyph cache statistics gathered since startup, or since the last call to \ref qp_glyph_cache_clear.
+ *
+ * @param stats[out] the statistics
+ */
+void qp_glyph_cache_get_stats(qp_glyph_cache_stats_t *stats);
+
+/**
+ * Empties the glyph cache and resets its statistics.
+ */
+void qp_glyph_cache_clear(void);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter Drivers
 
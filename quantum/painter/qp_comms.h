@@ -16,6 +16,9 @@ bool     qp_comms_start(painter_device_t device);
 void     qp_comms_stop(painter_device_t device);
 uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
 
+// Sends data which may still be being transmitted on return -- it must not be modified until the next comms operation
+uint32_t qp_comms_send_async(painter_device_t device, const void* data, uint32_t byte_count);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
@@ -9,9 +9,27 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter utility functions
 
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+// Size of the half of the pixdata buffer currently being written.
+#    define QP_INTERNAL_PIXDATA_BUFFER_SIZE ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE) / 2)
+
+// Global variable used for native pixel data streaming, pointing at the half of the buffer currently being written.
+extern uint8_t *qp_internal_global_pixdata_buffer;
+
+// Swaps to the other half of the pixdata buffer. Needs to be invoked after handing the current half to the driver's pixdata
+// function if the buffer is to be rewritten before the comms are stopped, as the transfer may still be in progress.
+void qp_internal_swap_pixdata_buffer(void);
+#else
+#    define QP_INTERNAL_PIXDATA_BUFFER_SIZE (QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE)
+
 // Global variable used for native pixel data streaming.
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
 
+#    define qp_internal_swap_pixdata_buffer() \
+        do {                                  \
+        } while (0)
+#endif
+
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
 
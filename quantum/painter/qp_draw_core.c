@@ -8,6 +8,9 @@
 #include "qgf.h"
 
 _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE % 16) == 0, "QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE needs to be a non-zero multiple of 16");
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+_Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE % 32) == 0, "QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE needs to be a multiple of 32 when double-buffered");
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Global variables
@@ -20,7 +23,12 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //
 
 // Buffer used for transmitting native pixel data to the downstream device.
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+__attribute__((__aligned__(4))) static uint8_t pixdata_buffers[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t *                                      qp_internal_global_pixdata_buffer = pixdata_buffers;
+#else
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -38,9 +46,15 @@ __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table
 
 uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device) {
     painter_driver_t *driver = (painter_driver_t *)device;
-    return ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
+    return ((QP_INTERNAL_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
 }
 
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+void qp_internal_swap_pixdata_buffer(void) {
+    qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == pixdata_buffers) ? &pixdata_buffers[QP_INTERNAL_PIXDATA_BUFFER_SIZE] : pixdata_buffers;
+}
+#endif
+
 // qp_setpixel internal implementation, but accepts a buffer with pre-converted native pixel. Only the first pixel is used.
 bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y) {
     painter_driver_t *driver = (painter_driver_t *)device;
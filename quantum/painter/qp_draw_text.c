@@ -35,6 +35,124 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+_Static_assert(QUANTUM_PAINTER_GLYPH_CACHE_SIZE <= UINT16_MAX, "QUANTUM_PAINTER_GLYPH_CACHE_SIZE must be no more than 65535 bytes");
+
+typedef struct qp_glyph_cache_entry_t {
+    const qff_font_handle_t *font; // NULL if the entry is unused
+    painter_device_t         device;
+    uint32_t                 code_point;
+    qp_pixel_t               fg_hsv888;
+    qp_pixel_t               bg_hsv888;
+    uint16_t                 offset; // Start of the glyph's native pixel data within glyph_cache_data
+    uint16_t                 length; // Bytes of glyph_cache_data used by the glyph, rounded up to keep offsets aligned
+    uint16_t                 last_used;
+    uint8_t                  width;
+} qp_glyph_cache_entry_t;
+
+// Native pixel data of every cached glyph, packed from the start of the buffer
+static uint8_t                glyph_cache_data[QUANTUM_PAINTER_GLYPH_CACHE_SIZE] __attribute__((aligned(4)));
+static uint16_t               glyph_cache_data_used                            = 0;
+static qp_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES] = {0};
+static uint16_t               glyph_cache_tick                                 = 0;
+static qp_glyph_cache_stats_t glyph_cache_stats                                = {0};
+
+static inline bool qp_glyph_cache_colors_match(qp_pixel_t a, qp_pixel_t b) {
+    return a.hsv888.h == b.hsv888.h && a.hsv888.s == b.hsv888.s && a.hsv888.v == b.hsv888.v;
+}
+
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(const qff_font_handle_t *font, painter_device_t device, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->font == font && entry->code_point == code_point && entry->device == device && qp_glyph_cache_colors_match(entry->fg_hsv888, fg_hsv888) && qp_glyph_cache_colors_match(entry->bg_hsv888, bg_hsv888)) {
+            entry->last_used = ++glyph_cache_tick;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Frees up an entry, moving the data of the glyphs stored after it down to close the gap
+static void qp_glyph_cache_remove(qp_glyph_cache_entry_t *entry) {
+    uint16_t end = entry->offset + entry->length;
+    memmove(&glyph_cache_data[entry->offset], &glyph_cache_data[end], glyph_cache_data_used - end);
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache[i].font && glyph_cache[i].offset > entry->offset) {
+            glyph_cache[i].offset -= entry->length;
+        }
+    }
+    glyph_cache_data_used -= entry->length;
+    entry->font = NULL;
+}
+
+// Allocates an entry with room for the specified number of bytes, evicting the least recently used glyphs as required
+static qp_glyph_cache_entry_t *qp_glyph_cache_alloc(uint32_t byte_count) {
+    uint32_t length = (byte_count + 3) & ~3u;
+    if (length > QUANTUM_PAINTER_GLYPH_CACHE_SIZE) {
+        return NULL;
+    }
+
+    while (true) {
+        qp_glyph_cache_entry_t *unused = NULL;
+        qp_glyph_cache_entry_t *oldest = NULL;
+        for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+            qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+            if (!entry->font) {
+                unused = entry;
+            } else if (!oldest || (uint16_t)(glyph_cache_tick - entry->last_used) > (uint16_t)(glyph_cache_tick - oldest->last_used)) {
+                oldest = entry;
+            }
+        }
+
+        if (unused && glyph_cache_data_used + length <= QUANTUM_PAINTER_GLYPH_CACHE_SIZE) {
+            unused->offset = glyph_cache_data_used;
+            unused->length = length;
+            glyph_cache_data_used += length;
+            return unused;
+        }
+
+        qp_glyph_cache_remove(oldest);
+        ++glyph_cache_stats.evictions;
+    }
+}
+
+// Removes all glyphs belonging to the specified font
+static void qp_glyph_cache_invalidate_font(const qff_font_handle_t *font) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache[i].font == font) {
+            qp_glyph_cache_remove(&glyph_cache[i]);
+        }
+    }
+}
+
+void qp_glyph_cache_get_stats(qp_glyph_cache_stats_t *stats) {
+    *stats = glyph_cache_stats;
+}
+
+void qp_glyph_cache_clear(void) {
+    memset(glyph_cache, 0, sizeof(glyph_cache));
+    memset(&glyph_cache_stats, 0, sizeof(glyph_cache_stats));
+    glyph_cache_data_used = 0;
+    glyph_cache_tick      = 0;
+}
+
+// Pixel output callback that decodes a glyph into its glyph cache entry, rather than the pixdata buffer
+typedef struct qp_glyph_cache_output_state_t {
+    painter_device_t device;
+    uint8_t *        target;
+    uint32_t         pixel_write_pos;
+} qp_glyph_cache_output_state_t;
+
+static bool qp_glyph_cache_pixel_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state  = (qp_glyph_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->target, palette, state->pixel_write_pos++, 1, &index);
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -150,6 +268,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Drop any of its glyphs, as the handle may be reused for a different font
+    qp_glyph_cache_invalidate_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -160,7 +283,7 @@ bool qp_close_font(painter_font_handle_t font) {
 // Helpers
 
 // Callback to be invoked for each codepoint detected in the UTF8 input string
-typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
+typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg);
 
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
@@ -204,7 +327,6 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
         // Convert the palette to native format
         if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
             qp_dprintf("qp_drawtext_recolor: fail (could not convert pixels to native)\n");
-            qp_comms_stop(device);
             return false;
         }
     }
@@ -301,13 +423,7 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
-        uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
-            qp_dprintf("Failed to prepare glyph for rendering.\n");
-            return false;
-        }
-
-        if (!handler(qff_font, code_point, width, qff_font->base.line_height, cb_arg)) {
+        if (!handler(qff_font, code_point, cb_arg)) {
             qp_dprintf("Failed to execute glyph handler.\n");
             return false;
         }
@@ -324,9 +440,15 @@ typedef struct code_point_iter_calcwidth_state_t {
 } code_point_iter_calcwidth_state_t;
 
 // Codepoint handler callback: width calc
-static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
 
+    uint8_t width;
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
+
     // Increment the overall width by this glyph's width
     state->width += width;
 
@@ -341,19 +463,103 @@ typedef struct code_point_iter_drawglyph_state_t {
     painter_device_t                  device;
     int16_t                           xpos;
     int16_t                           ypos;
+    qp_pixel_t                        fg_hsv888;
+    qp_pixel_t                        bg_hsv888;
+    bool                              palette_ready;
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
 } code_point_iter_drawglyph_state_t;
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+// Sends a cached glyph's native pixel data to the display
+static bool qp_drawtext_render_cached_glyph(code_point_iter_drawglyph_state_t *state, const qp_glyph_cache_entry_t *entry, uint8_t height) {
+    painter_driver_t *driver = (painter_driver_t *)state->device;
+
+    // Configure where we're going to be rendering to
+    driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + entry->width - 1, state->ypos + height - 1);
+
+    // Move the x-position for the next glyph
+    state->xpos += entry->width;
+
+    // Copy through the pixdata buffer rather than sending from the cache, as the entry may be evicted while in flight
+    const uint8_t *src              = &glyph_cache_data[entry->offset];
+    uint32_t       remaining_pixels = ((uint32_t)entry->width) * height;
+    while (remaining_pixels > 0) {
+        uint32_t pixels = QP_MIN(remaining_pixels, state->output_state->max_pixels);
+        uint32_t bytes  = (pixels * driver->native_bits_per_pixel + 7) / 8;
+        memcpy(qp_internal_global_pixdata_buffer, src, bytes);
+        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, pixels)) {
+            return false;
+        }
+        qp_internal_swap_pixdata_buffer();
+        src += bytes;
+        remaining_pixels -= pixels;
+    }
+
+    return true;
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 // Codepoint handler callback: drawing
-static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
+    uint8_t                            height = qff_font->base.line_height;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Skip the font data entirely if the glyph has already been decoded
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(qff_font, state->device, code_point, state->fg_hsv888, state->bg_hsv888);
+    if (entry) {
+        ++glyph_cache_stats.hits;
+        return qp_drawtext_render_cached_glyph(state, entry, height);
+    }
+    ++glyph_cache_stats.misses;
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+    // Set up the palette the first time a glyph needs decoding
+    if (!state->palette_ready) {
+        uint32_t data_offset;
+        if (!qp_drawtext_prepare_font_for_render(state->device, qff_font, state->fg_hsv888, state->bg_hsv888, &data_offset)) {
+            qp_dprintf("Failed to prepare font for rendering.\n");
+            return false;
+        }
+        state->palette_ready = true;
+    }
+
+    uint8_t width;
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
+    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_drawtext_prepare_glyph_for_render()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
+    uint32_t pixel_count = ((uint32_t)width) * height;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Decode into the cache if there's room, then send it from there
+    entry = qp_glyph_cache_alloc((pixel_count * driver->native_bits_per_pixel + 7) / 8);
+    if (entry) {
+        entry->font       = qff_font;
+        entry->device     = state->device;
+        entry->code_point = code_point;
+        entry->fg_hsv888  = state->fg_hsv888;
+        entry->bg_hsv888  = state->bg_hsv888;
+        entry->last_used  = ++glyph_cache_tick;
+        entry->width      = width;
+
+        qp_glyph_cache_output_state_t cache_state = {.device = state->device, .target = &glyph_cache_data[entry->offset], .pixel_write_pos = 0};
+        if (!qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_glyph_cache_pixel_appender, &cache_state)) {
+            qp_glyph_cache_remove(entry);
+            return false;
+        }
+
+        return qp_drawtext_render_cached_glyph(state, entry, height);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Reset the output state
     state->output_state->pixel_write_pos = 0;
 
@@ -364,12 +570,12 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     state->xpos += width;
 
     // Decode the pixel data for the glyph
-    uint32_t pixel_count = ((uint32_t)width) * height;
-    bool     ret         = qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, state->output_state);
+    bool ret = qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, state->output_state);
 
     // Any leftovers need transmission as well.
     if (ret && state->output_state->pixel_write_pos > 0) {
         ret &= driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->output_state->pixel_write_pos);
+        qp_internal_swap_pixdata_buffer();
     }
 
     return ret;
@@ -434,26 +640,28 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     // Set up the pixel output state
     qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
+    // Fonts with their own palette ignore the requested colors
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    if (qff_font->has_palette) {
+        fg_hsv888 = bg_hsv888 = (qp_pixel_t){0};
+    }
+
     // Set up the codepoint iteration state
     code_point_iter_drawglyph_state_t state = {// Common
                                                .device = device,
                                                .xpos   = x,
                                                .ypos   = y,
+                                               // Palette, set up on the first glyph decoded
+                                               .fg_hsv888     = fg_hsv888,
+                                               .bg_hsv888     = bg_hsv888,
+                                               .palette_ready = false,
                                                // Input
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
                                                // Output
                                                .output_state = &output_state};
 
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
-    if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
-        qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
-        qp_comms_stop(device);
-        return false;
-    }
-
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
 
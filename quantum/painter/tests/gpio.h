@@ -0,0 +1,15 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef uint8_t pin_t;
+
+#include "pin_defs.h"
+
+void setPinOutput(pin_t pin);
+void writePinHigh(pin_t pin);
+void writePinLow(pin_t pin);
@@ -0,0 +1,137 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "mock_display.hpp"
+
+#include <numeric>
+
+extern "C" {
+#include "qp_internal.h"
+}
+
+struct MockDisplay::Device {
+    painter_driver_t base; // must be first, so it can be cast to/from the painter_device_t* type
+    MockDisplay *    mock;
+};
+
+namespace {
+
+MockDisplay *mock_for(painter_device_t device) {
+    return static_cast<const MockDisplay::Device *>(device)->mock;
+}
+
+bool mock_init(painter_device_t device, painter_rotation_t rotation) {
+    return true;
+}
+
+bool mock_power(painter_device_t device, bool power_on) {
+    return true;
+}
+
+bool mock_clear(painter_device_t device) {
+    return true;
+}
+
+bool mock_flush(painter_device_t device) {
+    return true;
+}
+
+bool mock_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    MockDisplay *mock = mock_for(device);
+    mock->viewports.push_back({left, top, right, bottom});
+    mock->pixdata_x = left;
+    mock->pixdata_y = top;
+    return true;
+}
+
+bool mock_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    MockDisplay *       mock     = mock_for(device);
+    const MockViewport &viewport = mock->viewports.back();
+    const uint16_t *    pixels   = static_cast<const uint16_t *>(pixel_data);
+    for (uint32_t i = 0; i < native_pixel_count; ++i) {
+        mock->framebuffer[mock->pixdata_y * mock->width + mock->pixdata_x] = pixels[i];
+        if (++mock->pixdata_x > viewport.right) {
+            mock->pixdata_x = viewport.left;
+            if (++mock->pixdata_y > viewport.bottom) {
+                mock->pixdata_y = viewport.top;
+            }
+        }
+    }
+    mock->pixdata_calls.push_back(native_pixel_count);
+    return true;
+}
+
+bool mock_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    return true;
+}
+
+bool mock_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    return true;
+}
+
+bool mock_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    return true;
+}
+
+const painter_driver_vtable_t mock_driver_vtable = {
+    .init            = mock_init,
+    .power           = mock_power,
+    .clear           = mock_clear,
+    .flush           = mock_flush,
+    .viewport        = mock_viewport,
+    .pixdata         = mock_pixdata,
+    .palette_convert = mock_palette_convert,
+    .append_pixels   = mock_append_pixels,
+    .append_pixdata  = mock_append_pixdata,
+};
+
+bool mock_comms_init(painter_device_t device) {
+    return true;
+}
+
+bool mock_comms_start(painter_device_t device) {
+    return true;
+}
+
+void mock_comms_stop(painter_device_t device) {}
+
+uint32_t mock_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    return byte_count;
+}
+
+const painter_comms_vtable_t mock_comms_vtable = {
+    .comms_init  = mock_comms_init,
+    .comms_start = mock_comms_start,
+    .comms_stop  = mock_comms_stop,
+    .comms_send  = mock_comms_send,
+};
+
+} // namespace
+
+MockDisplay::MockDisplay(uint16_t width, uint16_t height) : width(width), height(height), framebuffer(width * height, 0), device_(new Device{}) {
+    device_->base.driver_vtable         = &mock_driver_vtable;
+    device_->base.comms_vtable          = &mock_comms_vtable;
+    device_->base.native_bits_per_pixel = 16;
+    device_->base.panel_width           = width;
+    device_->base.panel_height          = height;
+    device_->base.rotation              = QP_ROTATION_0;
+    device_->mock                       = this;
+    qp_init(device(), QP_ROTATION_0);
+}
+
+MockDisplay::~MockDisplay() {
+    delete device_;
+}
+
+painter_device_t MockDisplay::device() {
+    return static_cast<painter_device_t>(device_);
+}
+
+void MockDisplay::reset() {
+    viewports.clear();
+    pixdata_calls.clear();
+}
+
+uint32_t MockDisplay::pixels_transferred() const {
+    return std::accumulate(pixdata_calls.begin(), pixdata_calls.end(), 0u);
+}
@@ -0,0 +1,47 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include "qp.h"
+}
+
+struct MockViewport {
+    uint16_t left;
+    uint16_t top;
+    uint16_t right;
+    uint16_t bottom;
+};
+
+/* An RGB565 display which records what's sent to it. */
+class MockDisplay {
+   public:
+    MockDisplay(uint16_t width, uint16_t height);
+    ~MockDisplay();
+    MockDisplay(const MockDisplay &) = delete;
+    MockDisplay &operator=(const MockDisplay &) = delete;
+
+    painter_device_t device();
+    void             reset();
+    uint32_t         pixels_transferred() const;
+
+    uint16_t                  width;
+    uint16_t                  height;
+    std::vector<uint16_t>     framebuffer;
+    std::vector<MockViewport> viewports;
+    std::vector<uint32_t>     pixdata_calls; // Pixel count of each qp_pixdata() call
+
+    // Write location within the last viewport
+    uint16_t pixdata_x = 0;
+    uint16_t pixdata_y = 0;
+
+    struct Device;
+
+   private:
+    Device *device_;
+};
@@ -0,0 +1,121 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include "gtest/gtest.h"
+#include "spi_mock.hpp"
+
+extern "C" {
+#include "color.h"
+#include "qp_ili9341.h"
+#include "qp_rgb565_surface.h"
+#include "djinn.qgf.h"
+}
+
+namespace {
+
+constexpr uint16_t panel_width  = 240;
+constexpr uint16_t panel_height = 320;
+constexpr pin_t    cs_pin       = 1;
+constexpr pin_t    dc_pin       = 2;
+constexpr pin_t    reset_pin    = 3;
+
+uint16_t surface_buffer[panel_width * panel_height];
+
+/* Devices can't be freed, so every test shares the one of each. */
+painter_device_t shared_panel() {
+    static painter_device_t panel = qp_ili9341_make_spi_device(panel_width, panel_height, cs_pin, dc_pin, reset_pin, 2, 0);
+    return panel;
+}
+
+painter_device_t shared_surface() {
+    static painter_device_t surface = qp_rgb565_make_surface(panel_width, panel_height, surface_buffer);
+    return surface;
+}
+
+// Setting a viewport sends the column and page address commands with their start and end, then the memory write command
+constexpr uint32_t viewport_bytes = (1 + 4) + (1 + 4) + 1;
+
+} // namespace
+
+class QPCommsSPI : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        SPIMock::instance().reset(panel_width, panel_height, dc_pin);
+        panel   = shared_panel();
+        surface = shared_surface();
+        ASSERT_TRUE(qp_init(panel, QP_ROTATION_0)) << "Panel init failed";
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0)) << "Surface init failed";
+    }
+
+    void TearDown() override {
+        auto &mock = SPIMock::instance();
+        EXPECT_EQ(mock.overlapping_transfers, 0) << "Transfer started before the previous one completed";
+        EXPECT_EQ(mock.dc_changed_in_flight, 0) << "D/C changed during a transfer";
+        EXPECT_EQ(mock.stopped_in_flight, 0) << "Comms stopped during a transfer";
+        EXPECT_EQ(mock.transfers_not_selected, 0) << "Transfer without the panel selected";
+    }
+
+    void expect_panel_matches_surface() {
+        auto &mock = SPIMock::instance();
+        for (uint32_t i = 0; i < panel_width * panel_height; ++i) {
+            ASSERT_EQ(mock.framebuffer[i], surface_buffer[i]) << "Pixel (" << i % panel_width << ", " << i / panel_width << ") differs";
+        }
+    }
+
+    /* Whether streaming or not, an area takes one viewport and then its pixels, nothing more. */
+    void expect_area_sent(uint32_t width, uint32_t height) {
+        auto &mock = SPIMock::instance();
+        EXPECT_EQ(mock.bytes_sent, viewport_bytes + width * height * sizeof(uint16_t));
+        EXPECT_EQ(mock.bus_time, mock.byte_time * mock.bytes_sent);
+    }
+
+    painter_device_t panel;
+    painter_device_t surface;
+};
+
+TEST_F(QPCommsSPI, ShapesMatchSurface) {
+    for (painter_device_t device : {panel, surface}) {
+        qp_rect(device, 0, 0, panel_width - 1, panel_height - 1, HSV_BLUE, true);
+        qp_rect(device, 10, 20, 200, 150, HSV_RED, true);
+        qp_rect(device, 30, 160, 220, 300, HSV_GREEN, false);
+        qp_line(device, 0, 0, panel_width - 1, panel_height - 1, HSV_WHITE);
+        qp_circle(device, 120, 240, 50, HSV_YELLOW, true);
+        qp_setpixel(device, 5, 5, HSV_CYAN);
+    }
+    expect_panel_matches_surface();
+}
+
+TEST_F(QPCommsSPI, ImageMatchesSurface) {
+    painter_image_handle_t image = qp_load_image_mem(gfx_djinn);
+    ASSERT_NE(image, nullptr);
+
+    SPIMock::instance().reset(panel_width, panel_height, dc_pin);
+    ASSERT_TRUE(qp_drawimage_recolor(panel, 60, 16, image, HSV_WHITE, 0, 0, 0));
+    expect_area_sent(102, 288);
+    ASSERT_TRUE(qp_drawimage_recolor(surface, 60, 16, image, HSV_WHITE, 0, 0, 0));
+    qp_close_image(image);
+
+    expect_panel_matches_surface();
+}
+
+TEST_F(QPCommsSPI, SurfaceDrawMatches) {
+    auto        &mock = SPIMock::instance();
+    std::mt19937 rng(42);
+    for (int i = 0; i < 100; ++i) {
+        uint16_t l = rng() % panel_width, t = rng() % panel_height;
+        uint16_t r = l + rng() % (panel_width - l), b = t + rng() % (panel_height - t);
+        qp_rect(surface, l, t, r, b, rng() % 256, 255, 255, true);
+    }
+
+    mock.reset(panel_width, panel_height, dc_pin);
+    ASSERT_TRUE(qp_rgb565_surface_draw(surface, panel, 0, 0));
+    expect_area_sent(panel_width, panel_height);
+    expect_panel_matches_surface();
+
+#ifdef QUANTUM_PAINTER_SPI_ASYNC
+    // Filling the next half of the buffer overlaps with sending the last one
+    EXPECT_GT(mock.async_transfers, 1);
+    EXPECT_GT(mock.overlap_time.count(), 0) << "Expected rendering to carry on while pixels were on the bus";
+#endif
+}
@@ -0,0 +1,184 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstring>
+#include <set>
+#include <string>
+#include "gtest/gtest.h"
+#include "test_benchmark.hpp"
+
+extern "C" {
+#include "color.h"
+#include "qp.h"
+#include "qp_rgb565_surface.h"
+#include "thintel15.qff.h"
+}
+
+namespace {
+
+constexpr uint16_t surface_width  = 240;
+constexpr uint16_t surface_height = 80;
+
+uint16_t surface_buffer[surface_width * surface_height];
+
+/* Devices can't be freed, so every test shares the one surface. */
+painter_device_t shared_surface() {
+    static painter_device_t surface = qp_rgb565_make_surface(surface_width, surface_height, surface_buffer);
+    return surface;
+}
+
+// The sort of status lines a keyboard redraws every frame
+const char *status_lines[] = {
+    "Layer: BASE",
+    "WPM: 123",
+    "Caps Num Scroll",
+    "Unicode: Linux",
+};
+
+uint32_t surface_hash() {
+    uint32_t hash = 2166136261u;
+    for (auto pixel : surface_buffer) {
+        hash = (hash ^ pixel) * 16777619u;
+    }
+    return hash;
+}
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+constexpr const char *mode = "glyph_cache";
+#else
+constexpr const char *mode = "uncached";
+#endif
+
+} // namespace
+
+class QPDrawText : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        surface = shared_surface();
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0)) << "Surface init failed";
+        font = qp_load_font_mem(font_thintel15);
+        ASSERT_NE(font, nullptr) << "Font load failed";
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+        qp_glyph_cache_clear();
+#endif
+    }
+
+    void TearDown() override {
+        qp_close_font(font);
+    }
+
+    void draw_status(uint8_t hue, uint8_t sat, uint8_t val) {
+        for (size_t i = 0; i < sizeof(status_lines) / sizeof(status_lines[0]); ++i) {
+            ASSERT_GT(qp_drawtext_recolor(surface, 2, 2 + i * font->line_height, font, status_lines[i], hue, sat, val, HSV_BLACK), 0);
+        }
+    }
+
+    painter_device_t      surface;
+    painter_font_handle_t font;
+};
+
+TEST_F(QPDrawText, RendersExpectedPixels) {
+    memset(surface_buffer, 0, sizeof(surface_buffer));
+    draw_status(HSV_RED);
+    ASSERT_EQ(qp_drawtext(surface, 120, 2, font, "Hello, world!"), qp_textwidth(font, "Hello, world!"));
+    // Matches the output from before glyphs were cached
+    EXPECT_EQ(surface_hash(), 4039871678u);
+
+    // Drawing the same again, from the cache if enabled, changes nothing
+    draw_status(HSV_RED);
+    EXPECT_EQ(qp_drawtext(surface, 120, 2, font, "Hello, world!"), qp_textwidth(font, "Hello, world!"));
+    EXPECT_EQ(surface_hash(), 4039871678u);
+}
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+TEST_F(QPDrawText, CountsHitsAndMisses) {
+    qp_glyph_cache_stats_t stats;
+
+    qp_drawtext(surface, 0, 0, font, "abcabc");
+    qp_glyph_cache_get_stats(&stats);
+    EXPECT_EQ(stats.misses, 3);
+    EXPECT_EQ(stats.hits, 3);
+
+    qp_drawtext(surface, 0, 20, font, "cab");
+    qp_glyph_cache_get_stats(&stats);
+    EXPECT_EQ(stats.misses, 3);
+    EXPECT_EQ(stats.hits, 6);
+
+    // Different colors need decoding again
+    qp_drawtext_recolor(surface, 0, 40, font, "abc", HSV_GREEN, HSV_BLACK);
+    qp_glyph_cache_get_stats(&stats);
+    EXPECT_EQ(stats.misses, 6);
+    EXPECT_EQ(stats.hits, 6);
+    EXPECT_EQ(stats.evictions, 0);
+
+    // Closing the font drops its glyphs
+    qp_close_font(font);
+    font = qp_load_font_mem(font_thintel15);
+    qp_drawtext(surface, 0, 0, font, "abc");
+    qp_glyph_cache_get_stats(&stats);
+    EXPECT_EQ(stats.misses, 9);
+}
+
+TEST_F(QPDrawText, EvictsLeastRecentlyUsed) {
+    const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+    memset(surface_buffer, 0, sizeof(surface_buffer));
+    qp_drawtext(surface, 0, 0, font, alphabet);
+    uint32_t expected = surface_hash();
+
+    // More glyphs than fit, so the earliest are evicted before they're drawn again
+    qp_glyph_cache_stats_t stats;
+    qp_glyph_cache_get_stats(&stats);
+    EXPECT_GT(stats.evictions, 0);
+
+    memset(surface_buffer, 0, sizeof(surface_buffer));
+    qp_drawtext(surface, 0, 0, font, alphabet);
+    EXPECT_EQ(surface_hash(), expected);
+
+    // A recently drawn glyph survives, where the least recently used is evicted
+    const char *others = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    qp_glyph_cache_clear();
+    qp_drawtext(surface, 0, 0, font, "xy");
+    for (const char *c = others; *c; ++c) {
+        char glyph[2] = {*c, 0};
+        qp_drawtext(surface, 0, 0, font, glyph);
+        qp_drawtext(surface, 0, 0, font, "x");
+    }
+    qp_glyph_cache_get_stats(&stats);
+    uint32_t misses = stats.misses;
+    qp_drawtext(surface, 0, 0, font, "x");
+    qp_glyph_cache_get_stats(&stats);
+    EXPECT_EQ(stats.misses, misses) << "Frequently drawn glyph was evicted";
+    qp_drawtext(surface, 0, 0, font, "y");
+    qp_glyph_cache_get_stats(&stats);
+    EXPECT_EQ(stats.misses, misses + 1) << "Least recently used glyph was not evicted";
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+TEST_F(QPDrawText, StatusLineThroughput) {
+    const uint32_t loops    = BenchmarkRecorder::loops(2000);
+    auto          &recorder = BenchmarkRecorder::instance();
+    for (uint32_t i = 0; i < loops; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        draw_status(HSV_WHITE);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        recorder.record("status_lines", std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+    EXPECT_TRUE(recorder.write_json(BenchmarkRecorder::output_path(std::string("qp_draw_text_") + mode), {{"benchmark", "qp_draw_text"}, {"mode", mode}, {"loops", std::to_string(loops)}}));
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Each glyph is decoded once, and every later redraw comes from the cache
+    std::set<char> glyphs;
+    uint32_t       drawn = 0;
+    for (auto line : status_lines) {
+        glyphs.insert(line, line + strlen(line));
+        drawn += strlen(line);
+    }
+    qp_glyph_cache_stats_t stats;
+    qp_glyph_cache_get_stats(&stats);
+    EXPECT_EQ(stats.misses, glyphs.size());
+    EXPECT_EQ(stats.hits, loops * drawn - glyphs.size());
+    EXPECT_EQ(stats.evictions, 0) << "Status lines should fit in the cache";
+#endif
+}
@@ -0,0 +1,146 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include "gtest/gtest.h"
+#include "mock_display.hpp"
+
+extern "C" {
+#include "color.h"
+#include "qp_rgb565_surface.h"
+}
+
+namespace {
+
+constexpr uint16_t panel_width  = 240;
+constexpr uint16_t panel_height = 320;
+
+uint16_t surface_buffer[panel_width * panel_height];
+
+/* Surfaces can't be freed, so every test shares the one. */
+painter_device_t shared_surface() {
+    static painter_device_t surface = qp_rgb565_make_surface(panel_width, panel_height, surface_buffer);
+    return surface;
+}
+
+} // namespace
+
+class RGB565SurfaceDirtyTracking : public ::testing::Test {
+   protected:
+    RGB565SurfaceDirtyTracking() : display(panel_width, panel_height) {}
+
+    void SetUp() override {
+        surface = shared_surface();
+        ASSERT_NE(surface, nullptr);
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0)) << "Surface init failed";
+        ASSERT_TRUE(qp_flush(surface)) << "Surface flush failed";
+    }
+
+    // Draws the surface's dirty regions to the display, returning the number of pixels transferred
+    uint32_t draw() {
+        display.reset();
+        EXPECT_TRUE(qp_rgb565_surface_draw(surface, display.device(), 0, 0)) << "Surface draw failed";
+        return display.pixels_transferred();
+    }
+
+    void expect_display_matches_surface() {
+        for (uint32_t i = 0; i < panel_width * panel_height; ++i) {
+            ASSERT_EQ(display.framebuffer[i], surface_buffer[i]) << "Pixel (" << i % panel_width << ", " << i / panel_width << ") differs";
+        }
+    }
+
+    MockDisplay      display;
+    painter_device_t surface;
+};
+
+TEST_F(RGB565SurfaceDirtyTracking, CleanSurfaceSendsNothing) {
+    EXPECT_EQ(draw(), 0);
+    EXPECT_TRUE(display.viewports.empty());
+
+    // Drawing what's already there doesn't dirty anything either
+    qp_rect(surface, 10, 10, 20, 20, 0, 0, 0, true);
+    EXPECT_EQ(draw(), 0);
+}
+
+TEST_F(RGB565SurfaceDirtyTracking, FilledRectIsOneRegion) {
+    qp_rect(surface, 20, 30, 119, 79, HSV_RED, true);
+    EXPECT_EQ(draw(), 100 * 50);
+    ASSERT_EQ(display.viewports.size(), 1);
+    EXPECT_EQ(display.viewports[0].left, 20);
+    EXPECT_EQ(display.viewports[0].top, 30);
+    EXPECT_EQ(display.viewports[0].right, 119);
+    EXPECT_EQ(display.viewports[0].bottom, 79);
+    expect_display_matches_surface();
+
+    // Drawing resets the dirty regions
+    EXPECT_EQ(draw(), 0);
+}
+
+TEST_F(RGB565SurfaceDirtyTracking, OppositeCornersAreSentSeparately) {
+    qp_rect(surface, 0, 0, 15, 15, HSV_RED, true);
+    qp_rect(surface, panel_width - 16, panel_height - 16, panel_width - 1, panel_height - 1, HSV_BLUE, true);
+
+    // Rather than the whole surface, as a single region covering both would be
+    EXPECT_EQ(draw(), 2 * 16 * 16);
+    EXPECT_EQ(display.viewports.size(), 2);
+    expect_display_matches_surface();
+}
+
+TEST_F(RGB565SurfaceDirtyTracking, NearbyRegionsAreMerged) {
+    // Two widgets a couple of pixels apart cost less to send together than with two viewports
+    qp_rect(surface, 10, 10, 19, 19, HSV_RED, true);
+    qp_rect(surface, 22, 10, 31, 19, HSV_GREEN, true);
+    EXPECT_EQ(draw(), 22 * 10);
+    EXPECT_EQ(display.viewports.size(), 1);
+    expect_display_matches_surface();
+}
+
+TEST_F(RGB565SurfaceDirtyTracking, RegionCountIsBounded) {
+    // More scattered pixels than there are regions to track them
+    for (uint16_t i = 0; i < 2 * RGB565_SURFACE_DIRTY_RECTS; ++i) {
+        qp_setpixel(surface, (i * 97) % panel_width, (i * 61) % panel_height, HSV_WHITE);
+    }
+    draw();
+    EXPECT_LE(display.viewports.size(), RGB565_SURFACE_DIRTY_RECTS);
+    expect_display_matches_surface();
+}
+
+TEST_F(RGB565SurfaceDirtyTracking, RandomDrawingMatches) {
+    std::mt19937 rng(1234);
+    uint64_t     pixels  = 0;
+    uint64_t     bounded = 0;
+
+    for (int frame = 0; frame < 200; ++frame) {
+        uint16_t l = panel_width, t = panel_height, r = 0, b = 0;
+        for (int shape = rng() % 4; shape >= 0; --shape) {
+            uint16_t x0 = rng() % panel_width, y0 = rng() % panel_height;
+            uint16_t w = rng() % 24, h = rng() % 24;
+            uint16_t x1 = QP_MIN(panel_width - 1, x0 + w), y1 = QP_MIN(panel_height - 1, y0 + h);
+            switch (rng() % 3) {
+                case 0:
+                    qp_setpixel(surface, x0, y0, rng() % 256, 255, 255);
+                    x1 = x0;
+                    y1 = y0;
+                    break;
+                case 1:
+                    qp_line(surface, x0, y0, x1, y1, rng() % 256, 255, 255);
+                    break;
+                default:
+                    qp_rect(surface, x0, y0, x1, y1, rng() % 256, 255, 255, rng() % 2);
+                    break;
+            }
+            l = QP_MIN(l, x0);
+            t = QP_MIN(t, y0);
+            r = QP_MAX(r, x1);
+            b = QP_MAX(b, y1);
+        }
+        pixels += draw();
+        bounded += (uint32_t)(r - l + 1) * (b - t + 1);
+        expect_display_matches_surface();
+        if (HasFatalFailure()) {
+            return;
+        }
+    }
+
+    EXPECT_LT(pixels, bounded);
+}
@@ -0,0 +1,91 @@
+qp_rgb565_surface_DEFS := \
+	-DQUANTUM_PAINTER_ENABLE \
+	-DQUANTUM_PAINTER_RGB565_SURFACE_ENABLE
+qp_rgb565_surface_INC := \
+	$(QUANTUM_PATH)/painter/tests \
+	$(QUANTUM_PATH)/painter \
+	$(QUANTUM_PATH)/unicode \
+	$(DRIVER_PATH)/painter/generic
+qp_rgb565_surface_SRC := \
+	$(QUANTUM_PATH)/painter/tests/mock_display.cpp \
+	$(QUANTUM_PATH)/painter/tests/qp_rgb565_surface_tests.cpp \
+	$(QUANTUM_PATH)/painter/qp.c \
+	$(QUANTUM_PATH)/painter/qp_comms.c \
+	$(QUANTUM_PATH)/painter/qp_draw_core.c \
+	$(QUANTUM_PATH)/painter/qp_stream.c \
+	$(QUANTUM_PATH)/color.c \
+	$(DRIVER_PATH)/painter/generic/qp_rgb565_surface.c
+
+qp_comms_spi_DEFS := \
+	-DQUANTUM_PAINTER_ENABLE \
+	-DQUANTUM_PAINTER_DISPLAY_TIMEOUT=0 \
+	-DQUANTUM_PAINTER_RGB565_SURFACE_ENABLE \
+	-DQUANTUM_PAINTER_ILI9341_ENABLE \
+	-DQUANTUM_PAINTER_ILI9341_SPI_ENABLE \
+	-DQUANTUM_PAINTER_SPI_ENABLE \
+	-DQUANTUM_PAINTER_SPI_DC_RESET_ENABLE
+qp_comms_spi_INC := \
+	$(QUANTUM_PATH)/painter/tests \
+	$(QUANTUM_PATH)/painter \
+	$(QUANTUM_PATH)/unicode \
+	$(DRIVER_PATH)/painter/comms \
+	$(DRIVER_PATH)/painter/generic \
+	$(DRIVER_PATH)/painter/tft_panel \
+	$(DRIVER_PATH)/painter/ili9xxx
+qp_comms_spi_SRC := \
+	$(QUANTUM_PATH)/painter/tests/spi_mock.cpp \
+	$(QUANTUM_PATH)/painter/tests/qp_comms_spi_tests.cpp \
+	$(QUANTUM_PATH)/painter/tests/djinn.qgf.c \
+	$(QUANTUM_PATH)/painter/qp.c \
+	$(QUANTUM_PATH)/painter/qp_comms.c \
+	$(QUANTUM_PATH)/painter/qp_internal.c \
+	$(QUANTUM_PATH)/painter/qp_stream.c \
+	$(QUANTUM_PATH)/painter/qgf.c \
+	$(QUANTUM_PATH)/painter/qff.c \
+	$(QUANTUM_PATH)/painter/qp_draw_core.c \
+	$(QUANTUM_PATH)/painter/qp_draw_codec.c \
+	$(QUANTUM_PATH)/painter/qp_draw_circle.c \
+	$(QUANTUM_PATH)/painter/qp_draw_ellipse.c \
+	$(QUANTUM_PATH)/painter/qp_draw_image.c \
+	$(QUANTUM_PATH)/painter/qp_draw_text.c \
+	$(QUANTUM_PATH)/unicode/utf8.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/deferred_exec.c \
+	$(DRIVER_PATH)/painter/comms/qp_comms_spi.c \
+	$(DRIVER_PATH)/painter/generic/qp_rgb565_surface.c \
+	$(DRIVER_PATH)/painter/tft_panel/qp_tft_panel.c \
+	$(DRIVER_PATH)/painter/ili9xxx/qp_ili9341.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+qp_comms_spi_async_DEFS := $(qp_comms_spi_DEFS) -DQUANTUM_PAINTER_SPI_ASYNC
+qp_comms_spi_async_INC := $(qp_comms_spi_INC)
+qp_comms_spi_async_SRC := $(qp_comms_spi_SRC)
+
+qp_draw_text_DEFS := \
+	-DQUANTUM_PAINTER_ENABLE \
+	-DQUANTUM_PAINTER_RGB565_SURFACE_ENABLE
+qp_draw_text_INC := \
+	$(QUANTUM_PATH)/painter/tests \
+	$(QUANTUM_PATH)/painter \
+	$(QUANTUM_PATH)/unicode \
+	$(DRIVER_PATH)/painter/generic \
+	$(TOP_DIR)/tests/test_common
+qp_draw_text_SRC := \
+	$(QUANTUM_PATH)/painter/tests/qp_draw_text_tests.cpp \
+	$(TOP_DIR)/tests/test_common/test_benchmark.cpp \
+	$(QUANTUM_PATH)/painter/tests/thintel15.qff.c \
+	$(QUANTUM_PATH)/painter/qp.c \
+	$(QUANTUM_PATH)/painter/qp_comms.c \
+	$(QUANTUM_PATH)/painter/qp_stream.c \
+	$(QUANTUM_PATH)/painter/qff.c \
+	$(QUANTUM_PATH)/painter/qgf.c \
+	$(QUANTUM_PATH)/painter/qp_draw_core.c \
+	$(QUANTUM_PATH)/painter/qp_draw_codec.c \
+	$(QUANTUM_PATH)/painter/qp_draw_text.c \
+	$(QUANTUM_PATH)/unicode/utf8.c \
+	$(QUANTUM_PATH)/color.c \
+	$(DRIVER_PATH)/painter/generic/qp_rgb565_surface.c
+
+qp_draw_text_glyph_cache_DEFS := $(qp_draw_text_DEFS) -DQUANTUM_PAINTER_GLYPH_CACHE_SIZE=6144 -DQUANTUM_PAINTER_GLYPH_CACHE_ENTRIES=32
+qp_draw_text_glyph_cache_INC := $(qp_draw_text_INC)
+qp_draw_text_glyph_cache_SRC := $(qp_draw_text_SRC)
@@ -0,0 +1,211 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "spi_mock.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// ILI9xxx commands understood by the panel
+constexpr uint8_t cmd_set_col_addr  = 0x2A;
+constexpr uint8_t cmd_set_page_addr = 0x2B;
+constexpr uint8_t cmd_set_mem       = 0x2C;
+
+} // namespace
+
+SPIMock& SPIMock::instance() {
+    static SPIMock mock;
+    return mock;
+}
+
+void SPIMock::reset(uint16_t width, uint16_t height, pin_t dc_pin) {
+    this->width  = width;
+    this->height = height;
+    framebuffer.assign(width * height, 0);
+    bytes_sent             = 0;
+    bus_time               = std::chrono::nanoseconds{0};
+    wait_time              = std::chrono::nanoseconds{0};
+    overlap_time           = std::chrono::nanoseconds{0};
+    async_transfers        = 0;
+    overlapping_transfers  = 0;
+    dc_changed_in_flight   = 0;
+    stopped_in_flight      = 0;
+    transfers_not_selected = 0;
+    dc_pin_                = dc_pin;
+    pending_data_          = nullptr;
+}
+
+void SPIMock::busy_wait(std::chrono::steady_clock::time_point until) {
+    auto start = std::chrono::steady_clock::now();
+    auto now   = start;
+    while (now < until) {
+        now = std::chrono::steady_clock::now();
+    }
+    wait_time += std::chrono::duration_cast<std::chrono::nanoseconds>(now - start);
+}
+
+void SPIMock::receive(uint8_t byte) {
+    ++bytes_sent;
+    if (!dc_) {
+        command_     = byte;
+        param_count_ = 0;
+        return;
+    }
+
+    switch (command_) {
+        case cmd_set_col_addr:
+        case cmd_set_page_addr:
+            if (param_count_ < sizeof(params_)) {
+                params_[param_count_++] = byte;
+            }
+            if (param_count_ == sizeof(params_)) {
+                uint16_t start = (params_[0] << 8) | params_[1];
+                uint16_t end   = (params_[2] << 8) | params_[3];
+                if (command_ == cmd_set_col_addr) {
+                    col_start_ = start;
+                    col_end_   = end;
+                } else {
+                    row_start_ = start;
+                    row_end_   = end;
+                }
+            }
+            break;
+        case cmd_set_mem:
+            if (param_count_ == 0) {
+                x_ = col_start_;
+                y_ = row_start_;
+            }
+            params_[param_count_++ % 2] = byte;
+            if (param_count_ % 2 == 0) {
+                // Kept in the order received, matching an RGB565 surface's buffer
+                if (x_ < width && y_ < height) {
+                    memcpy(&framebuffer[y_ * width + x_], params_, 2);
+                }
+                if (++x_ > col_end_) {
+                    x_ = col_start_;
+                    if (++y_ > row_end_) {
+                        y_ = row_start_;
+                    }
+                }
+                // Keep the count from wrapping back to zero
+                param_count_ = 2;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void SPIMock::start() {
+    selected_ = true;
+}
+
+void SPIMock::stop() {
+    if (pending_data_) {
+        ++stopped_in_flight;
+        wait();
+    }
+    selected_ = false;
+}
+
+void SPIMock::transmit(const uint8_t* data, uint16_t length) {
+    if (pending_data_) {
+        ++overlapping_transfers;
+        wait();
+    }
+    if (!selected_) {
+        ++transfers_not_selected;
+    }
+    auto duration = byte_time * length;
+    bus_time += duration;
+    busy_wait(std::chrono::steady_clock::now() + duration);
+    for (uint16_t i = 0; i < length; ++i) {
+        receive(data[i]);
+    }
+}
+
+void SPIMock::transmit_async(const uint8_t* data, uint16_t length) {
+    if (pending_data_) {
+        ++overlapping_transfers;
+        wait();
+    }
+    if (!selected_) {
+        ++transfers_not_selected;
+    }
+    auto duration = byte_time * length;
+    bus_time += duration;
+    ++async_transfers;
+    pending_data_   = data;
+    pending_length_ = length;
+    pending_start_  = std::chrono::steady_clock::now();
+    pending_done_   = pending_start_ + duration;
+}
+
+void SPIMock::wait() {
+    if (!pending_data_) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    overlap_time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::min(now, pending_done_) - pending_start_);
+    busy_wait(pending_done_);
+    for (uint16_t i = 0; i < pending_length_; ++i) {
+        receive(pending_data_[i]);
+    }
+    pending_data_ = nullptr;
+}
+
+void SPIMock::write_pin(pin_t pin, bool value) {
+    if (pin == dc_pin_) {
+        if (pending_data_ && dc_ != value) {
+            ++dc_changed_in_flight;
+        }
+        dc_ = value;
+    }
+}
+
+extern "C" {
+
+void setPinOutput(pin_t pin) {}
+
+void writePinHigh(pin_t pin) {
+    SPIMock::instance().write_pin(pin, true);
+}
+
+void writePinLow(pin_t pin) {
+    SPIMock::instance().write_pin(pin, false);
+}
+
+void spi_init(void) {}
+
+bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    SPIMock::instance().start();
+    return true;
+}
+
+spi_status_t spi_write(uint8_t data) {
+    SPIMock::instance().transmit(&data, 1);
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_transmit(const uint8_t* data, uint16_t length) {
+    SPIMock::instance().transmit(data, length);
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_transmit_async(const uint8_t* data, uint16_t length) {
+    SPIMock::instance().transmit_async(data, length);
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_transmit_wait(void) {
+    SPIMock::instance().wait();
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_stop(void) {
+    SPIMock::instance().stop();
+}
+
+} // extern "C"
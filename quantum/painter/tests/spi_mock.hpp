@@ -0,0 +1,71 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include "spi_master.h"
+}
+
+/* An SPI bus with an ILI9xxx-style panel on the end, taking real time to clock each byte out. Background transfers
+   read their data when they complete, as DMA would, so anything modified while still in flight shows up on the panel. */
+class SPIMock {
+   public:
+    static SPIMock& instance();
+
+    void reset(uint16_t width, uint16_t height, pin_t dc_pin);
+
+    // Time taken to clock out each byte
+    std::chrono::nanoseconds byte_time{100};
+
+    // What the panel shows
+    uint16_t              width  = 0;
+    uint16_t              height = 0;
+    std::vector<uint16_t> framebuffer;
+
+    uint64_t                 bytes_sent = 0;
+    std::chrono::nanoseconds bus_time{0};  // Time spent clocking out data
+    std::chrono::nanoseconds wait_time{0};    // Time the caller spent blocked on the bus
+    std::chrono::nanoseconds overlap_time{0}; // Time the bus spent on background transfers while the caller carried on
+    uint64_t                 async_transfers = 0;
+
+    // Misuse of the bus, all of which should stay at zero
+    uint64_t overlapping_transfers  = 0;
+    uint64_t dc_changed_in_flight   = 0;
+    uint64_t stopped_in_flight      = 0;
+    uint64_t transfers_not_selected = 0;
+
+    // Handlers for the mocked functions
+    void start();
+    void stop();
+    void transmit(const uint8_t* data, uint16_t length);
+    void transmit_async(const uint8_t* data, uint16_t length);
+    void wait();
+    void write_pin(pin_t pin, bool value);
+
+   private:
+    void busy_wait(std::chrono::steady_clock::time_point until);
+    void receive(uint8_t byte);
+
+    pin_t dc_pin_   = NO_PIN;
+    bool  dc_       = false;
+    bool  selected_ = false;
+
+    // Transfer in flight
+    const uint8_t*                        pending_data_   = nullptr;
+    uint16_t                              pending_length_ = 0;
+    std::chrono::steady_clock::time_point pending_start_;
+    std::chrono::steady_clock::time_point pending_done_;
+
+    // Panel command decoding
+    uint8_t  command_ = 0;
+    uint8_t  params_[4];
+    uint8_t  param_count_ = 0;
+    uint16_t col_start_ = 0, col_end_ = 0, row_start_ = 0, row_end_ = 0;
+    uint16_t x_ = 0, y_ = 0;
+};
@@ -0,0 +1,6 @@
+TEST_LIST += \
+	qp_rgb565_surface \
+	qp_comms_spi \
+	qp_comms_spi_async \
+	qp_draw_text \
+	qp_draw_text_glyph_cache
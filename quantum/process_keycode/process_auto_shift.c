@@ -273,7 +273,7 @@ static void autoshift_end(uint16_t keycode, uint16_t now, bool matrix_trigger, k
 #    endif
         // clang-format on
 #    if TAP_CODE_DELAY > 0
-        wait_ms(TAP_CODE_DELAY);
+        output_queue_wait_ms(TAP_CODE_DELAY);
 #    endif
 
         autoshift_release_user(autoshift_lastkey, autoshift_flags.lastshifted, record);
@@ -14,12 +14,16 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#ifdef COMBO_KEY_INDEX
+#    include <stdlib.h>
+#endif
 #include "keymap_common.h"
 #include "print.h"
 #include "process_combo.h"
 #include "action_tapping.h"
 #include "action.h"
 #include "keymap_introspection.h"
+#include "output_queue.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -88,6 +92,24 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_KEY_INDEX
+/* Inverted index from keycode to the combos containing it, sorted by keycode
+ * and then by combo index so candidates are visited in the same order as the
+ * linear scan. Combos whose state may be dirty are tracked in a list, so
+ * clear_combos() doesn't have to walk every combo either. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_key_entry_t;
+
+static combo_key_entry_t *combo_key_entries      = NULL;
+static uint16_t           combo_key_entry_count  = 0;
+static uint16_t           combo_key_index_combos = 0;
+static uint8_t *          combo_touched_bits     = NULL;
+static uint16_t *         combo_touched          = NULL;
+static uint16_t           combo_touched_count    = 0;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -185,9 +207,120 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
     return COMBO_TERM;
 }
 
+#ifdef COMBO_KEY_INDEX
+static inline bool combo_key_index_ready(void) {
+    return combo_key_entries && combo_key_index_combos == combo_count();
+}
+
+static inline void combo_touch(uint16_t combo_index) {
+    uint8_t bit = 1 << (combo_index & 7);
+    if (!(combo_touched_bits[combo_index / 8] & bit)) {
+        combo_touched_bits[combo_index / 8] |= bit;
+        combo_touched[combo_touched_count++] = combo_index;
+    }
+}
+
+static int combo_key_entry_compare(const void *a, const void *b) {
+    const combo_key_entry_t *entry_a = a;
+    const combo_key_entry_t *entry_b = b;
+    if (entry_a->keycode != entry_b->keycode) {
+        return entry_a->keycode < entry_b->keycode ? -1 : 1;
+    }
+    return (int)entry_a->combo_index - (int)entry_b->combo_index;
+}
+
+static void combo_key_index_build(void) {
+    free(combo_key_entries);
+    free(combo_touched_bits);
+    free(combo_touched);
+    combo_key_entries     = NULL;
+    combo_key_entry_count = 0;
+    combo_touched_count   = 0;
+
+    uint16_t count = combo_count();
+    uint16_t total = 0;
+    for (uint16_t index = 0; index < count; ++index) {
+        const uint16_t *keys = combo_get(index)->keys;
+        while (pgm_read_word(keys++) != COMBO_END) {
+            total++;
+        }
+    }
+
+    combo_key_entries  = malloc(total * sizeof(combo_key_entry_t));
+    combo_touched_bits = calloc((count + 7) / 8, 1);
+    combo_touched      = malloc(count * sizeof(uint16_t));
+    if ((total && !combo_key_entries) || (count && (!combo_touched_bits || !combo_touched))) {
+        // Not enough memory, fall back to scanning all combos
+        free(combo_key_entries);
+        free(combo_touched_bits);
+        free(combo_touched);
+        combo_key_entries  = NULL;
+        combo_touched_bits = NULL;
+        combo_touched      = NULL;
+        return;
+    }
+
+    for (uint16_t index = 0; index < count; ++index) {
+        combo_t *       combo = combo_get(index);
+        const uint16_t *keys  = combo->keys;
+        uint16_t        key;
+        while ((key = pgm_read_word(keys++)) != COMBO_END) {
+            combo_key_entries[combo_key_entry_count++] = (combo_key_entry_t){.keycode = key, .combo_index = index};
+        }
+        // Combos left dirty by a previous scan still need to be cleared
+        if (COMBO_STATE(combo) || COMBO_DISABLED(combo) || COMBO_ACTIVE(combo)) {
+            combo_touch(index);
+        }
+    }
+
+    qsort(combo_key_entries, combo_key_entry_count, sizeof(combo_key_entry_t), combo_key_entry_compare);
+
+    // A key listed twice in one combo must only be processed once
+    uint16_t unique = 0;
+    for (uint16_t i = 0; i < combo_key_entry_count; ++i) {
+        if (unique == 0 || combo_key_entry_compare(&combo_key_entries[unique - 1], &combo_key_entries[i]) != 0) {
+            combo_key_entries[unique++] = combo_key_entries[i];
+        }
+    }
+    combo_key_entry_count  = unique;
+    combo_key_index_combos = count;
+}
+
+static uint16_t combo_key_index_find(uint16_t keycode) {
+    // lower bound of keycode
+    uint16_t low = 0, high = combo_key_entry_count;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_key_entries[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+#endif
+
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_KEY_INDEX
+    if (combo_key_index_ready()) {
+        uint16_t remaining = 0;
+        for (uint16_t i = 0; i < combo_touched_count; ++i) {
+            index          = combo_touched[i];
+            combo_t *combo = combo_get(index);
+            if (!COMBO_ACTIVE(combo)) {
+                RESET_COMBO_STATE(combo);
+                combo_touched_bits[index / 8] &= ~(1 << (index & 7));
+            } else {
+                combo_touched[remaining++] = index;
+            }
+        }
+        combo_touched_count = remaining;
+        return;
+    }
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -242,7 +375,7 @@ static inline void dump_key_buffer(void) {
         // only delay once and for a non-tapping key
         if (!delay_done && !is_tap_record(record)) {
             delay_done = true;
-            wait_ms(TAP_CODE_DELAY);
+            output_queue_wait_ms(TAP_CODE_DELAY);
         }
 #endif
     }
@@ -558,10 +691,25 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEY_INDEX
+    if (!combo_key_index_ready()) {
+        combo_key_index_build();
+    }
+    if (combo_key_index_ready()) {
+        // Only combos containing this keycode can change state
+        for (uint16_t i = combo_key_index_find(keycode); i < combo_key_entry_count && combo_key_entries[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_key_entries[i].combo_index;
+            combo_touch(idx);
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -619,6 +767,16 @@ void combo_task(void) {
 #endif
 }
 
+void combo_next_deadline(uint32_t *deadline) {
+#ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        // combo_task() acts once the longest term has been exceeded
+        uint16_t elapsed = timer_elapsed(timer);
+        keyboard_update_deadline(deadline, timer_read32() + (elapsed > longest_term ? 0 : longest_term + 1 - elapsed));
+    }
+#endif
+}
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
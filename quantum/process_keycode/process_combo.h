@@ -73,6 +73,7 @@ typedef struct combo_t {
 
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
+void combo_next_deadline(uint32_t *deadline);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
 void combo_enable(void);
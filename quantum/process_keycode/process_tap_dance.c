@@ -37,7 +37,7 @@ void tap_dance_pair_reset(tap_dance_state_t *state, void *user_data) {
     tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
 
     if (state->count == 1) {
-        wait_ms(TAP_CODE_DELAY);
+        output_queue_wait_ms(TAP_CODE_DELAY);
         unregister_code16(pair->kc1);
     } else if (state->count == 2) {
         unregister_code16(pair->kc2);
@@ -67,7 +67,7 @@ void tap_dance_dual_role_reset(tap_dance_state_t *state, void *user_data) {
     tap_dance_dual_role_t *pair = (tap_dance_dual_role_t *)user_data;
 
     if (state->count == 1) {
-        wait_ms(TAP_CODE_DELAY);
+        output_queue_wait_ms(TAP_CODE_DELAY);
         unregister_code16(pair->kc);
     }
 }
@@ -173,6 +173,15 @@ void tap_dance_task(void) {
     }
 }
 
+void tap_dance_next_deadline(uint32_t *deadline) {
+    if (!active_td) return;
+
+    // tap_dance_task() finishes the dance once the tapping term has been exceeded
+    uint16_t elapsed = timer_elapsed(last_tap_time);
+    uint16_t term    = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+    keyboard_update_deadline(deadline, timer_read32() + (elapsed > term ? 0 : term + 1 - elapsed));
+}
+
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
     process_tap_dance_action_on_reset((tap_dance_action_t *)state);
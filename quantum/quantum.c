@@ -36,6 +36,10 @@
 #    include "haptic.h"
 #endif
 
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_BACK_CACHE)
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -100,9 +104,13 @@ __attribute__((weak)) void unregister_code16(uint16_t code) {
  */
 __attribute__((weak)) void tap_code16_delay(uint16_t code, uint16_t delay) {
     register_code16(code);
+#ifdef OUTPUT_QUEUE_ENABLE
+    output_queue_wait_ms(delay);
+#else
     for (uint16_t i = delay; i > 0; i--) {
         wait_ms(1);
     }
+#endif
     unregister_code16(code);
 }
 
@@ -162,6 +170,10 @@ void shutdown_quantum(void) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_BACK_CACHE)
+    // Anything held back in RAM would be lost over the reset
+    eeprom_driver_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -61,6 +61,8 @@
 #    include "deferred_exec.h"
 #endif
 
+#include "output_queue.h"
+
 extern layer_state_t default_layer_state;
 
 #ifndef NO_ACTION_LAYER
@@ -8,8 +8,8 @@ bool effect_runner_i(effect_params_t* params, i_f effect_func) {
     uint8_t time = scale16by8(g_rgb_timer, qadd8(rgb_matrix_config.speed / 4, 1));
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
-        RGB rgb = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, i, time));
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        RGB_MATRIX_RENDER_HSV(i, effect_func(rgb_matrix_config.hsv, i, time));
     }
+    RGB_MATRIX_RENDER_COMMIT();
     return rgb_matrix_check_finished_leds(led_max);
 }
@@ -34,6 +34,44 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+#ifdef RGB_MATRIX_BATCH_RENDER
+// Effects render a whole pass into these, and it is converted and handed to the driver in one go
+static HSV rgb_batch_hsv[RGB_MATRIX_BATCH_SIZE];
+static RGB rgb_batch_rgb[RGB_MATRIX_BATCH_SIZE];
+
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+    hsv_to_rgb_batch(hsv, rgb, count);
+}
+
+static void rgb_matrix_render_batch(effect_params_t *params, uint8_t led_min, uint8_t led_max) {
+    rgb_matrix_hsv_to_rgb_batch(rgb_batch_hsv, rgb_batch_rgb, led_max - led_min);
+
+    // Skip the LEDs the effect left alone, and send each run between them at once
+    uint8_t i = led_min;
+    while (i < led_max) {
+        if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) {
+            i++;
+            continue;
+        }
+        uint8_t start = i;
+        while (i < led_max && HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) {
+            i++;
+        }
+        rgb_matrix_set_color_batch(start, &rgb_batch_rgb[start - led_min], i - start);
+    }
+}
+
+#    define RGB_MATRIX_RENDER_HSV(i, color) rgb_batch_hsv[(i)-led_min] = (color)
+#    define RGB_MATRIX_RENDER_COMMIT() rgb_matrix_render_batch(params, led_min, led_max)
+#else
+#    define RGB_MATRIX_RENDER_HSV(i, color)                 \
+        do {                                                \
+            RGB rgb = rgb_matrix_hsv_to_rgb(color);         \
+            rgb_matrix_set_color((i), rgb.r, rgb.g, rgb.b); \
+        } while (0)
+#    define RGB_MATRIX_RENDER_COMMIT()
+#endif // RGB_MATRIX_BATCH_RENDER
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -204,6 +242,16 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
+void rgb_matrix_set_color_batch(int index, const RGB *colors, uint8_t count) {
+    if (rgb_matrix_driver.set_color_batch) {
+        rgb_matrix_driver.set_color_batch(index, colors, count);
+        return;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        rgb_matrix_set_color(index + i, colors[i].r, colors[i].g, colors[i].b);
+    }
+}
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -92,6 +92,15 @@
 #define RGB_MATRIX_TEST_LED_FLAGS() \
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
 
+#ifdef RGB_MATRIX_BATCH_RENDER
+// Large enough for the LEDs of a single render pass
+#    if RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#        define RGB_MATRIX_BATCH_SIZE (RGB_MATRIX_LED_PROCESS_LIMIT)
+#    else
+#        define RGB_MATRIX_BATCH_SIZE (RGB_MATRIX_LED_COUNT)
+#    endif
+#endif
+
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
 
@@ -125,6 +134,7 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_set_color_batch(int index, const RGB *colors, uint8_t count);
 
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
@@ -240,6 +250,8 @@ typedef struct {
     void (*set_color)(int index, uint8_t r, uint8_t g, uint8_t b);
     /* Set the colour of all LEDS on the keyboard in the buffer. */
     void (*set_color_all)(uint8_t r, uint8_t g, uint8_t b);
+    /* Optional: set the colours of `count` consecutive LEDs, starting at `index`, in the buffer. */
+    void (*set_color_batch)(int index, const RGB *colors, uint8_t count);
     /* Flush any buffered changes to the hardware. */
     void (*flush)(void);
 } rgb_matrix_driver_t;
@@ -14,11 +14,12 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "rgb_matrix.h"
 
 /* Each driver needs to define the struct
  *    const rgb_matrix_driver_t rgb_matrix_driver;
- * All members must be provided.
+ * All members must be provided, except for set_color_batch.
  * Keyboard custom drivers can define this in their own files, it should only
  * be here if shared between boards.
  */
@@ -462,10 +463,47 @@ static void setled_all(uint8_t r, uint8_t g, uint8_t b) {
     }
 }
 
+// Copy a run of consecutive leds into the buffer
+static void setled_batch(int index, const RGB *colors, uint8_t count) {
+    int end = index + count;
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+    // Keep the part of the run on this half, relative to the start of this half's leds
+    const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+    int           start                 = 0;
+    if (!is_keyboard_left()) {
+        start = k_rgb_matrix_split[0];
+    } else if (end > k_rgb_matrix_split[0]) {
+        end = k_rgb_matrix_split[0];
+    }
+    if (index < start) {
+        colors += start - index;
+        index = start;
+    }
+    if (index >= end) {
+        return;
+    }
+    index -= start;
+    end -= start;
+#    endif
+
+#    ifdef RGBW
+    for (LED_TYPE *led = &rgb_matrix_ws2812_array[index]; led < &rgb_matrix_ws2812_array[end]; led++, colors++) {
+        led->r = colors->r;
+        led->g = colors->g;
+        led->b = colors->b;
+        convert_rgb_to_rgbw(led);
+    }
+#    else
+    // Without a white channel, LED_TYPE is RGB
+    memcpy(&rgb_matrix_ws2812_array[index], colors, (end - index) * sizeof(RGB));
+#    endif
+}
+
 const rgb_matrix_driver_t rgb_matrix_driver = {
-    .init          = init,
-    .flush         = flush,
-    .set_color     = setled,
-    .set_color_all = setled_all,
+    .init            = init,
+    .flush           = flush,
+    .set_color       = setled,
+    .set_color_all   = setled_all,
+    .set_color_batch = setled_batch,
 };
 #endif
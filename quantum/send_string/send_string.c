@@ -22,7 +22,12 @@
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
+#include "action_util.h"
 #include "wait.h"
+#include "timer.h"
+#include "host.h"
+#include "keycode_config.h"
+#include "output_queue.h"
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -32,6 +37,16 @@
 float bell_song[][2] = SONG(BELL_SOUND);
 #endif
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    ifndef SEND_STRING_ASYNC_REPORT_INTERVAL
+#        define SEND_STRING_ASYNC_REPORT_INTERVAL 1
+#    endif
+
+#    ifndef SEND_STRING_ASYNC_MAX_KEYS
+#        define SEND_STRING_ASYNC_MAX_KEYS 1
+#    endif
+#endif
+
 // clang-format off
 
 /* Bit-Packed look-up table to convert an ASCII character to whether
@@ -177,22 +192,269 @@ void send_string_with_delay(const char *string, uint8_t interval) {
                     ms += keycode - '0';
                     keycode = *(++string);
                 }
-                while (ms--)
-                    wait_ms(1);
+                output_queue_wait_ms(ms);
             }
         } else {
             send_char(ascii_code);
         }
         ++string;
         // interval
-        {
-            uint8_t ms = interval;
-            while (ms--)
-                wait_ms(1);
+        output_queue_wait_ms(interval);
+    }
+}
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+/*
+    Strings typed in the background are typed from send_string_task() a step at a time, each step sending at most one
+    report, SEND_STRING_ASYNC_REPORT_INTERVAL milliseconds or more apart. Modifiers go in a report of their own, as with
+    register_code16(), but are held while consecutive characters need the same ones.
+
+    With SEND_STRING_ASYNC_MAX_KEYS above 1, NKRO, and no interval, a run of up to that many characters needing the same
+    modifiers is pressed in one report as long as their keycodes ascend. That relies on the host acting on the keys of
+    an NKRO report in keycode order, which common hosts do but nothing guarantees, so it is opt-in.
+
+    The report is shared with the keys being held down, so a character whose key is already held is left as it is:
+    playback neither presses it again nor releases it afterwards, which would let go of the key under the user's finger.
+*/
+static struct {
+    const char *string;     // Next character to type, NULL when not typing
+    bool        progmem;    // Whether string points into PROGMEM
+    bool        dead_space; // A dead key was typed, and still needs a space after it
+    uint8_t     interval;   // Milliseconds to wait after each character
+    uint8_t     mods;       // Weak mods held for the characters being typed
+    uint8_t     tapped;     // Keycode pressed by the last step's SS_TAP(), released by the next
+    uint8_t     key_count;  // Keys pressed by the last step, released by the next
+    uint8_t     keys[SEND_STRING_ASYNC_MAX_KEYS];
+    bool        added[SEND_STRING_ASYNC_MAX_KEYS]; // Whether playback added the key, rather than finding it held
+    uint32_t    next_step;  // When the next step is due
+} async;
+
+static inline char async_read(const char *string) {
+#    if defined(__AVR__)
+    if (async.progmem) {
+        return pgm_read_byte(string);
+    }
+#    endif
+    return *string;
+}
+
+static inline bool async_is_plain(char ascii_code) {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') {
+        return false;
+    }
+#    endif
+    return ascii_code && ascii_code != SS_QMK_PREFIX;
+}
+
+static inline uint8_t async_char_mods(char ascii_code) {
+    return (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code) ? MOD_BIT(KC_LEFT_SHIFT) : 0) | (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code) ? MOD_BIT(KC_RIGHT_ALT) : 0);
+}
+
+static inline bool async_key_held(uint8_t keycode) {
+    return IS_BASIC_KEYCODE(keycode) && is_key_pressed(keyboard_report, keycode);
+}
+
+static inline bool async_can_pack(void) {
+#    ifdef NKRO_ENABLE
+    return async.interval == 0 && keyboard_protocol && keymap_config.nkro;
+#    else
+    return false;
+#    endif
+}
+
+static void async_wait(uint16_t ms) {
+    async.next_step = timer_read32() + (ms > SEND_STRING_ASYNC_REPORT_INTERVAL ? ms : SEND_STRING_ASYNC_REPORT_INTERVAL);
+}
+
+/* Adds the next character, or the space owed after a dead key, to the keys being pressed. */
+static void async_press_char(char ascii_code) {
+    uint8_t keycode              = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    async.keys[async.key_count]  = keycode;
+    async.added[async.key_count] = !async_key_held(keycode);
+    if (async.added[async.key_count++]) {
+        add_key(keycode);
+    }
+    if (async.dead_space) {
+        async.dead_space = false;
+    } else {
+        async.string++;
+        async.dead_space = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+    }
+}
+
+static void send_string_async_step(void) {
+    // Release whatever the last step pressed
+    if (async.tapped != KC_NO) {
+        unregister_code(async.tapped);
+        async.tapped = KC_NO;
+        async_wait(async.interval);
+        return;
+    }
+    if (async.key_count > 0) {
+        for (uint8_t i = 0; i < async.key_count; i++) {
+            if (async.added[i]) {
+                del_key(async.keys[i]);
+            }
+        }
+        async.key_count = 0;
+        send_keyboard_report();
+        async_wait(async.interval);
+        return;
+    }
+
+    char ascii_code = async.dead_space ? ' ' : async_read(async.string);
+
+    // Characters without a keycode are skipped, as tap_code(KC_NO) sends nothing
+    if (async_is_plain(ascii_code) && pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]) == KC_NO) {
+        async.string++;
+        return;
+    }
+
+    // Change the modifiers held before the keys which need them, and release them before anything else
+    uint8_t mods = async_is_plain(ascii_code) ? async_char_mods(ascii_code) : 0;
+    if (mods != async.mods) {
+        del_weak_mods(async.mods);
+        add_weak_mods(mods);
+        async.mods = mods;
+        send_keyboard_report();
+        async_wait(0);
+        return;
+    }
+
+    if (!ascii_code) {
+        async.string = NULL;
+        return;
+    }
+
+    if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code       = async_read(++async.string);
+        uint8_t  keycode = async_read(++async.string);
+        uint16_t ms      = async.interval;
+        if (ascii_code == SS_TAP_CODE) {
+            if (!async_key_held(keycode)) {
+                register_code(keycode);
+                async.tapped = keycode;
+            }
+            ms = keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY;
+        } else if (ascii_code == SS_DOWN_CODE) {
+            register_code(keycode);
+        } else if (ascii_code == SS_UP_CODE) {
+            unregister_code(keycode);
+        } else if (ascii_code == SS_DELAY_CODE) {
+            uint16_t delay = 0;
+            while (isdigit(keycode)) {
+                delay *= 10;
+                delay += keycode - '0';
+                keycode = async_read(++async.string);
+            }
+            ms += delay;
+        }
+        async.string++;
+        async_wait(ms);
+        return;
+    }
+
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        PLAY_SONG(bell_song);
+        async.string++;
+        async_wait(async.interval);
+        return;
+    }
+#    endif
+
+    async_press_char(ascii_code);
+    while (async_can_pack() && !async.dead_space && async.key_count < SEND_STRING_ASYNC_MAX_KEYS) {
+        ascii_code = async_read(async.string);
+        if (!async_is_plain(ascii_code) || async_char_mods(ascii_code) != async.mods || pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]) <= async.keys[async.key_count - 1]) {
+            break;
         }
+        async_press_char(ascii_code);
     }
+    // A key press elsewhere clears weak mods, so they're set again with every press
+    add_weak_mods(async.mods);
+    send_keyboard_report();
+    async_wait(TAP_CODE_DELAY);
+}
+
+void send_string_async(const char *string) {
+    send_string_async_with_delay(string, 0);
+}
+
+static void send_string_async_start(const char *string, uint8_t interval, bool progmem) {
+    send_string_async_wait();
+    async.string     = string;
+    async.progmem    = progmem;
+    async.interval   = interval;
+    async.dead_space = false;
+    async.next_step  = timer_read32();
+    send_string_task();
+}
+
+void send_string_async_with_delay(const char *string, uint8_t interval) {
+    send_string_async_start(string, interval, false);
+}
+
+bool send_string_async_active(void) {
+    return async.string != NULL;
 }
 
+void send_string_async_wait(void) {
+    while (async.string) {
+        send_string_task();
+        if (async.string) {
+            wait_ms(1);
+        }
+    }
+}
+
+void send_string_async_stop(void) {
+    if (!async.string) {
+        return;
+    }
+    if (async.tapped != KC_NO) {
+        unregister_code(async.tapped);
+    }
+    for (uint8_t i = 0; i < async.key_count; i++) {
+        if (async.added[i]) {
+            del_key(async.keys[i]);
+        }
+    }
+    del_weak_mods(async.mods);
+    send_keyboard_report();
+    async.tapped     = KC_NO;
+    async.key_count  = 0;
+    async.mods       = 0;
+    async.dead_space = false;
+    async.string     = NULL;
+}
+
+void send_string_task(void) {
+    while (async.string && timer_expired32(timer_read32(), async.next_step)) {
+        send_string_async_step();
+    }
+}
+
+bool send_string_async_next_step(uint32_t *step_time) {
+    if (!async.string) {
+        return false;
+    }
+    *step_time = async.next_step;
+    return true;
+}
+
+#    if defined(__AVR__)
+void send_string_async_P(const char *string) {
+    send_string_async_with_delay_P(string, 0);
+}
+
+void send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    send_string_async_start(string, interval, true);
+}
+#    endif
+#endif // SEND_STRING_ASYNC_ENABLE
+
 void send_char(char ascii_code) {
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
     if (ascii_code == '\a') { // BEL
@@ -310,19 +572,14 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
                     ms += keycode - '0';
                     keycode = pgm_read_byte(++string);
                 }
-                while (ms--)
-                    wait_ms(1);
+                output_queue_wait_ms(ms);
             }
         } else {
             send_char(ascii_code);
         }
         ++string;
         // interval
-        {
-            uint8_t ms = interval;
-            while (ms--)
-                wait_ms(1);
-        }
+        output_queue_wait_ms(interval);
     }
 }
 #endif
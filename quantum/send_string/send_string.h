@@ -23,6 +23,7 @@
  * \{
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "progmem.h"
@@ -151,4 +152,89 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+/**
+ * \brief Type out a string of ASCII characters in the background.
+ *
+ * This function simply calls `send_string_async_with_delay(string, 0)`.
+ *
+ * \param string The string to type out. It must remain valid until it has been typed.
+ */
+void send_string_async(const char *string);
+
+/**
+ * \brief Type out a string of ASCII characters in the background, with a delay between each character.
+ *
+ * Rather than blocking until the whole string has been typed, this returns straight away, and the string is typed from
+ * the main loop one report at a time, so the keyboard keeps working meanwhile. With SEND_STRING_ASYNC_MAX_KEYS above 1,
+ * NKRO, and no delay, consecutive characters needing the same modifiers are pressed together where the host should
+ * still see them in order.
+ *
+ * If a string is already being typed in the background, it is finished first.
+ *
+ * \param string The string to type out. It must remain valid until it has been typed.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_async_with_delay(const char *string, uint8_t interval);
+
+/**
+ * \brief Whether a string is being typed in the background.
+ */
+bool send_string_async_active(void);
+
+/**
+ * \brief Block until the string being typed in the background has been typed.
+ */
+void send_string_async_wait(void);
+
+/**
+ * \brief Stop typing the string being typed in the background, releasing anything it holds down.
+ */
+void send_string_async_stop(void);
+
+/**
+ * \brief Type the next part of the string being typed in the background, if due.
+ */
+void send_string_task(void);
+
+/**
+ * \brief Report when send_string_task() next has something to do.
+ *
+ * \param step_time The time the next step is due, in the time-space of timer_read32().
+ * \return true if a string is being typed in the background.
+ */
+bool send_string_async_next_step(uint32_t *step_time);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Type out a PROGMEM string of ASCII characters in the background.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, 0).
+ *
+ * \param string The string to type out.
+ */
+void send_string_async_P(const char *string);
+
+/**
+ * \brief Type out a PROGMEM string of ASCII characters in the background, with a delay between each character.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_async_with_delay_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_async_P(string) send_string_async_with_delay(string, 0)
+#        define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ *
+ * On ARM devices, this define evaluates to send_string_async_with_delay(string, 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+#endif
+
 /** \} */
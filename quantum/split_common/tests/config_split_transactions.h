@@ -0,0 +1,10 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 8
+#define MATRIX_COLS 8
+
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_TRANSACTION_STATS
+#define DISABLE_SYNC_TIMER
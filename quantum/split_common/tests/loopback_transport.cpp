@@ -0,0 +1,87 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "loopback_transport.hpp"
+
+#include <cstring>
+#include <initializer_list>
+
+#define sizeof_member(type, member) sizeof(((type *)NULL)->member)
+#define region(member) \
+    { offsetof(LoopbackShmem, member), sizeof_member(LoopbackShmem, member) }
+
+#define unused \
+    { 0, 0 }
+
+// In the order of LoopbackRegion, each transaction only carries data in one direction
+// clang-format off
+const split_delta_region_t loopback_m2s_regions[NUM_LOOPBACK_REGIONS] = {
+    unused, unused, unused, unused,
+    region(sync_timer), region(layer_state), region(default_layer_state), region(mods), region(rgb_matrix), region(wpm), region(activity),
+};
+
+const split_delta_region_t loopback_s2m_regions[NUM_LOOPBACK_REGIONS] = {
+    region(smatrix_checksum), region(smatrix), region(encoders_checksum), region(encoders),
+    unused, unused, unused, unused, unused, unused, unused,
+};
+// clang-format on
+
+LoopbackTransport::LoopbackTransport(uint8_t frame_size) : frame_size(frame_size) {
+    setup(master, master_shmem, master_shadow, true);
+    setup(slave, slave_shmem, slave_shadow, false);
+}
+
+void LoopbackTransport::setup(split_delta_t &state, LoopbackShmem &shmem, LoopbackShmem &shadow, bool is_master) {
+    memset(&shadow, 0, sizeof(shadow));
+    state.shmem        = (uint8_t *)&shmem;
+    state.shadow       = (uint8_t *)&shadow;
+    state.tx_regions   = is_master ? loopback_m2s_regions : loopback_s2m_regions;
+    state.rx_regions   = is_master ? loopback_s2m_regions : loopback_m2s_regions;
+    state.region_count = NUM_LOOPBACK_REGIONS;
+    split_delta_init(&state);
+}
+
+void LoopbackTransport::restart_slave() {
+    memset(&slave_shmem, 0, sizeof(slave_shmem));
+    setup(slave, slave_shmem, slave_shadow, false);
+}
+
+bool LoopbackTransport::exchange(Fault fault) {
+    exchanges++;
+
+    request_size  = split_delta_encode(&master, request, frame_size);
+    response_size = 0;
+    bytes += request_size;
+    if (fault == Fault::corrupt_request) {
+        request[request_size / 2] ^= 0x5A;
+    }
+
+    if (fault != Fault::drop_request) {
+        // The slave callback
+        split_delta_decode(&slave, request, frame_size);
+        response_size = split_delta_encode(&slave, response, frame_size);
+        bytes += response_size;
+        if (fault == Fault::corrupt_response) {
+            response[response_size / 2] ^= 0x5A;
+        }
+    }
+
+    bool okay = fault != Fault::drop_request && fault != Fault::drop_response && split_delta_decode(&master, response, frame_size);
+    if (!okay) {
+        split_delta_lost(&master);
+    }
+    return okay;
+}
+
+bool LoopbackTransport::in_sync() const {
+    auto master_bytes = (const uint8_t *)&master_shmem;
+    auto slave_bytes  = (const uint8_t *)&slave_shmem;
+    for (uint8_t index = 0; index < NUM_LOOPBACK_REGIONS; index++) {
+        for (auto &region : {loopback_m2s_regions[index], loopback_s2m_regions[index]}) {
+            if (memcmp(&master_bytes[region.offset], &slave_bytes[region.offset], region.size) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
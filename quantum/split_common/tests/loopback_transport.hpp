@@ -0,0 +1,82 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+#include "transport_delta.h"
+}
+
+/* Loosely follows split_shared_memory_t, with a mix of master-to-slave and slave-to-master transactions. */
+struct LoopbackShmem {
+    uint8_t  smatrix_checksum;
+    uint16_t smatrix[8];
+    uint8_t  encoders_checksum;
+    uint8_t  encoders[4];
+    uint32_t sync_timer;
+    uint32_t layer_state;
+    uint32_t default_layer_state;
+    uint8_t  mods[4];
+    uint8_t  rgb_matrix[12];
+    uint8_t  wpm;
+    uint8_t  activity[12];
+};
+
+enum LoopbackRegion : uint8_t {
+    GET_SLAVE_MATRIX_CHECKSUM,
+    GET_SLAVE_MATRIX_DATA,
+    GET_ENCODERS_CHECKSUM,
+    GET_ENCODERS_DATA,
+    PUT_SYNC_TIMER,
+    PUT_LAYER_STATE,
+    PUT_DEFAULT_LAYER_STATE,
+    PUT_MODS,
+    PUT_RGB_MATRIX,
+    PUT_WPM,
+    PUT_ACTIVITY,
+    NUM_LOOPBACK_REGIONS
+};
+
+extern const split_delta_region_t loopback_m2s_regions[NUM_LOOPBACK_REGIONS];
+extern const split_delta_region_t loopback_s2m_regions[NUM_LOOPBACK_REGIONS];
+
+/* Stands in for the serial link and both halves of the delta transport: one exchange runs encode on the master,
+ * decode and encode in the slave callback, and decode back on the master. Frames can be dropped or corrupted on
+ * the way, either direction. */
+class LoopbackTransport {
+   public:
+    enum class Fault { none, drop_request, corrupt_request, drop_response, corrupt_response };
+
+    explicit LoopbackTransport(uint8_t frame_size = 128);
+
+    /* Returns whether the master got a valid reply, like the exchange handler does. */
+    bool exchange(Fault fault = Fault::none);
+
+    /* Power cycles the slave, losing its shared memory along with the transport state. */
+    void restart_slave();
+
+    /* Whether each side holds what the other side last wrote, for every region. */
+    bool in_sync() const;
+
+    LoopbackShmem master_shmem = {};
+    LoopbackShmem slave_shmem  = {};
+
+    size_t  exchanges     = 0;
+    size_t  bytes         = 0;
+    uint8_t request_size  = 0;
+    uint8_t response_size = 0;
+
+   private:
+    void setup(split_delta_t &state, LoopbackShmem &shmem, LoopbackShmem &shadow, bool is_master);
+
+    const uint8_t frame_size;
+    split_delta_t master = {};
+    split_delta_t slave  = {};
+    LoopbackShmem master_shadow;
+    LoopbackShmem slave_shadow;
+    uint8_t       request[UINT8_MAX];
+    uint8_t       response[UINT8_MAX];
+};
@@ -0,0 +1,22 @@
+transport_delta_INC := \
+	$(QUANTUM_PATH)/split_common/tests \
+	$(QUANTUM_PATH)/split_common
+transport_delta_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/loopback_transport.cpp \
+	$(QUANTUM_PATH)/split_common/tests/transport_delta_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transport_delta.c \
+	$(QUANTUM_PATH)/crc.c
+
+split_transactions_DEFS := -DSPLIT_KEYBOARD -DSPLIT_COMMON_TRANSACTIONS -DSERIAL_DRIVER_USART
+split_transactions_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_split_transactions.h
+split_transactions_INC := \
+	$(QUANTUM_PATH)/split_common/tests \
+	$(QUANTUM_PATH)/split_common
+split_transactions_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/simulated_slave.cpp \
+	$(QUANTUM_PATH)/split_common/tests/split_transactions_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/split_common/transaction_stats.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
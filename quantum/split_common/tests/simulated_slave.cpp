@@ -0,0 +1,58 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "simulated_slave.hpp"
+
+#include <cstring>
+
+extern "C" {
+#include "crc.h"
+#include "serial.h"
+#include "split_util.h"
+
+void advance_time(uint32_t ms);
+}
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 0;
+
+SimulatedSlave& SimulatedSlave::instance() {
+    static SimulatedSlave slave;
+    return slave;
+}
+
+void SimulatedSlave::reset() {
+    memset(&shmem, 0, sizeof(shmem));
+    transfer_ms            = 0;
+    fail_next              = 0;
+    transactions           = 0;
+    shmem.smatrix.checksum = crc8(shmem.smatrix.matrix, sizeof(shmem.smatrix.matrix));
+}
+
+void SimulatedSlave::set_matrix(matrix_row_t row, matrix_row_t value) {
+    shmem.smatrix.matrix[row] = value;
+    shmem.smatrix.checksum    = crc8(shmem.smatrix.matrix, sizeof(shmem.smatrix.matrix));
+}
+
+extern "C" void soft_serial_initiator_init(void) {}
+
+extern "C" void soft_serial_target_init(void) {}
+
+extern "C" bool soft_serial_transaction(int index) {
+    SimulatedSlave& slave = SimulatedSlave::instance();
+    slave.transactions++;
+    advance_time(slave.transfer_ms);
+    if (slave.fail_next > 0) {
+        slave.fail_next--;
+        return false;
+    }
+
+    split_transaction_desc_t* trans = &split_transaction_table[index];
+    memcpy((uint8_t*)&slave.shmem + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    memcpy(split_trans_target2initiator_buffer(trans), (uint8_t*)&slave.shmem + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+    return true;
+}
+
+extern "C" bool is_transport_connected(void) {
+    return true;
+}
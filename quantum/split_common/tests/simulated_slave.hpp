@@ -0,0 +1,25 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+
+extern "C" {
+#include "transactions.h"
+}
+
+/* Stands in for the serial driver and the slave half: every transaction moves its buffers between the master's shared
+ * memory and a separate copy held by the slave, after taking `transfer_ms` on the test clock. */
+class SimulatedSlave {
+   public:
+    static SimulatedSlave& instance();
+
+    void reset();
+    void set_matrix(matrix_row_t row, matrix_row_t value);
+
+    split_shared_memory_t shmem        = {};
+    uint32_t              transfer_ms  = 0;
+    int                   fail_next    = 0; // the next transactions to fail
+    uint32_t              transactions = 0;
+};
@@ -0,0 +1,166 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <string>
+#include "simulated_slave.hpp"
+
+extern "C" {
+#include "transaction_stats.h"
+
+void advance_time(uint32_t ms);
+}
+
+#ifndef FORCED_SYNC_THROTTLE_MS
+#    define FORCED_SYNC_THROTTLE_MS 100
+#endif
+
+namespace {
+
+uint32_t be32(const uint8_t *data) {
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+uint16_t be16(const uint8_t *data) {
+    return (data[0] << 8) | data[1];
+}
+
+} // namespace
+
+class SplitTransactions : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[MATRIX_ROWS / 2] = {0};
+    matrix_row_t slave_matrix[MATRIX_ROWS / 2]  = {0};
+
+    void SetUp() override {
+        SimulatedSlave::instance().reset();
+        layer_state = 0;
+        // Run out the forced sync, so every test starts with both halves in sync
+        advance_time(FORCED_SYNC_THROTTLE_MS);
+        ASSERT_TRUE(scan());
+        split_transaction_stats_reset();
+        SimulatedSlave::instance().transactions = 0;
+    }
+
+    /* One scan's worth of split transactions, a millisecond apart. */
+    bool scan() {
+        advance_time(1);
+        return transactions_master(master_matrix, slave_matrix);
+    }
+
+    const split_transaction_stats_t &stats(int8_t id) {
+        return *split_transaction_stats_get(id);
+    }
+};
+
+TEST_F(SplitTransactions, IdleScansSkipTransfers) {
+    for (int i = 0; i < 50; i++) {
+        ASSERT_TRUE(scan());
+    }
+
+    // Only the checksum of the slave matrix goes over the wire
+    EXPECT_EQ(stats(GET_SLAVE_MATRIX_CHECKSUM).transfers, 50);
+    EXPECT_EQ(stats(GET_SLAVE_MATRIX_DATA).transfers, 0);
+    EXPECT_EQ(stats(GET_SLAVE_MATRIX_DATA).skips, 50);
+    EXPECT_EQ(stats(PUT_LAYER_STATE).transfers, 0);
+    EXPECT_EQ(stats(PUT_LAYER_STATE).skips, 50);
+    EXPECT_EQ(SimulatedSlave::instance().transactions, 50);
+}
+
+TEST_F(SplitTransactions, ForcedSyncsAreTransfers) {
+    for (int i = 0; i < 2 * FORCED_SYNC_THROTTLE_MS + 50; i++) {
+        ASSERT_TRUE(scan());
+    }
+
+    for (int8_t id : {GET_SLAVE_MATRIX_DATA, PUT_LAYER_STATE, PUT_DEFAULT_LAYER_STATE}) {
+        EXPECT_EQ(stats(id).transfers, 2) << "transaction " << +id;
+        EXPECT_EQ(stats(id).transfers + stats(id).skips, 2 * FORCED_SYNC_THROTTLE_MS + 50) << "transaction " << +id;
+    }
+}
+
+TEST_F(SplitTransactions, ChangesAreTransferred) {
+    SimulatedSlave::instance().set_matrix(1, 0x10);
+    layer_state = 0x04;
+    ASSERT_TRUE(scan());
+
+    EXPECT_EQ(slave_matrix[1], 0x10);
+    EXPECT_EQ(SimulatedSlave::instance().shmem.layers.layer_state, 0x04);
+    EXPECT_EQ(stats(GET_SLAVE_MATRIX_DATA).transfers, 1);
+    EXPECT_EQ(stats(GET_SLAVE_MATRIX_DATA).skips, 0);
+    EXPECT_EQ(stats(PUT_LAYER_STATE).transfers, 1);
+    EXPECT_EQ(stats(PUT_DEFAULT_LAYER_STATE).skips, 1);
+}
+
+TEST_F(SplitTransactions, FailuresAndRetriesAreCounted) {
+    SimulatedSlave::instance().fail_next = 3;
+    ASSERT_TRUE(scan());
+
+    auto &checksum = stats(GET_SLAVE_MATRIX_CHECKSUM);
+    EXPECT_EQ(checksum.transfers, 4);
+    EXPECT_EQ(checksum.failures, 3);
+    EXPECT_EQ(checksum.retries, 3);
+
+    // A transfer after a successful one is no retry
+    ASSERT_TRUE(scan());
+    EXPECT_EQ(checksum.transfers, 5);
+    EXPECT_EQ(checksum.retries, 3);
+}
+
+TEST_F(SplitTransactions, DurationsAreBucketed) {
+    ASSERT_TRUE(scan());
+    SimulatedSlave::instance().transfer_ms = 2;
+    ASSERT_TRUE(scan());
+    ASSERT_TRUE(scan());
+
+    auto &checksum = stats(GET_SLAVE_MATRIX_CHECKSUM);
+    EXPECT_EQ(checksum.max_us, 2000);
+    EXPECT_EQ(checksum.histogram[0], 1);
+    // 2000us lands in the bucket for 1024us up to 2048us
+    EXPECT_EQ(checksum.histogram[5], 2);
+}
+
+TEST_F(SplitTransactions, RawHidQuery) {
+    SimulatedSlave::instance().fail_next = 1;
+    SimulatedSlave::instance().set_matrix(0, 0x01);
+    ASSERT_TRUE(scan());
+
+    uint8_t data[30] = {GET_SLAVE_MATRIX_CHECKSUM, 0};
+    split_transaction_stats_raw_hid(data, sizeof(data));
+    EXPECT_EQ(data[1], 0);
+    EXPECT_EQ(data[2], NUM_TOTAL_TRANSACTIONS);
+    EXPECT_EQ(be32(&data[3]), 2);  // transfers
+    EXPECT_EQ(be32(&data[7]), 1);  // failures
+    EXPECT_EQ(be32(&data[11]), 1); // retries
+    EXPECT_EQ(be32(&data[15]), 0); // skips
+    EXPECT_EQ(be32(&data[19]), 0); // max_us
+
+    uint8_t histogram[30] = {GET_SLAVE_MATRIX_DATA, 1};
+    split_transaction_stats_raw_hid(histogram, sizeof(histogram));
+    EXPECT_EQ(histogram[1], 1);
+    EXPECT_EQ(histogram[2], SPLIT_TRANSACTION_STATS_BUCKETS);
+    EXPECT_EQ(be16(&histogram[3]), SPLIT_TRANSACTION_STATS_BUCKET_US);
+    EXPECT_EQ(be16(&histogram[5]), 1);
+
+    uint8_t unknown_transaction[30] = {NUM_TOTAL_TRANSACTIONS, 0};
+    split_transaction_stats_raw_hid(unknown_transaction, sizeof(unknown_transaction));
+    EXPECT_EQ(unknown_transaction[1], 0xFF);
+
+    uint8_t unknown_page[30] = {GET_SLAVE_MATRIX_DATA, 2};
+    split_transaction_stats_raw_hid(unknown_page, sizeof(unknown_page));
+    EXPECT_EQ(unknown_page[1], 0xFF);
+}
+
+TEST_F(SplitTransactions, ConsoleListsUsedTransactions) {
+    ASSERT_TRUE(scan());
+
+    testing::internal::CaptureStdout();
+    split_transaction_stats_print();
+    std::string console = testing::internal::GetCapturedStdout();
+
+    // The header, then the slave matrix checksum and data, and both layer states
+    EXPECT_EQ(std::count(console.begin(), console.end(), '\n'), 5) << console;
+    EXPECT_EQ(GET_SLAVE_MATRIX_CHECKSUM, 0);
+    EXPECT_NE(console.find("split:  0         1        0       0     0      0 | 1 0 0 0 0 0 0 0\n"), std::string::npos) << console;
+    EXPECT_NE(console.find("split:  1         0        0       0     1      0 | 0 0 0 0 0 0 0 0\n"), std::string::npos) << console;
+}
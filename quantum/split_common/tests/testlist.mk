@@ -0,0 +1,2 @@
+TEST_LIST += transport_delta
+TEST_LIST += split_transactions
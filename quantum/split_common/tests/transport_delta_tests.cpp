@@ -0,0 +1,257 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <random>
+#include "loopback_transport.hpp"
+
+extern "C" {
+#include "crc.h"
+}
+
+namespace {
+
+// An empty frame: the header and the checksum
+constexpr uint8_t empty_frame = SPLIT_DELTA_HEADER_SIZE + 1;
+
+// A whole-struct transaction sends the id, gets the handshake back, then moves its buffer. The line turns around
+// twice, whether the buffer goes to the slave or comes back from it.
+constexpr size_t legacy_handshake_bytes       = 2;
+constexpr size_t legacy_turnarounds_per_trans = 2;
+// An exchange moves a buffer in each direction after the handshake
+constexpr size_t delta_turnarounds_per_exchange = 4;
+
+/* Counts what transactions_master() would have done without the delta transport to bring the slave up to date. */
+struct LegacyCost {
+    size_t transactions = 0;
+    size_t bytes        = 0;
+
+    void scan(const LoopbackShmem &master_before, const LoopbackShmem &master_after, const LoopbackShmem &slave_before, const LoopbackShmem &slave_after) {
+        auto changed = [](const LoopbackShmem &before, const LoopbackShmem &after, const split_delta_region_t &region) {
+            return memcmp((const uint8_t *)&before + region.offset, (const uint8_t *)&after + region.offset, region.size) != 0;
+        };
+        // Writes only go out when the data changed
+        for (auto &region : loopback_m2s_regions) {
+            if (region.size && changed(master_before, master_after, region)) {
+                transactions++;
+                bytes += legacy_handshake_bytes + region.size;
+            }
+        }
+        // Reads always fetch the checksum, and the data only if it changed
+        for (auto data : {GET_SLAVE_MATRIX_DATA, GET_ENCODERS_DATA}) {
+            auto &region = loopback_s2m_regions[data];
+            transactions++;
+            bytes += legacy_handshake_bytes + 1;
+            if (changed(slave_before, slave_after, region)) {
+                transactions++;
+                bytes += legacy_handshake_bytes + region.size;
+            }
+        }
+    }
+};
+
+void update_checksums(LoopbackShmem &shmem) {
+    shmem.smatrix_checksum  = crc8(shmem.smatrix, sizeof(shmem.smatrix));
+    shmem.encoders_checksum = crc8(shmem.encoders, sizeof(shmem.encoders));
+}
+
+/* Random changes to both sides, touching a few bytes of a few regions, like a scan would. */
+void mutate(std::mt19937 &rng, LoopbackShmem &master, LoopbackShmem &slave) {
+    for (int changes = rng() % 4; changes > 0; changes--) {
+        auto &regions = (rng() % 2) ? loopback_m2s_regions : loopback_s2m_regions;
+        auto &region  = regions[rng() % NUM_LOOPBACK_REGIONS];
+        if (!region.size) {
+            continue;
+        }
+        auto bytes = (uint8_t *)((&regions == &loopback_m2s_regions) ? &master : &slave) + region.offset;
+        bytes[rng() % region.size] = rng();
+    }
+    update_checksums(slave);
+}
+
+} // namespace
+
+class TransportDelta : public ::testing::Test {
+   protected:
+    LoopbackTransport link;
+
+    void SetUp() override {
+        link.master_shmem.layer_state   = 0x10;
+        link.master_shmem.rgb_matrix[0] = 0x42;
+        link.slave_shmem.smatrix[2]     = 0x0100;
+        update_checksums(link.slave_shmem);
+        ASSERT_TRUE(link.exchange());
+        ASSERT_TRUE(link.in_sync());
+    }
+};
+
+TEST_F(TransportDelta, FirstExchangeSendsEverything) {
+    LoopbackTransport fresh;
+    fresh.exchange();
+    size_t m2s = 0, s2m = 0;
+    for (uint8_t index = 0; index < NUM_LOOPBACK_REGIONS; index++) {
+        m2s += loopback_m2s_regions[index].size ? 1 + loopback_m2s_regions[index].size : 0;
+        s2m += loopback_s2m_regions[index].size ? 1 + loopback_s2m_regions[index].size : 0;
+    }
+    EXPECT_EQ(fresh.request_size, empty_frame + m2s);
+    EXPECT_EQ(fresh.response_size, empty_frame + s2m);
+}
+
+TEST_F(TransportDelta, UnchangedStateSendsEmptyFrames) {
+    EXPECT_TRUE(link.exchange());
+    EXPECT_EQ(link.request_size, empty_frame);
+    EXPECT_EQ(link.response_size, empty_frame);
+}
+
+TEST_F(TransportDelta, KeyPressSendsChangedBytesOnly) {
+    link.slave_shmem.smatrix[5] = 0x0004;
+    update_checksums(link.slave_shmem);
+    EXPECT_TRUE(link.exchange());
+    EXPECT_TRUE(link.in_sync());
+
+    // The checksum goes in full, being a single byte, the matrix as a run of the one byte that changed
+    EXPECT_EQ(link.response_size, empty_frame + (1 + 1) + (1 + 1 + 2 + 1));
+    EXPECT_EQ(link.request_size, empty_frame);
+}
+
+TEST_F(TransportDelta, NearbyChangesShareARun) {
+    // Two changed bytes with two unchanged ones between them
+    link.master_shmem.rgb_matrix[3] = 1;
+    link.master_shmem.rgb_matrix[6] = 1;
+    EXPECT_TRUE(link.exchange());
+    EXPECT_EQ(link.request_size, empty_frame + (1 + 1 + 2 + 4));
+
+    // With three between them, two runs are cheaper
+    link.master_shmem.rgb_matrix[3] = 2;
+    link.master_shmem.rgb_matrix[7] = 2;
+    EXPECT_TRUE(link.exchange());
+    EXPECT_EQ(link.request_size, empty_frame + (1 + 1 + 2 * (2 + 1)));
+    EXPECT_TRUE(link.in_sync());
+}
+
+TEST_F(TransportDelta, WholeRegionChangeIsSentInFull) {
+    link.master_shmem.layer_state = 0x12345678;
+    EXPECT_TRUE(link.exchange());
+    EXPECT_EQ(link.request_size, empty_frame + 1 + sizeof(link.master_shmem.layer_state));
+    EXPECT_TRUE(link.in_sync());
+}
+
+TEST_F(TransportDelta, RegionsWhichDontFitWaitForTheNextFrame) {
+    LoopbackTransport small(empty_frame + 16);
+    for (auto &region : loopback_m2s_regions) {
+        memset((uint8_t *)&small.master_shmem + region.offset, 0xFF, region.size);
+    }
+    int exchanges = 0;
+    while (!small.in_sync() && exchanges < 10) {
+        EXPECT_TRUE(small.exchange());
+        EXPECT_LE(small.request_size, empty_frame + 16);
+        exchanges++;
+    }
+    EXPECT_TRUE(small.in_sync());
+    EXPECT_GT(exchanges, 1);
+}
+
+TEST_F(TransportDelta, ReceiverSeesWholeRegionRewritten) {
+    // The slave consumes part of a region, like the RGB Light change flags
+    link.slave_shmem.rgb_matrix[0]  = 0;
+    link.master_shmem.rgb_matrix[5] = 0x99;
+    EXPECT_TRUE(link.exchange());
+    EXPECT_EQ(link.slave_shmem.rgb_matrix[0], 0x42);
+    EXPECT_EQ(link.slave_shmem.rgb_matrix[5], 0x99);
+}
+
+TEST_F(TransportDelta, LostFramesAreRecovered) {
+    using Fault = LoopbackTransport::Fault;
+    for (auto fault : {Fault::drop_request, Fault::corrupt_request, Fault::drop_response, Fault::corrupt_response}) {
+        link.master_shmem.mods[1]++;
+        link.slave_shmem.smatrix[0]++;
+        update_checksums(link.slave_shmem);
+        link.exchange(fault);
+
+        // The next exchange carries another change on top, so runs alone would leave the first one behind
+        link.master_shmem.mods[2]++;
+        link.slave_shmem.smatrix[1]++;
+        update_checksums(link.slave_shmem);
+        EXPECT_TRUE(link.exchange());
+        EXPECT_TRUE(link.exchange());
+        EXPECT_TRUE(link.in_sync()) << "fault " << (int)fault;
+    }
+}
+
+TEST_F(TransportDelta, SlaveRestartIsRecovered) {
+    link.master_shmem.wpm = 80;
+    EXPECT_TRUE(link.exchange());
+    link.restart_slave();
+    link.master_shmem.wpm = 81;
+    EXPECT_TRUE(link.exchange());
+    EXPECT_TRUE(link.exchange());
+    EXPECT_TRUE(link.in_sync());
+    EXPECT_EQ(link.slave_shmem.layer_state, 0x10);
+}
+
+TEST_F(TransportDelta, RandomizedFaultsConverge) {
+    std::mt19937 rng(1234);
+    using Fault          = LoopbackTransport::Fault;
+    const Fault faults[] = {Fault::drop_request, Fault::corrupt_request, Fault::drop_response, Fault::corrupt_response};
+
+    for (int scan = 0; scan < 20000; scan++) {
+        mutate(rng, link.master_shmem, link.slave_shmem);
+        if (rng() % 20 == 0) {
+            link.exchange(faults[rng() % 4]);
+        } else if (rng() % 500 == 0) {
+            link.restart_slave();
+        } else {
+            ASSERT_TRUE(link.exchange());
+        }
+        // Any fault is mended by two clean exchanges: one to learn about it, one to resend
+        ASSERT_TRUE(link.exchange());
+        ASSERT_TRUE(link.exchange());
+        ASSERT_TRUE(link.in_sync()) << "scan " << scan;
+    }
+}
+
+TEST_F(TransportDelta, TurnaroundsPerScan) {
+    std::mt19937 rng(42);
+    LegacyCost   legacy;
+    size_t       delta_bytes = link.bytes;
+    size_t       exchanges   = link.exchanges;
+
+    // Typing with an RGB Matrix effect running: the effect timer ticks every scan, keys change every few scans
+    const int scans = 1000;
+    for (int scan = 0; scan < scans; scan++) {
+        LoopbackShmem master_before = link.master_shmem;
+        LoopbackShmem slave_before  = link.slave_shmem;
+
+        memcpy(&link.master_shmem.rgb_matrix[8], &scan, sizeof(scan));
+        if (scan % 100 == 0) {
+            link.master_shmem.sync_timer = scan;
+        }
+        if (rng() % 8 == 0) {
+            link.slave_shmem.smatrix[rng() % 8] ^= 1 << (rng() % 16);
+        }
+        if (rng() % 16 == 0) {
+            link.master_shmem.mods[0] ^= 0x02;
+        }
+        if (rng() % 64 == 0) {
+            link.master_shmem.layer_state ^= 0x04;
+        }
+        if (rng() % 32 == 0) {
+            link.slave_shmem.encoders[0]++;
+        }
+        update_checksums(link.slave_shmem);
+
+        ASSERT_TRUE(link.exchange());
+        ASSERT_TRUE(link.in_sync());
+        legacy.scan(master_before, link.master_shmem, slave_before, link.slave_shmem);
+    }
+    exchanges   = link.exchanges - exchanges;
+    delta_bytes = link.bytes - delta_bytes + exchanges * legacy_handshake_bytes;
+
+    size_t legacy_turnarounds = legacy.transactions * legacy_turnarounds_per_trans;
+    size_t delta_turnarounds  = exchanges * delta_turnarounds_per_exchange;
+
+    EXPECT_EQ(exchanges, scans);
+    EXPECT_LT(delta_turnarounds, legacy_turnarounds);
+    EXPECT_LT(delta_bytes, legacy.bytes);
+}
@@ -0,0 +1,141 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "print.h"
+#include "timer.h"
+#include "transaction_id_define.h"
+#include "transaction_stats.h"
+
+#ifdef PROTOCOL_CHIBIOS
+#    include <ch.h>
+#    include "chibios_config.h"
+#endif // PROTOCOL_CHIBIOS
+
+static split_transaction_stats_t stats[NUM_TOTAL_TRANSACTIONS];
+static uint32_t                  last_failed = 0; // one bit per transaction
+
+uint32_t split_transaction_stats_timestamp(void) {
+#if defined(PROTOCOL_CHIBIOS) && PORT_SUPPORTS_RT == TRUE
+    return chSysGetRealtimeCounterX();
+#elif defined(PROTOCOL_CHIBIOS)
+    return chVTGetSystemTimeX();
+#else
+    return timer_read32();
+#endif // PROTOCOL_CHIBIOS
+}
+
+static uint32_t elapsed_us(uint32_t start) {
+#if defined(PROTOCOL_CHIBIOS) && PORT_SUPPORTS_RT == TRUE
+    // The counter runs at the core clock and wraps after tens of seconds, far longer than any transfer
+    return RTC2US(REALTIME_COUNTER_CLOCK, (rtcnt_t)(chSysGetRealtimeCounterX() - (rtcnt_t)start));
+#elif defined(PROTOCOL_CHIBIOS)
+    return TIME_I2US(chTimeDiffX((systime_t)start, chVTGetSystemTimeX()));
+#else
+    return timer_elapsed32(start) * 1000;
+#endif // PROTOCOL_CHIBIOS
+}
+
+void split_transaction_stats_record(int8_t id, bool success, uint32_t start) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) return;
+
+    split_transaction_stats_t *s        = &stats[id];
+    uint32_t                   duration = elapsed_us(start);
+    uint32_t                   mask     = (uint32_t)1 << id;
+
+    s->transfers++;
+    if (last_failed & mask) {
+        s->retries++;
+    }
+    if (success) {
+        last_failed &= ~mask;
+    } else {
+        last_failed |= mask;
+        s->failures++;
+    }
+    if (duration > s->max_us) {
+        s->max_us = duration;
+    }
+
+    uint8_t bucket = 0;
+    while (bucket < SPLIT_TRANSACTION_STATS_BUCKETS - 1 && duration >= ((uint32_t)SPLIT_TRANSACTION_STATS_BUCKET_US << bucket)) {
+        bucket++;
+    }
+    if (s->histogram[bucket] < UINT16_MAX) {
+        s->histogram[bucket]++;
+    }
+}
+
+void split_transaction_stats_skip(int8_t id) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) return;
+    stats[id].skips++;
+}
+
+const split_transaction_stats_t *split_transaction_stats_get(int8_t id) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) return NULL;
+    return &stats[id];
+}
+
+void split_transaction_stats_reset(void) {
+    memset(stats, 0, sizeof(stats));
+    last_failed = 0;
+}
+
+void split_transaction_stats_print(void) {
+    uprintf("split: id transfers failures retries skips max_us | histogram from <%uus\n", SPLIT_TRANSACTION_STATS_BUCKET_US);
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        split_transaction_stats_t *s = &stats[id];
+        if (!s->transfers && !s->skips) continue;
+
+        uprintf("split: %2d %9lu %8lu %7lu %5lu %6lu |", id, (unsigned long)s->transfers, (unsigned long)s->failures, (unsigned long)s->retries, (unsigned long)s->skips, (unsigned long)s->max_us);
+        for (uint8_t bucket = 0; bucket < SPLIT_TRANSACTION_STATS_BUCKETS; bucket++) {
+            uprintf(" %u", s->histogram[bucket]);
+        }
+        uprintf("\n");
+    }
+}
+
+static uint8_t put_be(uint8_t *data, uint8_t pos, uint8_t length, uint32_t value, uint8_t size) {
+    while (size-- > 0) {
+        if (pos < length) {
+            data[pos] = (value >> (size * 8)) & 0xFF;
+        }
+        pos++;
+    }
+    return pos;
+}
+
+void split_transaction_stats_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 2) return;
+
+    int8_t   id   = data[0];
+    uint8_t *page = &data[1];
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) {
+        *page = 0xFF;
+        return;
+    }
+
+    split_transaction_stats_t *s   = &stats[id];
+    uint8_t                    pos = 2;
+    switch (*page) {
+        case 0:
+            pos = put_be(data, pos, length, NUM_TOTAL_TRANSACTIONS, 1);
+            pos = put_be(data, pos, length, s->transfers, 4);
+            pos = put_be(data, pos, length, s->failures, 4);
+            pos = put_be(data, pos, length, s->retries, 4);
+            pos = put_be(data, pos, length, s->skips, 4);
+            pos = put_be(data, pos, length, s->max_us, 4);
+            break;
+        case 1:
+            pos = put_be(data, pos, length, SPLIT_TRANSACTION_STATS_BUCKETS, 1);
+            pos = put_be(data, pos, length, SPLIT_TRANSACTION_STATS_BUCKET_US, 2);
+            for (uint8_t bucket = 0; bucket < SPLIT_TRANSACTION_STATS_BUCKETS; bucket++) {
+                pos = put_be(data, pos, length, s->histogram[bucket], 2);
+            }
+            break;
+        default:
+            *page = 0xFF;
+            break;
+    }
+}
@@ -0,0 +1,53 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef SPLIT_TRANSACTION_STATS_BUCKETS
+#    define SPLIT_TRANSACTION_STATS_BUCKETS 8
+#endif // SPLIT_TRANSACTION_STATS_BUCKETS
+
+// Upper bound of the first histogram bucket, each following bucket doubles it and the last one takes the rest
+#ifndef SPLIT_TRANSACTION_STATS_BUCKET_US
+#    define SPLIT_TRANSACTION_STATS_BUCKET_US 64
+#endif // SPLIT_TRANSACTION_STATS_BUCKET_US
+
+typedef struct {
+    uint32_t transfers; // attempts to run the transaction over the transport
+    uint32_t failures;
+    uint32_t retries; // attempts right after a failed one
+    uint32_t skips;   // transfers left out because the data was unchanged, or its checksum matched
+    uint32_t max_us;
+    uint16_t histogram[SPLIT_TRANSACTION_STATS_BUCKETS]; // transfer durations, saturating
+} split_transaction_stats_t;
+
+/**
+ * @brief Timestamp to pass to split_transaction_stats_record() once the transfer is done. On ChibiOS ports with a
+ * realtime counter (PORT_SUPPORTS_RT) this is the cycle counter, so durations are true microseconds; on other ChibiOS
+ * ports they are whole system ticks (CH_CFG_ST_FREQUENCY) converted to microseconds, and elsewhere whole milliseconds.
+ */
+uint32_t split_transaction_stats_timestamp(void);
+
+void split_transaction_stats_record(int8_t id, bool success, uint32_t start);
+void split_transaction_stats_skip(int8_t id);
+
+const split_transaction_stats_t *split_transaction_stats_get(int8_t id);
+void                             split_transaction_stats_reset(void);
+
+/**
+ * @brief Prints a line per transaction that was used, along with its histogram, to the console.
+ */
+void split_transaction_stats_print(void);
+
+/**
+ * @brief Answers a raw HID query for one transaction.
+ *
+ * On input `data` holds the transaction id and the page to read, which get filled in after them:
+ *  - page 0: number of transactions, then transfers, failures, retries, skips and max_us, each 32 bits
+ *  - page 1: number of buckets, SPLIT_TRANSACTION_STATS_BUCKET_US, then every bucket, each 16 bits
+ * Values are big-endian. Unknown transactions and pages are answered with 0xFF as the page.
+ */
+void split_transaction_stats_raw_hid(uint8_t *data, uint8_t length);
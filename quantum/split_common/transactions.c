@@ -27,6 +27,20 @@
 #include "split_util.h"
 #include "synchronization_util.h"
 
+#ifdef SPLIT_TRANSPORT_DELTA
+#    include "transport_delta.h"
+#    if defined(USE_I2C) || defined(SERIAL_DRIVER_BITBANG)
+#        error "SPLIT_TRANSPORT_DELTA requires SERIAL_DRIVER = usart or vendor"
+#    endif
+#endif // SPLIT_TRANSPORT_DELTA
+
+#ifdef SPLIT_TRANSACTION_STATS
+#    include "transaction_stats.h"
+#    define transaction_stats_skip(id) split_transaction_stats_skip(id)
+#else // SPLIT_TRANSACTION_STATS
+#    define transaction_stats_skip(id)
+#endif // SPLIT_TRANSACTION_STATS
+
 #define SYNC_TIMER_OFFSET 2
 
 #ifndef FORCED_SYNC_THROTTLE_MS
@@ -43,8 +57,15 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#ifdef SPLIT_TRANSPORT_DELTA
+static bool delta_write(int8_t id, const void *data, size_t length);
+static bool delta_read(int8_t id, void *data, size_t length);
+#    define transport_write(id, data, length) delta_write(id, data, length)
+#    define transport_read(id, data, length) delta_read(id, data, length)
+#else // SPLIT_TRANSPORT_DELTA
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#endif // SPLIT_TRANSPORT_DELTA
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -112,6 +133,7 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
             *last_update = timer_read32();
         }
     } else {
+        if (okay) transaction_stats_skip(trans_id_retrieve);
         memcpy(destination, equiv_shmem, length);
     }
     return okay;
@@ -124,6 +146,8 @@ inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, boo
         if (okay) {
             *last_update = timer_read32();
         }
+    } else {
+        transaction_stats_skip(trans_id);
     }
     return okay;
 }
@@ -133,6 +157,101 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
 }
 
+////////////////////////////////////////////////////
+// Delta transport
+
+#ifdef SPLIT_TRANSPORT_DELTA
+
+_Static_assert(SPLIT_TRANSPORT_DELTA_BUFFER_SIZE >= SPLIT_DELTA_MIN_FRAME_SIZE && SPLIT_TRANSPORT_DELTA_BUFFER_SIZE <= UINT8_MAX, "SPLIT_TRANSPORT_DELTA_BUFFER_SIZE out of range");
+_Static_assert(NUM_TOTAL_TRANSACTIONS <= SPLIT_DELTA_MAX_REGIONS, "Too many transactions for SPLIT_TRANSPORT_DELTA");
+
+static split_delta_region_t delta_m2s_regions[NUM_TOTAL_TRANSACTIONS];
+static split_delta_region_t delta_s2m_regions[NUM_TOTAL_TRANSACTIONS];
+static uint8_t              delta_shadow[offsetof(split_shared_memory_t, delta_m2s)];
+static split_delta_t        delta_state;
+static bool                 delta_exchanged = false;
+
+// Whether the transaction is carried by the delta frames, rather than run on its own
+static bool delta_carries(int8_t id) {
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    // RPCs need the slave callback to run in between their transactions
+    if (id >= PUT_RPC_INFO && id <= GET_RPC_RESP_DATA) return false;
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    return id != EXCHANGE_DELTA && !split_transaction_table[id].slave_callback;
+}
+
+static void delta_setup(bool is_master) {
+    if (delta_state.shmem) return;
+
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        if (!delta_carries(id)) continue;
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        delta_m2s_regions[id]           = (split_delta_region_t){trans->initiator2target_offset, trans->initiator2target_buffer_size};
+        delta_s2m_regions[id]           = (split_delta_region_t){trans->target2initiator_offset, trans->target2initiator_buffer_size};
+    }
+
+    delta_state.shadow       = delta_shadow;
+    delta_state.tx_regions   = is_master ? delta_m2s_regions : delta_s2m_regions;
+    delta_state.rx_regions   = is_master ? delta_s2m_regions : delta_m2s_regions;
+    delta_state.region_count = NUM_TOTAL_TRANSACTIONS;
+    split_delta_init(&delta_state);
+    delta_state.shmem = (uint8_t *)split_shmem;
+}
+
+// Writes only land in shared memory, whatever changed goes out with the next exchange
+static bool delta_write(int8_t id, const void *data, size_t length) {
+    if (!delta_carries(id)) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    memcpy(split_trans_initiator2target_buffer(trans), data, MIN(length, trans->initiator2target_buffer_size));
+    return true;
+}
+
+// Reads are served from shared memory, as of the last exchange
+static bool delta_read(int8_t id, void *data, size_t length) {
+    if (!delta_carries(id)) {
+        return transport_execute_transaction(id, NULL, 0, data, length);
+    }
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    memcpy(data, split_trans_target2initiator_buffer(trans), MIN(length, trans->target2initiator_buffer_size));
+    return delta_exchanged;
+}
+
+static bool delta_exchange_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    delta_setup(true);
+    split_delta_encode(&delta_state, split_shmem->delta_m2s, sizeof(split_shmem->delta_m2s));
+    delta_exchanged = transport_execute_transaction(EXCHANGE_DELTA, NULL, 0, NULL, 0) && split_delta_decode(&delta_state, split_shmem->delta_s2m, sizeof(split_shmem->delta_s2m));
+    if (!delta_exchanged) {
+        split_delta_lost(&delta_state);
+    }
+    return delta_exchanged;
+}
+
+static void delta_exchange_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    delta_setup(false);
+    // A broken request shows up at the master as a stale acknowledgement in the reply
+    split_delta_decode(&delta_state, initiator2target_buffer, initiator2target_buffer_size);
+    split_delta_encode(&delta_state, target2initiator_buffer, target2initiator_buffer_size);
+}
+
+// clang-format off
+#    define TRANSACTIONS_DELTA_EXCHANGE_MASTER() TRANSACTION_HANDLER_MASTER(delta_exchange)
+#    define TRANSACTIONS_DELTA_EXCHANGE_REGISTRATIONS \
+    [EXCHANGE_DELTA] = { \
+        sizeof_member(split_shared_memory_t, delta_m2s), offsetof(split_shared_memory_t, delta_m2s), \
+        sizeof_member(split_shared_memory_t, delta_s2m), offsetof(split_shared_memory_t, delta_s2m), \
+        delta_exchange_callback, true \
+    },
+// clang-format on
+
+#else // SPLIT_TRANSPORT_DELTA
+
+#    define TRANSACTIONS_DELTA_EXCHANGE_MASTER()
+#    define TRANSACTIONS_DELTA_EXCHANGE_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_DELTA
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
@@ -858,6 +977,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // USE_I2C
 
     // clang-format off
+    TRANSACTIONS_DELTA_EXCHANGE_REGISTRATIONS
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
@@ -888,6 +1008,38 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#if defined(SPLIT_TRANSACTION_STATS) && defined(SPLIT_TRANSACTION_STATS_INTERVAL)
+    static uint32_t last_stats_print = 0;
+    if (timer_elapsed32(last_stats_print) >= SPLIT_TRANSACTION_STATS_INTERVAL) {
+        last_stats_print = timer_read32();
+        split_transaction_stats_print();
+    }
+#endif // defined(SPLIT_TRANSACTION_STATS) && defined(SPLIT_TRANSACTION_STATS_INTERVAL)
+
+#ifdef SPLIT_TRANSPORT_DELTA
+    // Writes are queued up and all go out in a single exchange, which also brings back the slave's state for the reads
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_SYNC_TIMER_MASTER();
+    TRANSACTIONS_LAYER_STATE_MASTER();
+    TRANSACTIONS_LED_STATE_MASTER();
+    TRANSACTIONS_MODS_MASTER();
+    TRANSACTIONS_BACKLIGHT_MASTER();
+    TRANSACTIONS_RGBLIGHT_MASTER();
+    TRANSACTIONS_LED_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_WPM_MASTER();
+    TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_ST7565_MASTER();
+    TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_HAPTIC_MASTER();
+    TRANSACTIONS_ACTIVITY_MASTER();
+    TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_DELTA_EXCHANGE_MASTER();
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+    return true;
+#else  // SPLIT_TRANSPORT_DELTA
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -908,6 +1060,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
     return true;
+#endif // SPLIT_TRANSPORT_DELTA
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -32,6 +32,7 @@ typedef struct _split_transaction_desc_t {
     uint8_t          target2initiator_buffer_size;
     uint16_t         target2initiator_offset;
     slave_callback_t slave_callback;
+    bool             framed; // buffers start with the number of bytes that follow, only those are transferred
 } split_transaction_desc_t;
 
 // Forward declaration for the split transactions
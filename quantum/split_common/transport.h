@@ -31,6 +31,10 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifndef SPLIT_TRANSPORT_DELTA_BUFFER_SIZE
+#    define SPLIT_TRANSPORT_DELTA_BUFFER_SIZE 128
+#endif // SPLIT_TRANSPORT_DELTA_BUFFER_SIZE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -230,6 +234,12 @@ typedef struct _split_shared_memory_t {
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+
+#ifdef SPLIT_TRANSPORT_DELTA
+    // Kept last, everything before is mirrored by the delta transport
+    uint8_t delta_m2s[SPLIT_TRANSPORT_DELTA_BUFFER_SIZE];
+    uint8_t delta_s2m[SPLIT_TRANSPORT_DELTA_BUFFER_SIZE];
+#endif // SPLIT_TRANSPORT_DELTA
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
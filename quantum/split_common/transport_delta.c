@@ -0,0 +1,219 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "crc.h"
+#include "transport_delta.h"
+
+// Changes separated by at most this many unchanged bytes go into one run, as a new run costs two bytes of header
+#define SPLIT_DELTA_RUN_GAP 2
+
+// Sequence numbers skip 0, which stands for "nothing received yet"
+static inline uint8_t next_seq(uint8_t seq) {
+    return seq == UINT8_MAX ? 1 : seq + 1;
+}
+
+void split_delta_init(split_delta_t *delta) {
+    delta->resend = 0;
+    delta->tx_seq = 0;
+    delta->rx_seq = 0;
+    delta->resync = true;
+}
+
+void split_delta_lost(split_delta_t *delta) {
+    delta->resync = true;
+}
+
+/**
+ * @brief Finds the next run of changed bytes at or after `*start`.
+ *
+ * @return uint8_t the length of the run, 0 if there are no more changes
+ */
+static uint8_t next_run(const uint8_t *current, const uint8_t *sent, uint8_t size, uint8_t *start) {
+    uint8_t begin = *start;
+    while (begin < size && current[begin] == sent[begin]) {
+        begin++;
+    }
+    if (begin == size) {
+        return 0;
+    }
+
+    uint8_t end = begin + 1;
+    for (uint8_t i = end; i < size && i - end <= SPLIT_DELTA_RUN_GAP; i++) {
+        if (current[i] != sent[i]) {
+            end = i + 1;
+        }
+    }
+    *start = begin;
+    return end - begin;
+}
+
+/**
+ * @brief Writes a record for one region, as runs if that is shorter than the whole region.
+ *
+ * @return uint8_t the length of the record, 0 if it didn't fit into `room` bytes
+ */
+static uint8_t encode_region(uint8_t index, const uint8_t *current, const uint8_t *sent, uint8_t size, bool full, uint8_t *out, uint8_t room) {
+    uint16_t length = 1 + size;
+    uint8_t  runs   = 0;
+
+    if (!full) {
+        uint16_t delta_length = 2;
+        uint8_t  run_length;
+        for (uint8_t start = 0; (run_length = next_run(current, sent, size, &start)) != 0; start += run_length) {
+            delta_length += 2 + run_length;
+            runs++;
+        }
+        full = delta_length >= length;
+        if (!full) {
+            length = delta_length;
+        }
+    }
+
+    if (length > room) {
+        return 0;
+    }
+
+    if (full) {
+        out[0] = index | SPLIT_DELTA_RECORD_FULL;
+        memcpy(&out[1], current, size);
+        return length;
+    }
+
+    out[0]      = index;
+    out[1]      = runs;
+    uint8_t pos = 2;
+    uint8_t run_length;
+    for (uint8_t start = 0; (run_length = next_run(current, sent, size, &start)) != 0; start += run_length) {
+        out[pos++] = start;
+        out[pos++] = run_length;
+        memcpy(&out[pos], &current[start], run_length);
+        pos += run_length;
+    }
+    return length;
+}
+
+uint8_t split_delta_encode(split_delta_t *delta, uint8_t *frame, uint8_t size) {
+    if (size < SPLIT_DELTA_MIN_FRAME_SIZE) {
+        return 0;
+    }
+
+    uint8_t flags = 0;
+    if (delta->resync) {
+        delta->resync = false;
+        delta->resend = UINT32_MAX;
+        flags |= SPLIT_DELTA_FLAG_RESYNC;
+    }
+
+    delta->tx_seq = next_seq(delta->tx_seq);
+    frame[1]      = delta->tx_seq;
+    frame[2]      = delta->rx_seq;
+    frame[3]      = flags;
+
+    uint8_t pos = SPLIT_DELTA_HEADER_SIZE;
+    for (uint8_t index = 0; index < delta->region_count; index++) {
+        const split_delta_region_t *region = &delta->tx_regions[index];
+        if (!region->size) {
+            continue;
+        }
+
+        uint32_t       mask    = (uint32_t)1 << index;
+        const uint8_t *current = delta->shmem + region->offset;
+        uint8_t       *sent    = delta->shadow + region->offset;
+        bool           full    = (delta->resend & mask) != 0;
+        if (!full && memcmp(current, sent, region->size) == 0) {
+            continue;
+        }
+
+        // Keep a byte spare for the checksum
+        uint8_t length = encode_region(index, current, sent, region->size, full, &frame[pos], size - 1 - pos);
+        if (length) {
+            memcpy(sent, current, region->size);
+            delta->resend &= ~mask;
+            pos += length;
+        }
+    }
+
+    frame[0]   = pos;
+    frame[pos] = crc8(frame, pos);
+    return pos + 1;
+}
+
+/**
+ * @brief Applies the records of a frame which passed its checksum.
+ *
+ * @return false if a record doesn't fit the regions, in which case the frame can't be trusted
+ */
+static bool apply_records(split_delta_t *delta, const uint8_t *records, uint8_t length) {
+    uint8_t pos = 0;
+    while (pos < length) {
+        uint8_t index = records[pos] & ~SPLIT_DELTA_RECORD_FULL;
+        bool    full  = (records[pos] & SPLIT_DELTA_RECORD_FULL) != 0;
+        pos++;
+        if (index >= delta->region_count || !delta->rx_regions[index].size) {
+            return false;
+        }
+
+        const split_delta_region_t *region   = &delta->rx_regions[index];
+        uint8_t                    *received = delta->shadow + region->offset;
+        if (full) {
+            if (length - pos < region->size) {
+                return false;
+            }
+            memcpy(received, &records[pos], region->size);
+            pos += region->size;
+        } else {
+            if (pos >= length) {
+                return false;
+            }
+            uint8_t runs = records[pos++];
+            for (uint8_t run = 0; run < runs; run++) {
+                if (length - pos < 2) {
+                    return false;
+                }
+                uint8_t start      = records[pos++];
+                uint8_t run_length = records[pos++];
+                if (start + run_length > region->size || length - pos < run_length) {
+                    return false;
+                }
+                memcpy(&received[start], &records[pos], run_length);
+                pos += run_length;
+            }
+        }
+        memcpy(delta->shmem + region->offset, received, region->size);
+    }
+    return true;
+}
+
+bool split_delta_decode(split_delta_t *delta, const uint8_t *frame, uint8_t size) {
+    if (size < SPLIT_DELTA_MIN_FRAME_SIZE || frame[0] < SPLIT_DELTA_HEADER_SIZE || frame[0] >= size) {
+        return false;
+    }
+    uint8_t length = frame[0];
+    if (crc8(frame, length) != frame[length]) {
+        return false;
+    }
+
+    uint8_t seq   = frame[1];
+    uint8_t ack   = frame[2];
+    uint8_t flags = frame[3];
+
+    // The peer didn't get our last frame, or lost its state since
+    if (ack != delta->tx_seq) {
+        delta->resync = true;
+    }
+
+    // Runs only make sense on top of everything sent before, so a gap in the sequence means waiting for a resync, which
+    // the stale acknowledgement in our next frame asks for
+    bool in_sequence = delta->rx_seq != 0 && seq == next_seq(delta->rx_seq);
+    if (!in_sequence && !(flags & SPLIT_DELTA_FLAG_RESYNC)) {
+        return true;
+    }
+
+    if (!apply_records(delta, &frame[SPLIT_DELTA_HEADER_SIZE], length - SPLIT_DELTA_HEADER_SIZE)) {
+        return false;
+    }
+    delta->rx_seq = seq;
+    return true;
+}
@@ -0,0 +1,70 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Delta frames carry every changed region of the split shared memory in a single buffer:
+ *
+ *   [length] [sequence] [acknowledgement] [flags] [records...] [crc8]
+ *
+ * `length` counts the bytes which follow it, the checksum covers everything before it. Each record starts with the
+ * region index. With SPLIT_DELTA_RECORD_FULL set the whole region follows, otherwise a run count and that many runs of
+ * [offset] [length] [bytes]. Runs hold absolute values, so a record can be applied more than once.
+ *
+ * Every frame acknowledges the last sequence number received from the peer. Whenever a frame goes missing, the peer
+ * restarts, or the acknowledgement doesn't match, the sender falls back to resending every region in full.
+ */
+
+#define SPLIT_DELTA_HEADER_SIZE 4
+#define SPLIT_DELTA_MIN_FRAME_SIZE (SPLIT_DELTA_HEADER_SIZE + 1)
+#define SPLIT_DELTA_MAX_REGIONS 32
+
+#define SPLIT_DELTA_FLAG_RESYNC 0x01
+#define SPLIT_DELTA_RECORD_FULL 0x80
+
+typedef struct {
+    uint16_t offset;
+    uint8_t  size; // 0 for regions not carried in this direction
+} split_delta_region_t;
+
+typedef struct {
+    uint8_t                    *shmem;
+    uint8_t                    *shadow;     // same layout as shmem: what was last sent for tx regions, what was last received for rx regions
+    const split_delta_region_t *tx_regions; // indexed by region, sent to the peer
+    const split_delta_region_t *rx_regions; // indexed by region, received from the peer
+    uint8_t                     region_count;
+    uint32_t                    resend; // regions to send in full with the next frames
+    uint8_t                     tx_seq;
+    uint8_t                     rx_seq; // 0 until the first frame from the peer was accepted
+    bool                        resync;
+} split_delta_t;
+
+/**
+ * @brief Resets the state, so that the next frame resends everything.
+ */
+void split_delta_init(split_delta_t *delta);
+
+/**
+ * @brief Fills `frame` with the regions that changed since they were last sent, as many as fit into `size` bytes.
+ * Regions which don't fit are left for the next frame.
+ *
+ * @return uint8_t the number of bytes of `frame` in use
+ */
+uint8_t split_delta_encode(split_delta_t *delta, uint8_t *frame, uint8_t size);
+
+/**
+ * @brief Applies a frame received from the peer. Every region it carries is copied into shmem in full, even if only a
+ * few bytes changed, so the receiving side sees the same writes as with whole-struct transactions.
+ *
+ * @return true if the frame was intact, whether or not it could be applied
+ */
+bool split_delta_decode(split_delta_t *delta, const uint8_t *frame, uint8_t size);
+
+/**
+ * @brief Signals that the last exchange failed, so the fate of the last frame is unknown.
+ */
+void split_delta_lost(split_delta_t *delta);
@@ -23,6 +23,7 @@
 #include "host.h"
 #include "keycode.h"
 #include "wait.h"
+#include "output_queue.h"
 #include "send_string.h"
 #include "utf8.h"
 
@@ -230,7 +231,7 @@ __attribute__((weak)) void unicode_input_start(void) {
                 tap_code(KC_NUM_LOCK);
             }
             register_code(KC_LEFT_ALT);
-            wait_ms(UNICODE_TYPE_DELAY);
+            output_queue_wait_ms(UNICODE_TYPE_DELAY);
             tap_code(KC_KP_PLUS);
             break;
         case UNICODE_MODE_WINCOMPOSE:
@@ -245,7 +246,7 @@ __attribute__((weak)) void unicode_input_start(void) {
             break;
     }
 
-    wait_ms(UNICODE_TYPE_DELAY);
+    output_queue_wait_ms(UNICODE_TYPE_DELAY);
 }
 
 __attribute__((weak)) void unicode_input_finish(void) {
@@ -35,6 +35,10 @@
 #    include <lib/lib8tion/lib8tion.h>
 #endif
 
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_TRANSACTION_STATS)
+#    include "transaction_stats.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -180,10 +184,19 @@ bool process_record_via(uint16_t keycode, keyrecord_t *record) {
 //
 
 // This is the default handler for "extra" custom values, i.e. keyboard-specific custom values
-// that are not handled by via_custom_value_command().
+// that are not handled by via_custom_value_command(). With SPLIT_TRANSACTION_STATS, it answers
+// reads on id_custom_channel with via_split_transaction_stats_command().
 __attribute__((weak)) void via_custom_value_command_kb(uint8_t *data, uint8_t length) {
     // data = [ command_id, channel_id, value_id, value_data ]
     uint8_t *command_id = &(data[0]);
+
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_TRANSACTION_STATS)
+    if (data[1] == id_custom_channel) {
+        via_split_transaction_stats_command(data, length);
+        return;
+    }
+#endif // SPLIT_TRANSACTION_STATS
+
     // Return the unhandled state
     *command_id = id_unhandled;
 }
@@ -758,3 +771,26 @@ void via_qmk_audio_save(void) {
 }
 
 #endif // QMK_AUDIO_ENABLE
+
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_TRANSACTION_STATS)
+
+// Serves the split transaction statistics as read-only custom values, the value ID being the transaction ID.
+// Keyboards overriding via_custom_value_command_kb() can call this from it to keep them readable.
+void via_split_transaction_stats_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, channel_id, value_id, value_data ]
+    uint8_t *command_id        = &(data[0]);
+    uint8_t *value_id_and_data = &(data[2]);
+
+    switch (*command_id) {
+        case id_custom_get_value: {
+            split_transaction_stats_raw_hid(value_id_and_data, length - 2);
+            break;
+        }
+        default: {
+            *command_id = id_unhandled;
+            break;
+        }
+    }
+}
+
+#endif // SPLIT_TRANSACTION_STATS
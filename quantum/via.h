@@ -187,4 +187,8 @@ void via_qmk_audio_command(uint8_t *data, uint8_t length);
 void via_qmk_audio_set_value(uint8_t *data);
 void via_qmk_audio_get_value(uint8_t *data);
 void via_qmk_audio_save(void);
+#endif
+
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_TRANSACTION_STATS)
+void via_split_transaction_stats_command(uint8_t *data, uint8_t length);
 #endif
\ No newline at end of file
@@ -24,6 +24,10 @@ void MockBackingStore::reset_instance() {
     backing_write_invoke_count  = 0;
     backing_lock_invoke_count   = 0;
 
+    backing_operation_count = 0;
+    power_loss_countdown    = -1;
+    power_lost              = false;
+
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
     unlock_success_callback = [](std::uint64_t) { return true; };
@@ -65,6 +69,11 @@ bool MockBackingStore::erase(void) {
             return false;
         }
 
+        // Power loss leaves the rest of the backing store as it was
+        if (!consume_operation()) {
+            return false;
+        }
+
         backing_storage[i].erase();
     }
 
@@ -88,6 +97,11 @@ bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
         return false;
     }
 
+    // Drop the write if power has been lost
+    if (!consume_operation()) {
+        return false;
+    }
+
     // Write the complement as we're simulating flash memory -- 0xFF means 0x00
     std::size_t index = address / BACKING_STORE_WRITE_SIZE;
     backing_storage[index].set(~value);
@@ -90,6 +90,13 @@ class MockBackingStore {
     // The write log for the backing store
     std::vector<MockBackingStoreLogEntry> write_log;
 
+    // The number of element writes and erases attempted
+    std::uint64_t backing_operation_count;
+    // The number of operations allowed before power is lost, or -1 if power is never lost
+    std::int64_t power_loss_countdown;
+    // Whether power has been lost -- the backing store is left untouched until power is restored
+    bool power_lost;
+
     // The number of times each API was invoked
     std::uint64_t backing_init_invoke_count;
     std::uint64_t backing_unlock_invoke_count;
@@ -108,6 +115,18 @@ class MockBackingStore {
     // Whether locks should succeed
     std::function<bool(std::uint64_t)> lock_success_callback;
 
+    // Whether the next element write or erase goes ahead, counting it towards the power loss
+    bool consume_operation() {
+        ++backing_operation_count;
+        if (power_loss_countdown == 0) {
+            power_lost = true;
+        }
+        if (power_loss_countdown > 0) {
+            --power_loss_countdown;
+        }
+        return !power_lost;
+    }
+
     template <typename... Args>
     void append_log(Args&&... args) {
         if (write_log.size() < MOCK_WRITE_LOG_MAX_ENTRIES::value) {
@@ -148,6 +167,23 @@ class MockBackingStore {
         return backing_lock_invoke_count;
     }
 
+    // The number of element writes and erases attempted, each of which is a point power may be lost at
+    std::uint64_t operation_count() const {
+        return backing_operation_count;
+    }
+
+    // Power loss: after `operations` more element writes or erases, every write and erase fails without effect
+    void set_power_loss_after(std::uint64_t operations) {
+        power_loss_countdown = (std::int64_t)operations;
+    }
+    void restore_power() {
+        power_loss_countdown = -1;
+        power_lost           = false;
+    }
+    bool has_lost_power() const {
+        return power_lost;
+    }
+
     // Clear out the internal data for the next run
     void reset_instance();
 
@@ -0,0 +1,207 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+extern "C" {
+#include "eeprom_driver.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+// Where VIA's dynamic keymap lives, just past eeconfig, and how much of it a 4-layer 6x15 board uses
+constexpr uint32_t keymap_address = 37;
+constexpr uint32_t keymap_size    = 4 * 6 * 15 * 2;
+// The largest dynamic keymap buffer a single VIA raw HID packet carries
+constexpr uint32_t via_chunk_size = 28;
+
+/* A keymap much like VIA uploads: mostly transparent upper layers, big-endian keycodes. */
+std::vector<uint8_t> random_keymap(uint32_t seed) {
+    std::mt19937         rng(seed);
+    std::vector<uint8_t> keymap(keymap_size);
+    for (uint32_t i = 0; i < keymap_size; i += 2) {
+        uint16_t keycode = (i < keymap_size / 4 || rng() % 3 == 0) ? 0x04 + rng() % 0x60 : 0x0001;
+        keymap[i]        = keycode >> 8;
+        keymap[i + 1]    = keycode & 0xFF;
+    }
+    return keymap;
+}
+
+/* Send the keymap the way dynamic_keymap_set_buffer() writes each VIA packet, with a main loop iteration after each. */
+void via_upload(const std::vector<uint8_t> &keymap) {
+    for (uint32_t offset = 0; offset < keymap.size(); offset += via_chunk_size) {
+        for (uint32_t i = offset; i < offset + via_chunk_size && i < keymap.size(); i++) {
+            eeprom_update_byte((uint8_t *)(uintptr_t)(keymap_address + i), keymap[i]);
+        }
+        advance_time(1);
+        eeprom_driver_task();
+    }
+}
+
+/* The same upload straight into the wear-leveling layer, as eeprom_update_byte() did without the cache. */
+void via_upload_uncached(const std::vector<uint8_t> &keymap) {
+    for (uint32_t i = 0; i < keymap.size(); i++) {
+        uint8_t stored;
+        wear_leveling_read(keymap_address + i, &stored, 1);
+        if (stored != keymap[i]) {
+            wear_leveling_write(keymap_address + i, &keymap[i], 1);
+        }
+    }
+}
+
+std::vector<uint8_t> stored_keymap() {
+    std::vector<uint8_t> keymap(keymap_size);
+    wear_leveling_read(keymap_address, keymap.data(), keymap.size());
+    return keymap;
+}
+
+} // namespace
+
+class EepromWriteBack : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        eeprom_driver_init();
+    }
+
+    void idle() {
+        advance_time(EEPROM_WRITE_BACK_FLUSH_DELAY);
+        eeprom_driver_task();
+    }
+};
+
+TEST_F(EepromWriteBack, ViaKeymapUploadWriteCounts) {
+    auto &inst = MockBackingStore::Instance();
+
+    struct {
+        uint64_t writes;
+        uint64_t erases;
+    } uncached, cached;
+
+    // Two uploads each, so the second finds most of the keymap already in place
+    via_upload_uncached(random_keymap(1));
+    via_upload_uncached(random_keymap(2));
+    uncached = {inst.total_write_count(), inst.erasure_count()};
+    EXPECT_EQ(stored_keymap(), random_keymap(2));
+
+    inst.reset_instance();
+    eeprom_driver_init();
+    via_upload(random_keymap(1));
+    idle();
+    via_upload(random_keymap(2));
+    idle();
+    cached = {inst.total_write_count(), inst.erasure_count()};
+
+    EXPECT_LT(cached.writes * 3, uncached.writes * 2) << "Expected at least a third of the writes to be coalesced away";
+    EXPECT_LT(cached.erases, uncached.erases) << "Expected fewer consolidations";
+
+    // Everything made it through to the backing store
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(stored_keymap(), random_keymap(2));
+}
+
+TEST_F(EepromWriteBack, ReadsSeeHeldBackWrites) {
+    auto &inst = MockBackingStore::Instance();
+
+    eeprom_update_word((uint16_t *)(uintptr_t)0x40, 0x1234);
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x43, 0x56);
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should have been held back";
+    EXPECT_EQ(eeprom_read_word((const uint16_t *)(uintptr_t)0x40), 0x1234);
+    EXPECT_EQ(eeprom_read_dword((const uint32_t *)(uintptr_t)0x40), 0x56001234);
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)(uintptr_t)0x3F), 0x00);
+}
+
+TEST_F(EepromWriteBack, FlushesOnceIdle) {
+    auto &inst = MockBackingStore::Instance();
+
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x80, 0x11);
+    uint32_t flush_time;
+    EXPECT_TRUE(eeprom_driver_next_flush(&flush_time));
+    EXPECT_EQ(flush_time, timer_read32() + EEPROM_WRITE_BACK_FLUSH_DELAY);
+
+    advance_time(EEPROM_WRITE_BACK_FLUSH_DELAY - 1);
+    eeprom_driver_task();
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should still be held back";
+
+    // Another write restarts the delay
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x81, 0x22);
+    advance_time(EEPROM_WRITE_BACK_FLUSH_DELAY - 1);
+    eeprom_driver_task();
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should still be held back";
+
+    advance_time(1);
+    eeprom_driver_task();
+    EXPECT_NE(inst.write_invoke_count(), 0) << "Write should have been flushed";
+    EXPECT_FALSE(eeprom_driver_next_flush(&flush_time));
+
+    uint8_t stored[2];
+    wear_leveling_read(0x80, stored, sizeof(stored));
+    EXPECT_EQ(stored[0], 0x11);
+    EXPECT_EQ(stored[1], 0x22);
+}
+
+TEST_F(EepromWriteBack, WriteOutsideWindowFlushes) {
+    auto &inst = MockBackingStore::Instance();
+
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x10, 0x11);
+    eeprom_update_byte((uint8_t *)(uintptr_t)(0x10 + EEPROM_WRITE_BACK_CACHE_SIZE), 0x22);
+    EXPECT_NE(inst.write_invoke_count(), 0) << "First write should have been flushed";
+
+    uint8_t stored;
+    wear_leveling_read(0x10, &stored, 1);
+    EXPECT_EQ(stored, 0x11);
+    wear_leveling_read(0x10 + EEPROM_WRITE_BACK_CACHE_SIZE, &stored, 1);
+    EXPECT_EQ(stored, 0x00) << "Second write should be held back";
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)(uintptr_t)(0x10 + EEPROM_WRITE_BACK_CACHE_SIZE)), 0x22);
+}
+
+TEST_F(EepromWriteBack, WindowGrowsDownwards) {
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x20, 0x20);
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x18, 0x18);
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x28, 0x28);
+    EXPECT_EQ(MockBackingStore::Instance().write_invoke_count(), 0) << "Writes should have been held back";
+
+    idle();
+    uint8_t stored[0x11];
+    wear_leveling_read(0x18, stored, sizeof(stored));
+    for (uint32_t i = 0; i < sizeof(stored); i++) {
+        EXPECT_EQ(stored[i], (i == 0 || i == 8 || i == 16) ? 0x18 + i : 0) << "Byte " << i;
+    }
+}
+
+TEST_F(EepromWriteBack, UnchangedValuesAreNotWritten) {
+    auto &inst = MockBackingStore::Instance();
+
+    eeprom_update_dword((uint32_t *)(uintptr_t)0x40, 0x12345678);
+    idle();
+    uint64_t writes = inst.write_invoke_count();
+
+    // Rewriting the same values, or changing one and changing it back, leaves nothing to write
+    eeprom_update_dword((uint32_t *)(uintptr_t)0x40, 0x12345678);
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x44, 0x99);
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x44, 0x00);
+    idle();
+    EXPECT_EQ(inst.write_invoke_count(), writes);
+}
+
+TEST_F(EepromWriteBack, LargeWritesGoStraightThrough) {
+    std::vector<uint8_t> block(EEPROM_WRITE_BACK_CACHE_SIZE + 1, 0x5A);
+    eeprom_update_block(block.data(), (void *)(uintptr_t)0x100, block.size());
+    EXPECT_NE(MockBackingStore::Instance().write_invoke_count(), 0) << "Large write should not have been held back";
+    uint32_t flush_time;
+    EXPECT_FALSE(eeprom_driver_next_flush(&flush_time));
+}
+
+TEST_F(EepromWriteBack, EraseDiscardsHeldBackWrites) {
+    eeprom_update_byte((uint8_t *)(uintptr_t)0x10, 0x11);
+    eeprom_driver_erase();
+    uint32_t flush_time;
+    EXPECT_FALSE(eeprom_driver_next_flush(&flush_time));
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)(uintptr_t)0x10), 0x00);
+}
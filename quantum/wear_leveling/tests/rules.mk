@@ -63,4 +63,38 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+
+wear_leveling_deferred_consolidation_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=48 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16 \
+	-DWEAR_LEVELING_DEFERRED_CONSOLIDATION \
+	-DWEAR_LEVELING_CONSOLIDATION_HEADROOM=8 \
+	-DWEAR_LEVELING_CONSOLIDATION_CHUNK=4
+wear_leveling_deferred_consolidation_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_deferred_consolidation.cpp
+wear_leveling_deferred_consolidation_INC := \
+	$(wear_leveling_common_INC)
+
+eeprom_write_back_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024 \
+	-DEEPROM_DRIVER \
+	-DEEPROM_WEAR_LEVELING \
+	-DEEPROM_WRITE_BACK_CACHE \
+	-DEEPROM_WRITE_BACK_CACHE_SIZE=64 \
+	-DEEPROM_WRITE_BACK_FLUSH_DELAY=100
+eeprom_write_back_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(DRIVER_PATH)/eeprom/eeprom_driver.c \
+	$(DRIVER_PATH)/eeprom/eeprom_wear_leveling.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/wear_leveling/tests/eeprom_write_back.cpp
+eeprom_write_back_INC := \
+	$(wear_leveling_common_INC) \
+	$(DRIVER_PATH)/eeprom
@@ -0,0 +1,226 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingDeferredConsolidation : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+    wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+        memcpy(&verify_data[address], value, length);
+        return wear_leveling_write(address, value, length);
+    }
+
+    /**
+     * Fills the write log with single-byte writes until a consolidation is scheduled.
+     */
+    void write_until_scheduled(uint8_t seed) {
+        for (uint32_t address = 0; !wear_leveling_consolidation_pending(); address = (address + 1) % WEAR_LEVELING_LOGICAL_SIZE) {
+            uint8_t value = seed + address;
+            ASSERT_EQ(test_write(address, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        }
+    }
+
+    /**
+     * Runs wear_leveling_task() until the consolidation completes, returning the number of calls taken.
+     */
+    int run_consolidation() {
+        int steps = 0;
+        while (wear_leveling_consolidation_pending() && steps < 1000) {
+            wear_leveling_task();
+            ++steps;
+        }
+        return steps;
+    }
+
+    /**
+     * Re-initialises as after a power cycle, and returns what reads back.
+     */
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> read_after_reboot() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+        EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init returned incorrect status";
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        return readback;
+    }
+};
+
+/**
+ * This test verifies that filling the write log past the headroom schedules a consolidation rather than performing one.
+ */
+TEST_F(WearLevelingDeferredConsolidation, NearlyFullLogSchedulesConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_scheduled(0x20);
+
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Consolidation should not have been performed in-line";
+    EXPECT_TRUE(wear_leveling_consolidation_pending()) << "Consolidation should have been scheduled";
+    EXPECT_EQ(inst.log_end() - inst.log_begin(), (WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_CONSOLIDATION_HEADROOM - WEAR_LEVELING_LOGICAL_SIZE - 8) / BACKING_STORE_WRITE_SIZE) << "Write log should have been filled up to the headroom";
+}
+
+/**
+ * This test verifies that each wear_leveling_task() call does a bounded amount of work, in the order erase, consolidated data, checksum.
+ */
+TEST_F(WearLevelingDeferredConsolidation, TaskSpreadsTheWork) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_scheduled(0x20);
+
+    auto log_start = inst.log_end() - inst.log_begin();
+    int  steps     = 0;
+    for (wear_leveling_status_t status = WEAR_LEVELING_SUCCESS; status != WEAR_LEVELING_CONSOLIDATED; ++steps) {
+        uint64_t erases = inst.erase_invoke_count();
+        uint64_t writes = inst.write_invoke_count();
+        status          = wear_leveling_task();
+        ASSERT_NE(status, WEAR_LEVELING_FAILED) << "Task returned incorrect status";
+        EXPECT_LE(inst.erase_invoke_count() - erases, 1) << "Too many erases in one step";
+        EXPECT_LE(inst.write_invoke_count() - writes, std::max(WEAR_LEVELING_CONSOLIDATION_CHUNK, 8) / BACKING_STORE_WRITE_SIZE) << "Too many writes in one step";
+        EXPECT_LT(steps, 100) << "Consolidation never completed";
+    }
+    EXPECT_EQ(steps, 1 + (WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATION_CHUNK) + 1) << "Expected an erase, the consolidated data, then the checksum";
+    EXPECT_FALSE(wear_leveling_consolidation_pending());
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Idle task should do nothing";
+
+    // The erase comes first, and the checksum last
+    auto entry = inst.log_begin() + log_start;
+    EXPECT_TRUE(entry->erased) << "Expected the erase first";
+    for (++entry; entry != inst.log_end(); ++entry) {
+        EXPECT_FALSE(entry->erased);
+        auto index = entry - (inst.log_begin() + log_start) - 1;
+        EXPECT_EQ(entry->address, index * BACKING_STORE_WRITE_SIZE) << "Consolidated data written out of order";
+    }
+
+    EXPECT_EQ(read_after_reboot(), verify_data) << "Invalid readback";
+    EXPECT_FALSE(wear_leveling_consolidation_pending()) << "Write log should have been cleared";
+}
+
+/**
+ * This test verifies that writes still go to the write log before the backing store has been erased.
+ */
+TEST_F(WearLevelingDeferredConsolidation, WriteWhilePendingIsLogged) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_scheduled(0x20);
+
+    uint8_t value = 0x77;
+    EXPECT_EQ(test_write(0x0A, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Consolidation should not have been performed in-line";
+    EXPECT_EQ((inst.log_end() - 1)->address, WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_CONSOLIDATION_HEADROOM) << "Write should have been appended to the log";
+
+    run_consolidation();
+    EXPECT_EQ(read_after_reboot(), verify_data) << "Invalid readback";
+}
+
+/**
+ * This test verifies that a write after the erase completes the consolidation before it is logged.
+ */
+TEST_F(WearLevelingDeferredConsolidation, WriteWhileWritingFinishesConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_scheduled(0x20);
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Erase step returned incorrect status";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "First chunk returned incorrect status";
+
+    uint8_t value = 0x77;
+    EXPECT_EQ(test_write(0x00, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_FALSE(wear_leveling_consolidation_pending()) << "Consolidation should have been completed";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Only the one erase should have occurred";
+    EXPECT_EQ((inst.log_end() - 1)->address, WEAR_LEVELING_LOGICAL_SIZE + 8) << "Write should start the new write log";
+
+    EXPECT_EQ(read_after_reboot(), verify_data) << "Invalid readback";
+}
+
+/**
+ * This test verifies that if the write log fills before the task gets a chance to run, it is consolidated in-line.
+ */
+TEST_F(WearLevelingDeferredConsolidation, FullLogConsolidatesInline) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_scheduled(0x20);
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint32_t address = 0; status == WEAR_LEVELING_SUCCESS; ++address) {
+        uint8_t value = 0x40 + address;
+        status        = test_write(address, &value, sizeof(value));
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Write returned incorrect status";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Consolidation should have been performed in-line";
+    EXPECT_FALSE(wear_leveling_consolidation_pending()) << "Consolidation should no longer be scheduled";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Idle task should do nothing";
+
+    EXPECT_EQ(read_after_reboot(), verify_data) << "Invalid readback";
+}
+
+/**
+ * This test verifies that a failed write during consolidation restarts it from the erase.
+ */
+TEST_F(WearLevelingDeferredConsolidation, FailedWriteRestartsConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_scheduled(0x20);
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Erase step returned incorrect status";
+
+    inst.set_write_callback([](std::uint64_t, std::uint32_t address) { return address != WEAR_LEVELING_CONSOLIDATION_CHUNK; });
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "First chunk returned incorrect status";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Second chunk should have failed";
+    EXPECT_TRUE(wear_leveling_consolidation_pending()) << "Consolidation should still be scheduled";
+
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+    run_consolidation();
+    EXPECT_EQ(inst.erasure_count(), 2) << "Consolidation should have restarted with an erase";
+    EXPECT_EQ(read_after_reboot(), verify_data) << "Invalid readback";
+}
+
+/**
+ * This test cuts the power at every write and erase of a deferred consolidation in turn. Afterwards, each logical byte must
+ * read back as either its latest value or, should power have been lost between the erase and the checksum, as erased --
+ * never a stale or corrupted value. Power lost before the erase or after the checksum must lose nothing.
+ */
+TEST_F(WearLevelingDeferredConsolidation, PowerLossAtEveryStep) {
+    auto& inst  = MockBackingStore::Instance();
+    auto  setup = [&]() {
+        inst.reset_instance();
+        verify_data.fill(0);
+        ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+
+        // Consolidated data underneath a write log of newer values
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> block;
+        std::iota(block.begin(), block.end(), 0x80);
+        ASSERT_EQ(test_write(0, block.data(), block.size()), WEAR_LEVELING_CONSOLIDATED);
+        write_until_scheduled(0x20);
+    };
+
+    // Find out how many operations a whole consolidation takes
+    setup();
+    uint64_t first_operation = inst.operation_count();
+    run_consolidation();
+    uint64_t operations = inst.operation_count() - first_operation;
+    ASSERT_GT(operations, BACKING_STORE_ELEMENT_COUNT::value) << "Expected at least the erase";
+
+    for (uint64_t cut = 0; cut <= operations; ++cut) {
+        setup();
+        auto expected = verify_data;
+        inst.set_power_loss_after(cut);
+        for (int steps = 0; wear_leveling_consolidation_pending() && !inst.has_lost_power() && steps < 1000; ++steps) {
+            wear_leveling_task();
+        }
+        inst.restore_power();
+
+        auto readback = read_after_reboot();
+        if (cut == 0 || cut == operations) {
+            EXPECT_EQ(readback, expected) << "Data lost with power cut after " << cut << " operations";
+        } else {
+            for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+                EXPECT_TRUE(readback[i] == expected[i] || readback[i] == 0) << "Power cut after " << cut << " operations, byte " << i << " read back as " << +readback[i];
+            }
+        }
+
+        // The store must remain usable afterwards
+        uint8_t value = 0x55;
+        EXPECT_NE(wear_leveling_write(0x03, &value, sizeof(value)), WEAR_LEVELING_FAILED) << "Write failed after power cut after " << cut << " operations";
+        run_consolidation();
+        EXPECT_EQ(read_after_reboot()[0x03], value) << "Write lost after power cut after " << cut << " operations";
+    }
+}
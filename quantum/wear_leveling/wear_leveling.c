@@ -61,6 +61,14 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_CONSOLIDATION_HEADROOM: With deferred consolidation,
+            the number of bytes left in the write log at which consolidation is
+            scheduled. This must be a multiple of the write size.
+
+        - WEAR_LEVELING_CONSOLIDATION_CHUNK: With deferred consolidation, the
+            number of bytes of consolidated data written per call to
+            wear_leveling_task(). This must be a multiple of the write size.
+
     General algorithm:
 
         During initialization:
@@ -76,6 +84,20 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        With WEAR_LEVELING_DEFERRED_CONSOLIDATION, consolidation is instead
+        scheduled once less than WEAR_LEVELING_CONSOLIDATION_HEADROOM bytes of
+        the log remain, and wear_leveling_task() carries it out over several
+        calls:
+            * The backing store is erased.
+            * The cache is written to the consolidated data section, up to
+                WEAR_LEVELING_CONSOLIDATION_CHUNK bytes per call.
+            * The checksum is written last, so a consolidation cut short is
+                seen as invalid consolidated data on the next init.
+        Writes while the store is erased but not yet fully rewritten complete
+        the consolidation first, so the log is never appended to without valid
+        consolidated data underneath it. Should the log still fill up before
+        the consolidation starts, it is consolidated in-line as before.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -155,6 +177,17 @@
         ╚════════════════╝
         0 <= Address <= 0x3FFE (16382) */
 
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+/**
+ * Deferred consolidation progress.
+ */
+typedef enum consolidation_state_t {
+    CONSOLIDATION_IDLE,    //< Nothing scheduled
+    CONSOLIDATION_PENDING, //< Log is nearly full, the backing store is yet to be erased
+    CONSOLIDATION_WRITING  //< Backing store erased, consolidated data partially written
+} consolidation_state_t;
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
+
 /**
  * Storage area for the wear-leveling cache.
  */
@@ -162,6 +195,10 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+    consolidation_state_t consolidation_state;
+    uint32_t              consolidation_address;
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
 } wear_leveling;
 
 /**
@@ -203,6 +240,9 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+    wear_leveling.consolidation_state = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
 }
 
 /**
@@ -248,6 +288,36 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     return status;
 }
 
+/**
+ * Writes the FNV1a_64 of the cache after the consolidated data, marking the consolidated data as valid.
+ * Pre-condition: the cache has been written to the consolidated data area.
+ */
+static wear_leveling_status_t wear_leveling_write_checksum(void) {
+    wear_leveling_status_t status = WEAR_LEVELING_CONSOLIDATED;
+    write_log_entry_t      entry;
+    entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+    wl_dprintf("Writing checksum\n");
+    do {
+#if BACKING_STORE_WRITE_SIZE == 2
+        if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
+            status = WEAR_LEVELING_FAILED;
+            break;
+        }
+#elif BACKING_STORE_WRITE_SIZE == 4
+        if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
+            status = WEAR_LEVELING_FAILED;
+            break;
+        }
+#elif BACKING_STORE_WRITE_SIZE == 8
+        if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
+            status = WEAR_LEVELING_FAILED;
+            break;
+        }
+#endif
+    } while (0);
+    return status;
+}
+
 /**
  * Writes the current cache to consolidated data at the beginning of the backing store.
  * Does not clear the write log.
@@ -264,28 +334,7 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
     }
 
     if (status != WEAR_LEVELING_FAILED) {
-        // Write out the FNV1a_64 result of the consolidated data
-        write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        status = wear_leveling_write_checksum();
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -317,6 +366,10 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+    // Anything scheduled or half-done has just been superseded
+    wear_leveling.consolidation_state = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
 
     return status;
 }
@@ -333,9 +386,97 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
         return wear_leveling_consolidate_force();
     }
 
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+    // Leave the consolidation to wear_leveling_task() while there's still room in the log
+    if (wear_leveling.consolidation_state == CONSOLIDATION_IDLE && wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE) - (WEAR_LEVELING_CONSOLIDATION_HEADROOM)) {
+        wl_dprintf("Write log nearly full, scheduling consolidation\n");
+        wear_leveling.consolidation_state = CONSOLIDATION_PENDING;
+    }
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
+
     return WEAR_LEVELING_SUCCESS;
 }
 
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+/**
+ * Performs the next step of a deferred consolidation: the erase, a chunk of the consolidated data, or the checksum.
+ * Any failure restarts the consolidation from the erase, as partially-written values cannot be written over.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the checksum has been written
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    switch (wear_leveling.consolidation_state) {
+        case CONSOLIDATION_PENDING:
+            wl_dprintf("Erasing backing store\n");
+            if (!backing_store_erase()) {
+                wl_dprintf("Failed to erase backing store\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+            wear_leveling.consolidation_state   = CONSOLIDATION_WRITING;
+            wear_leveling.consolidation_address = 0;
+            break;
+
+        case CONSOLIDATION_WRITING:
+            if (wear_leveling.consolidation_address < (WEAR_LEVELING_LOGICAL_SIZE)) {
+                uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE) - wear_leveling.consolidation_address;
+                if (length > (WEAR_LEVELING_CONSOLIDATION_CHUNK)) {
+                    length = (WEAR_LEVELING_CONSOLIDATION_CHUNK);
+                }
+                wl_dprintf("Writing consolidated data at 0x%04X\n", (int)wear_leveling.consolidation_address);
+                if (!backing_store_write_bulk(wear_leveling.consolidation_address, (backing_store_int_t *)&wear_leveling.cache[wear_leveling.consolidation_address], length / sizeof(backing_store_int_t))) {
+                    wl_dprintf("Failed to write to backing store\n");
+                    wear_leveling.consolidation_state = CONSOLIDATION_PENDING;
+                    status                            = WEAR_LEVELING_FAILED;
+                    break;
+                }
+                wear_leveling.consolidation_address += length;
+                break;
+            }
+
+            status = wear_leveling_write_checksum();
+            if (status == WEAR_LEVELING_FAILED) {
+                wear_leveling.consolidation_state = CONSOLIDATION_PENDING;
+                break;
+            }
+            wear_leveling.write_address       = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+            wear_leveling.consolidation_state = CONSOLIDATION_IDLE;
+            break;
+
+        default:
+            break;
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+    return status;
+}
+
+/**
+ * Completes a deferred consolidation which has already erased the backing store.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_finish(void) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    while (wear_leveling.consolidation_state == CONSOLIDATION_WRITING) {
+        status = wear_leveling_consolidate_step();
+        if (status == WEAR_LEVELING_FAILED) {
+            break;
+        }
+    }
+    return status;
+}
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
+
 /**
  * Appends the supplied fixed-width entry to the write log, optionally consolidating if the log is full.
  *
@@ -490,6 +631,15 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         if (value == 0) {
             wl_dprintf("Found empty slot, no more log entries\n");
             cancel_playback = true;
+            // An erase interrupted by power loss can leave stale entries after the gap, which later writes would join back
+            // onto the log -- treat them as corruption so the backing store gets erased properly.
+            for (uint32_t stale = address + (BACKING_STORE_WRITE_SIZE); stale < (WEAR_LEVELING_BACKING_SIZE); stale += (BACKING_STORE_WRITE_SIZE)) {
+                if (backing_store_read(stale, &value) && value != 0) {
+                    wl_dprintf("Found stale log entries after the end of the write log\n");
+                    status = WEAR_LEVELING_FAILED;
+                    break;
+                }
+            }
             break;
         }
 
@@ -688,6 +838,15 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         return true;
     }
 
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+    // The log is only valid on top of complete consolidated data, so finish writing it out before the cache changes
+    if (wear_leveling_consolidate_finish() == WEAR_LEVELING_FAILED) {
+        // Keep the value in the cache, the consolidation will be retried with it included
+        memcpy(&wear_leveling.cache[address], value, length);
+        return WEAR_LEVELING_FAILED;
+    }
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
+
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
@@ -726,6 +885,25 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+/**
+ * Advances any scheduled consolidation by a single step.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+    if (wear_leveling.consolidation_state == CONSOLIDATION_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+    return wear_leveling_consolidate_step();
+}
+
+/**
+ * Whether wear_leveling_task() has consolidation work outstanding.
+ */
+bool wear_leveling_consolidation_pending(void) {
+    return wear_leveling.consolidation_state != CONSOLIDATION_IDLE;
+}
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
+
 /**
  * Reads logical data from the cache.
  */
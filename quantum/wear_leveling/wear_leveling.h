@@ -1,6 +1,7 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -52,3 +53,18 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Advances a deferred consolidation of the write log by a single step -- an erase, a chunk of the consolidated data, or
+ * the checksum. Only available with WEAR_LEVELING_DEFERRED_CONSOLIDATION, and invoked from housekeeping_task().
+ *
+ * @return Status of the request, WEAR_LEVELING_CONSOLIDATED once the final step has completed
+ */
+wear_leveling_status_t wear_leveling_task(void);
+
+/**
+ * Whether a deferred consolidation is scheduled or in progress.
+ *
+ * @return true if wear_leveling_task() has work outstanding
+ */
+bool wear_leveling_consolidation_pending(void);
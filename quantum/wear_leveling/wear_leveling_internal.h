@@ -27,6 +27,16 @@ typedef uint64_t backing_store_int_t;
 #    error WEAR_LEVELING_LOGICAL_SIZE was not set.
 #endif
 
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+#    ifndef WEAR_LEVELING_CONSOLIDATION_HEADROOM
+// A quarter of the write log, rounded down to the write size
+#        define WEAR_LEVELING_CONSOLIDATION_HEADROOM (((WEAR_LEVELING_BACKING_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE) - 8) / 4 / (BACKING_STORE_WRITE_SIZE) * (BACKING_STORE_WRITE_SIZE))
+#    endif
+#    ifndef WEAR_LEVELING_CONSOLIDATION_CHUNK
+#        define WEAR_LEVELING_CONSOLIDATION_CHUNK 32
+#    endif
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
+
 #ifdef WEAR_LEVELING_DEBUG_OUTPUT
 #    include <debug.h>
 #    define bs_dprintf(...) dprintf("Backing store: " __VA_ARGS__)
@@ -65,6 +75,11 @@ typedef uint64_t backing_store_int_t;
 _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+#ifdef WEAR_LEVELING_DEFERRED_CONSOLIDATION
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_HEADROOM % BACKING_STORE_WRITE_SIZE == 0, "Consolidation headroom must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_HEADROOM < WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_LOGICAL_SIZE - 8, "Consolidation headroom must be smaller than the write log");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_CHUNK > 0 && WEAR_LEVELING_CONSOLIDATION_CHUNK % BACKING_STORE_WRITE_SIZE == 0, "Consolidation chunk must be a multiple of write size");
+#endif // WEAR_LEVELING_DEFERRED_CONSOLIDATION
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
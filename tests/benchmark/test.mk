@@ -0,0 +1,7 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+CAPS_WORD_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = test_combos.c
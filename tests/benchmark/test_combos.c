@@ -0,0 +1,15 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+enum combos { jk_esc, df_tab };
+
+uint16_t const jk_combo[] = {KC_J, KC_K, COMBO_END};
+uint16_t const df_combo[] = {KC_D, KC_F, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [jk_esc] = COMBO(jk_combo, KC_ESC),
+    [df_tab] = COMBO(df_combo, KC_TAB)
+};
+// clang-format on
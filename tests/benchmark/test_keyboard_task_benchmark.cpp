@@ -0,0 +1,115 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "test_common.hpp"
+#include "test_benchmark.hpp"
+
+extern "C" {
+#include "basic_profiling.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+
+/* One key of the typing script: pressed at `at` ms for `hold` ms. */
+struct ScriptedPress {
+    uint32_t  at;
+    uint32_t  hold;
+    KeymapKey key;
+};
+
+constexpr uint32_t default_loops = 1000000;
+constexpr uint32_t scans_per_ms  = 10;
+
+} // namespace
+
+class KeyboardTaskBenchmark : public TestFixture {
+   public:
+    void SetUp() override {
+        BenchmarkRecorder::instance().reset();
+    }
+
+    void print_summary() {
+        std::cout << std::left << std::setw(24) << "task" << std::right << std::setw(10) << "count" << std::setw(10) << "mean" << std::setw(8) << "p50" << std::setw(8) << "p90" << std::setw(8) << "p99" << std::setw(10) << "max" << std::endl;
+        for (auto& entry : BenchmarkRecorder::instance().summarize()) {
+            auto& summary = entry.second;
+            std::cout << std::left << std::setw(24) << entry.first << std::right << std::setw(10) << summary.count << std::setw(10) << std::fixed << std::setprecision(1) << summary.mean << std::setw(8) << summary.p50 << std::setw(8) << summary.p90 << std::setw(8) << summary.p99 << std::setw(10) << summary.max << std::endl;
+        }
+    }
+};
+
+TEST_F(KeyboardTaskBenchmark, ScriptedTyping) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    // A home row and a top row, plus the two combos from test_combos.c
+    std::vector<KeymapKey> keys;
+    const uint16_t         keycodes[2][MATRIX_COLS] = {
+        {KC_A, KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L, KC_SCLN},
+        {KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P},
+    };
+    for (uint8_t row = 0; row < 2; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keys.emplace_back(0, col, row, keycodes[row][col]);
+            add_key(keys.back());
+        }
+    }
+
+    // Rolling typing at roughly 120 wpm with overlapping presses, and a combo every 16 keys
+    std::vector<ScriptedPress> script;
+    for (uint32_t i = 0, at = 0; i < 256; i++, at += 100) {
+        if (i % 16 == 15) {
+            script.push_back({at, 40, keys[6]});
+            script.push_back({at + 5, 35, keys[7]});
+        } else {
+            script.push_back({at, 60 + (i % 5) * 10, keys[(i * 7) % keys.size()]});
+        }
+    }
+    const uint32_t script_length = script.back().at + 200;
+
+    const uint32_t loops = BenchmarkRecorder::loops(default_loops);
+    uint32_t       now   = 0;
+    for (uint32_t loop = 0; loop < loops; loop++) {
+        if (loop % scans_per_ms == 0) {
+            // Replay the script in a loop, driving the matrix once per millisecond
+            uint32_t offset = now % script_length;
+            for (auto& press : script) {
+                if (press.at == offset) {
+                    press.key.press();
+                } else if (press.at + press.hold == offset) {
+                    press.key.release();
+                }
+            }
+        }
+
+        PROFILE_TASK(keyboard_task);
+
+        if (loop % scans_per_ms == scans_per_ms - 1) {
+            advance_time(1);
+            now++;
+        }
+    }
+    clear_all_keys();
+    idle_for(TAPPING_TERM * 2);
+
+    auto& recorder = BenchmarkRecorder::instance();
+    EXPECT_TRUE(recorder.has("keyboard_task"));
+    EXPECT_TRUE(recorder.has("matrix_task"));
+    EXPECT_TRUE(recorder.has("quantum_task"));
+    EXPECT_TRUE(recorder.has("combo_task"));
+    EXPECT_TRUE(recorder.has("caps_word_task"));
+    EXPECT_GE(recorder.summarize()["keyboard_task"].count, loops);
+
+    print_summary();
+    std::string path = BenchmarkRecorder::output_path("keyboard_task");
+    EXPECT_TRUE(recorder.write_json(path, {{"benchmark", "keyboard_task"}, {"loops", std::to_string(loops)}, {"scans_per_ms", std::to_string(scans_per_ms)}}));
+    std::cout << "results written to " << path << std::endl;
+}
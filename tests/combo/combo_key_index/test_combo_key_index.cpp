@@ -0,0 +1,151 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+namespace {
+
+constexpr uint16_t combo_total   = 4000;
+constexpr uint16_t ab_combo_idx  = 1234;
+constexpr uint16_t abc_combo_idx = 3000;
+
+std::vector<std::vector<uint16_t>> combo_keys;
+std::vector<combo_t>               combos;
+uint32_t                           combo_get_calls = 0;
+uint16_t                           combos_with_kc_a = 0;
+
+void generate_combos() {
+    combo_keys.resize(combo_total);
+    for (uint16_t i = 0; i < combo_total; i++) {
+        if (i == ab_combo_idx) {
+            combo_keys[i] = {KC_A, KC_B, COMBO_END};
+        } else if (i == abc_combo_idx) {
+            combo_keys[i] = {KC_A, KC_B, KC_C, COMBO_END};
+        } else if (i % 1000 == 7) {
+            // a few unrelated combos sharing KC_A
+            combo_keys[i] = {KC_A, (uint16_t)(QK_USER + i % 64), COMBO_END};
+        } else {
+            // filler combos on keys that are never pressed
+            combo_keys[i] = {(uint16_t)(QK_USER + i % 64), (uint16_t)(QK_USER + (i * 7 + 1) % 64), (uint16_t)(QK_USER + (i * 13 + 2) % 64), COMBO_END};
+        }
+        if (combo_keys[i][0] == KC_A) {
+            combos_with_kc_a++;
+        }
+    }
+
+    combos.resize(combo_total);
+    for (uint16_t i = 0; i < combo_total; i++) {
+        uint16_t keycode = KC_NO;
+        if (i == ab_combo_idx) {
+            keycode = KC_ESC;
+        } else if (i == abc_combo_idx) {
+            keycode = KC_TAB;
+        }
+        combos[i] = (combo_t)COMBO(combo_keys[i], keycode);
+    }
+}
+
+} // namespace
+
+extern "C" {
+uint16_t combo_count(void) {
+    if (combos.empty()) {
+        generate_combos();
+    }
+    return combos.size();
+}
+
+combo_t *combo_get(uint16_t combo_idx) {
+    combo_get_calls++;
+    return &combos[combo_idx];
+}
+}
+
+class ComboKeyIndex : public TestFixture {};
+
+TEST_F(ComboKeyIndex, combo_fires_among_thousands) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 0, 1, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeyIndex, longer_overlapping_combo_wins) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 0, 1, KC_B);
+    KeymapKey  key_c(0, 0, 2, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_TAB));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b, key_c});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeyIndex, non_combo_key_passes_through) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_d(0, 0, 3, KC_D);
+    set_keymap({key_a, key_d});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_D));
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.press();
+    idle_for(COMBO_TERM + 1);
+    tap_key(key_d);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeyIndex, per_event_work_is_bounded_by_candidates) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_d(0, 0, 3, KC_D);
+    set_keymap({key_a, key_d});
+
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    EXPECT_REPORT(driver, (KC_D)).Times(2);
+    EXPECT_EMPTY_REPORT(driver).Times(3);
+
+    // Let the index be built outside of the measured events
+    tap_key(key_d);
+
+    combo_get_calls = 0;
+    key_a.press();
+    run_one_scan_loop();
+    EXPECT_LE(combo_get_calls, combos_with_kc_a);
+
+    idle_for(COMBO_TERM + 1);
+    combo_get_calls = 0;
+    key_a.release();
+    run_one_scan_loop();
+    EXPECT_LE(combo_get_calls, 2u * combos_with_kc_a);
+
+    // A key that is part of no combo touches no combo at all
+    combo_get_calls = 0;
+    tap_key(key_d);
+    EXPECT_EQ(combo_get_calls, 0u);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_GT(combo_count(), 100u * combos_with_kc_a);
+}
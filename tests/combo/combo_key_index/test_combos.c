@@ -0,0 +1,9 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+// The combos under test are generated at runtime by test_combo_key_index.cpp,
+// which overrides combo_count() and combo_get(). Introspection still needs this.
+uint16_t const unused_combo[] = {KC_NO, COMBO_END};
+
+combo_t key_combos[] = {COMBO(unused_combo, KC_NO)};
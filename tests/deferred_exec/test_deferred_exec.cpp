@@ -0,0 +1,209 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+
+void advance_time(uint32_t ms);
+}
+
+#define TEST_EXECUTOR_COUNT 16
+
+struct Invocation {
+    uint32_t trigger_time;
+    uint32_t now;
+    int      id;
+};
+
+class DeferredExec;
+
+struct TestCallbackArg {
+    DeferredExec *fixture;
+    int           id;
+    uint32_t      repeat_ms;
+};
+
+class DeferredExec : public TestFixture {
+   public:
+    deferred_executor_t     table[TEST_EXECUTOR_COUNT] = {};
+    uint32_t                last_execution_time        = 0;
+    std::vector<Invocation> invocations;
+    deferred_token          cancel_on_invoke = INVALID_DEFERRED_TOKEN;
+
+    static uint32_t callback(uint32_t trigger_time, void *cb_arg) {
+        TestCallbackArg *arg = (TestCallbackArg *)cb_arg;
+        arg->fixture->invocations.push_back({trigger_time, timer_read32(), arg->id});
+        if (arg->fixture->cancel_on_invoke != INVALID_DEFERRED_TOKEN) {
+            cancel_deferred_exec_advanced(arg->fixture->table, TEST_EXECUTOR_COUNT, arg->fixture->cancel_on_invoke);
+            arg->fixture->cancel_on_invoke = INVALID_DEFERRED_TOKEN;
+        }
+        return arg->repeat_ms;
+    }
+
+    deferred_token defer(uint32_t delay_ms, TestCallbackArg *arg) {
+        arg->fixture = this;
+        return defer_exec_advanced(table, TEST_EXECUTOR_COUNT, delay_ms, callback, arg);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_advanced_task(table, TEST_EXECUTOR_COUNT, &last_execution_time);
+        }
+    }
+};
+
+TEST_F(DeferredExec, FiresAfterDelay) {
+    TestCallbackArg arg = {nullptr, 1, 0};
+    EXPECT_NE(defer(100, &arg), INVALID_DEFERRED_TOKEN);
+
+    run_for(99);
+    EXPECT_TRUE(invocations.empty());
+
+    run_for(1);
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].trigger_time, 100);
+    EXPECT_EQ(invocations[0].now, 100);
+
+    run_for(200);
+    EXPECT_EQ(invocations.size(), 1);
+}
+
+TEST_F(DeferredExec, FiresInTriggerOrder) {
+    TestCallbackArg args[5] = {{nullptr, 0, 0}, {nullptr, 1, 0}, {nullptr, 2, 0}, {nullptr, 3, 0}, {nullptr, 4, 0}};
+    uint32_t        delays[5] = {50, 10, 40, 20, 30};
+    for (int i = 0; i < 5; i++) {
+        EXPECT_NE(defer(delays[i], &args[i]), INVALID_DEFERRED_TOKEN);
+    }
+
+    run_for(50);
+    ASSERT_EQ(invocations.size(), 5);
+    int expected_order[5] = {1, 3, 4, 2, 0};
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(invocations[i].id, expected_order[i]);
+        EXPECT_EQ(invocations[i].now, delays[expected_order[i]]);
+    }
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToTriggerTime) {
+    TestCallbackArg arg = {nullptr, 1, 25};
+    EXPECT_NE(defer(10, &arg), INVALID_DEFERRED_TOKEN);
+
+    run_for(100);
+    ASSERT_EQ(invocations.size(), 4);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(invocations[i].trigger_time, 10 + 25 * i);
+    }
+}
+
+TEST_F(DeferredExec, CatchesUpOneInvocationPerTick) {
+    TestCallbackArg arg = {nullptr, 1, 5};
+    EXPECT_NE(defer(5, &arg), INVALID_DEFERRED_TOKEN);
+
+    // Stall the task for a while, then let it catch up
+    advance_time(20);
+    run_for(1);
+    EXPECT_EQ(invocations.size(), 1);
+    run_for(1);
+    EXPECT_EQ(invocations.size(), 2);
+    EXPECT_EQ(invocations[1].trigger_time, 10);
+}
+
+TEST_F(DeferredExec, CatchingUpDoesNotStarveOthers) {
+    TestCallbackArg repeating = {nullptr, 1, 2};
+    TestCallbackArg once      = {nullptr, 2, 0};
+    EXPECT_NE(defer(5, &repeating), INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(defer(8, &once), INVALID_DEFERRED_TOKEN);
+
+    // Both are due after the stall. Requeued, the repeating one is still due and earlier than the other, which must
+    // still run on the same tick
+    advance_time(20);
+    run_for(1);
+    ASSERT_EQ(invocations.size(), 2);
+    EXPECT_EQ(invocations[0].id, 1);
+    EXPECT_EQ(invocations[0].trigger_time, 5);
+    EXPECT_EQ(invocations[1].id, 2);
+    EXPECT_EQ(invocations[1].trigger_time, 8);
+    EXPECT_EQ(invocations[0].now, invocations[1].now);
+}
+
+TEST_F(DeferredExec, ExtendAndCancel) {
+    TestCallbackArg a     = {nullptr, 1, 0};
+    TestCallbackArg b     = {nullptr, 2, 0};
+    deferred_token  tok_a = defer(10, &a);
+    deferred_token  tok_b = defer(20, &b);
+
+    run_for(5);
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, TEST_EXECUTOR_COUNT, tok_a, 30));
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TEST_EXECUTOR_COUNT, tok_b));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TEST_EXECUTOR_COUNT, tok_b));
+
+    run_for(100);
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].id, 1);
+    EXPECT_EQ(invocations[0].now, 35);
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TEST_EXECUTOR_COUNT, tok_a, 30));
+}
+
+TEST_F(DeferredExec, CallbackCancelsPendingExecutor) {
+    TestCallbackArg a = {nullptr, 1, 0};
+    TestCallbackArg b = {nullptr, 2, 0};
+    TestCallbackArg c = {nullptr, 3, 0};
+    defer(10, &a);
+    cancel_on_invoke = defer(10, &b);
+    defer(10, &c);
+
+    run_for(20);
+    ASSERT_EQ(invocations.size(), 2);
+    EXPECT_NE(invocations[0].id, 2);
+    EXPECT_NE(invocations[1].id, 2);
+}
+
+TEST_F(DeferredExec, RejectsWhenTableFull) {
+    TestCallbackArg args[TEST_EXECUTOR_COUNT + 1];
+    for (int i = 0; i < TEST_EXECUTOR_COUNT; i++) {
+        args[i] = {nullptr, i, 0};
+        EXPECT_NE(defer(100 + i, &args[i]), INVALID_DEFERRED_TOKEN);
+    }
+    args[TEST_EXECUTOR_COUNT] = {nullptr, TEST_EXECUTOR_COUNT, 0};
+    EXPECT_EQ(defer(1, &args[TEST_EXECUTOR_COUNT]), INVALID_DEFERRED_TOKEN);
+
+    run_for(100);
+    EXPECT_EQ(invocations.size(), 1);
+    EXPECT_NE(defer(1, &args[TEST_EXECUTOR_COUNT]), INVALID_DEFERRED_TOKEN);
+}
+
+TEST_F(DeferredExec, ReportsNextTrigger) {
+    uint32_t next = 0;
+    EXPECT_FALSE(deferred_exec_advanced_next_trigger(table, TEST_EXECUTOR_COUNT, &next));
+
+    TestCallbackArg a     = {nullptr, 1, 0};
+    TestCallbackArg b     = {nullptr, 2, 0};
+    deferred_token  tok_b = defer(40, &b);
+    defer(60, &a);
+    EXPECT_TRUE(deferred_exec_advanced_next_trigger(table, TEST_EXECUTOR_COUNT, &next));
+    EXPECT_EQ(next, 40);
+
+    cancel_deferred_exec_advanced(table, TEST_EXECUTOR_COUNT, tok_b);
+    EXPECT_TRUE(deferred_exec_advanced_next_trigger(table, TEST_EXECUTOR_COUNT, &next));
+    EXPECT_EQ(next, 60);
+
+    run_for(60);
+    EXPECT_FALSE(deferred_exec_advanced_next_trigger(table, TEST_EXECUTOR_COUNT, &next));
+}
+
+TEST_F(DeferredExec, BasicApiReportsNextTrigger) {
+    TestCallbackArg arg   = {this, 1, 0};
+    uint32_t        next  = 0;
+    deferred_token  token = defer_exec(25, callback, &arg);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+    EXPECT_TRUE(deferred_exec_next_trigger(&next));
+    EXPECT_EQ(next, 25);
+
+    EXPECT_TRUE(cancel_deferred_exec(token));
+    EXPECT_FALSE(deferred_exec_next_trigger(&next));
+}
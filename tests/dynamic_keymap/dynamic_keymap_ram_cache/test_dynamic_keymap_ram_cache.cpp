@@ -0,0 +1,83 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "keymap_introspection.h"
+#include "eeprom.h"
+
+uint32_t eeprom_get_read_count(void);
+void     eeprom_reset_read_count(void);
+}
+
+class DynamicKeymapRamCache : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_init();
+        for (uint8_t layer = 1; layer < dynamic_keymap_get_layer_count(); layer++) {
+            dynamic_keymap_set_keycode(layer, 1, 2, KC_TRANSPARENT);
+        }
+        dynamic_keymap_set_keycode(0, 1, 2, KC_A);
+    }
+
+    /* Same walk as layer_switch_get_layer(): top-most active layer down to the first non-transparent key. */
+    uint16_t resolve_keycode(layer_state_t state, uint8_t row, uint8_t col) {
+        for (int8_t layer = dynamic_keymap_get_layer_count() - 1; layer >= 0; layer--) {
+            if (state & ((layer_state_t)1 << layer)) {
+                uint16_t keycode = keycode_at_keymap_location(layer, row, col);
+                if (keycode != KC_TRANSPARENT) {
+                    return keycode;
+                }
+            }
+        }
+        return keycode_at_keymap_location(0, row, col);
+    }
+};
+
+TEST_F(DynamicKeymapRamCache, KeypressDoesNotReadEeprom) {
+    layer_state_t all_layers = ((layer_state_t)1 << dynamic_keymap_get_layer_count()) - 1;
+
+    eeprom_reset_read_count();
+    EXPECT_EQ(resolve_keycode(1, 1, 2), KC_A);
+    EXPECT_EQ(resolve_keycode(all_layers, 1, 2), KC_A);
+    EXPECT_EQ(eeprom_get_read_count(), 0);
+}
+
+TEST_F(DynamicKeymapRamCache, SetKeycodeWritesThrough) {
+    dynamic_keymap_set_keycode(2, 3, 4, KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(2, 3, 4), KC_B);
+
+    // The EEPROM copy must match so the cache can be reloaded on the next boot
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(2, 3, 4);
+    EXPECT_EQ((eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1), KC_B);
+}
+
+TEST_F(DynamicKeymapRamCache, SetBufferWritesThrough) {
+    uint8_t data[] = {0x12, 0x34, 0x56};
+
+    // Start on the low byte of (0, 0, 0) so the write straddles two keycodes
+    dynamic_keymap_set_buffer(1, sizeof(data), data);
+
+    eeprom_reset_read_count();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0) & 0xFF, 0x12);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), 0x3456);
+    EXPECT_EQ(eeprom_get_read_count(), 0);
+
+    uint8_t readback[sizeof(data)];
+    dynamic_keymap_get_buffer(1, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(data, readback, sizeof(data)), 0);
+}
+
+TEST_F(DynamicKeymapRamCache, InitReloadsFromEeprom) {
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(1, 0, 0);
+    eeprom_update_byte(address, KC_C >> 8);
+    eeprom_update_byte(address + 1, KC_C & 0xFF);
+    EXPECT_NE(dynamic_keymap_get_keycode(1, 0, 0), KC_C);
+
+    dynamic_keymap_init();
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_C);
+}
@@ -0,0 +1,12 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define KEYBOARD_IDLE_SLEEP
+#define KEYBOARD_IDLE_SCAN_INTERVAL 50
+
+#define CAPS_WORD_IDLE_TIMEOUT 500
+#define ONESHOT_TIMEOUT 300
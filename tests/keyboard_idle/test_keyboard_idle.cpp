@@ -0,0 +1,164 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+namespace {
+
+/* A press or release of a key, `at` milliseconds after the start of the run. */
+struct ScriptedEvent {
+    uint32_t   at;
+    KeymapKey *key;
+    bool       pressed;
+};
+
+/* Something observable the firmware did, relative to the start of the run. */
+struct Observation {
+    uint32_t             at;
+    std::vector<uint8_t> report;
+
+    bool operator==(const Observation &other) const {
+        return at == other.at && report == other.report;
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const Observation &observation) {
+    os << "@" << observation.at << "ms [";
+    for (auto byte : observation.report) {
+        os << " " << +byte;
+    }
+    return os << " ]";
+}
+
+std::vector<Observation> *observations = nullptr;
+uint32_t                  run_start    = 0;
+
+uint32_t deferred_tap(uint32_t trigger_time, void *cb_arg) {
+    tap_code(KC_X);
+    return 0;
+}
+
+} // namespace
+
+extern "C" void caps_word_set_user(bool active) {
+    // Caps Word turning itself off after the idle timeout doesn't send a report, so record it directly
+    if (observations) {
+        observations->push_back({timer_read32() - run_start, {0xFF, active}});
+    }
+}
+
+class KeyboardIdle : public TestFixture {
+   public:
+    KeymapKey key_mt  = KeymapKey(0, 0, 0, SFT_T(KC_A));
+    KeymapKey key_b   = KeymapKey(0, 1, 0, KC_B);
+    KeymapKey key_j   = KeymapKey(0, 2, 0, KC_J);
+    KeymapKey key_k   = KeymapKey(0, 3, 0, KC_K);
+    KeymapKey key_td  = KeymapKey(0, 4, 0, TD(0));
+    KeymapKey key_osm = KeymapKey(0, 5, 0, OSM(MOD_LSFT));
+    KeymapKey key_cw  = KeymapKey(0, 6, 0, CW_TOGG);
+
+    std::vector<ScriptedEvent> script;
+    uint32_t                   script_length = 0;
+
+    void SetUp() override {
+        set_keymap({key_mt, key_b, key_j, key_k, key_td, key_osm, key_cw});
+
+        uint32_t at = 10;
+        auto     tap = [&](KeymapKey &key, uint32_t hold, uint32_t gap) {
+            script.push_back({at, &key, true});
+            script.push_back({at + hold, &key, false});
+            at += hold + gap;
+        };
+
+        tap(key_mt, 50, 400);  // mod-tap tapped
+        tap(key_mt, 350, 400); // mod-tap held past the tapping term
+        tap(key_j, 30, 400);   // combo key alone, resolved by the combo term
+        script.push_back({at, &key_j, true});
+        script.push_back({at + 10, &key_k, true});
+        script.push_back({at + 60, &key_j, false});
+        script.push_back({at + 70, &key_k, false});
+        at += 500;
+        tap(key_td, 40, 600);         // single tap dance, finished by the tapping term
+        tap(key_td, 40, 60);          // double tap dance
+        tap(key_td, 40, 600);         //
+        tap(key_osm, 40, 500);        // one-shot shift, timed out
+        tap(key_b, 40, 100);          //
+        tap(key_cw, 40, 100);         // Caps Word, timed out
+        tap(key_b, 40, 900);          //
+        script_length = at + 2000; // leaves the deferred executor below to fire on its own
+        std::stable_sort(script.begin(), script.end(), [](const ScriptedEvent &a, const ScriptedEvent &b) { return a.at < b.at; });
+    }
+
+    /* Plays the script back, either scanning every millisecond or sleeping until the reported deadline or the next scripted
+     * event, standing in for a matrix interrupt. Returns the number of times keyboard_task() ran. */
+    uint32_t play(bool idle, std::vector<Observation> &result) {
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            result.push_back({timer_read32() - run_start, std::vector<uint8_t>((uint8_t *)&report, (uint8_t *)&report + sizeof(report))});
+        }));
+        observations = &result;
+        run_start    = timer_read32();
+
+        defer_exec(script_length - 500, deferred_tap, NULL);
+
+        uint32_t scans = 0;
+        size_t   next  = 0;
+        uint32_t now   = 0;
+        while (now < script_length) {
+            for (; next < script.size() && script[next].at == now; next++) {
+                if (script[next].pressed) {
+                    script[next].key->press();
+                } else {
+                    script[next].key->release();
+                }
+            }
+
+            keyboard_task();
+            deferred_exec_task();
+            scans++;
+
+            uint32_t wake = now + 1;
+            if (idle) {
+                wake = keyboard_next_deadline() - run_start;
+                EXPECT_GT(wake, now);
+                if (next < script.size()) {
+                    wake = std::min(wake, script[next].at);
+                }
+                wake = std::min(wake, script_length);
+            }
+            advance_time(wake - now);
+            now = wake;
+        }
+
+        observations = nullptr;
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return scans;
+    }
+};
+
+TEST_F(KeyboardIdle, ReportTimingMatchesBusyLoop) {
+    std::vector<Observation> busy;
+    std::vector<Observation> idle;
+
+    uint32_t busy_scans = play(false, busy);
+    uint32_t idle_scans = play(true, idle);
+
+    EXPECT_FALSE(busy.empty());
+    EXPECT_EQ(idle, busy);
+
+    // Sleeping between deadlines should skip the vast majority of scans
+    EXPECT_LT(idle_scans * 4, busy_scans);
+}
@@ -0,0 +1,71 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerLookupCacheStrict : public TestFixture {
+   public:
+    /* The layer walk layer_switch_get_layer() does without the cache. */
+    uint8_t walk_layers(keypos_t key) {
+        layer_state_t layers = layer_state | default_layer_state;
+        for (int8_t layer = MAX_LAYER - 1; layer >= 0; layer--) {
+            if ((layers & ((layer_state_t)1 << layer)) && action_for_key(layer, key).code != ACTION_TRANSPARENT) {
+                return layer;
+            }
+        }
+        return 0;
+    }
+};
+
+TEST_F(LayerLookupCacheStrict, MatchesLayerWalkForRandomLayerStates) {
+    std::mt19937 rng(5);
+    set_keymap({});
+    for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+        add_key(KeymapKey{layer, 0, 0, (rng() % 3) ? (uint16_t)KC_TRANSPARENT : (uint16_t)KC_A});
+    }
+
+    keypos_t key = {.col = 0, .row = 0};
+    for (int i = 0; i < 500; i++) {
+        layer_state_set(rng());
+        EXPECT_EQ(layer_switch_get_layer(key), walk_layers(key)) << "layers " << std::hex << layer_state;
+        EXPECT_EQ(layer_switch_get_layer(key), walk_layers(key)) << "layers " << std::hex << layer_state;
+    }
+    layer_clear();
+}
+
+TEST_F(LayerLookupCacheStrict, ReleaseUsesTheCurrentLayer) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  layer_key = KeymapKey{0, 0, 0, MO(1)};
+    KeymapKey  key_a     = KeymapKey{0, 1, 0, KC_A};
+    KeymapKey  key_b     = KeymapKey{1, 1, 0, KC_B};
+
+    set_keymap({layer_key, key_a, key_b, KeymapKey{1, 0, 0, KC_TRANSPARENT}});
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Leaving the layer releases every key, their release then resolves on the layer below
+    EXPECT_EMPTY_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,123 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+namespace {
+
+constexpr uint8_t lookup_keys = 8;
+
+} // namespace
+
+class LayerLookupCache : public TestFixture {
+   public:
+    /* The layer walk layer_switch_get_layer() does without the cache. */
+    uint8_t walk_layers(keypos_t key) {
+        layer_state_t layers = layer_state | default_layer_state;
+        for (int8_t layer = MAX_LAYER - 1; layer >= 0; layer--) {
+            if ((layers & ((layer_state_t)1 << layer)) && action_for_key(layer, key).code != ACTION_TRANSPARENT) {
+                return layer;
+            }
+        }
+        return 0;
+    }
+
+    /* Every layer holds a key, or is transparent, at the first few positions of the top row. */
+    void set_random_keymap(std::mt19937 &rng) {
+        set_keymap({});
+        for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+            for (uint8_t col = 0; col < lookup_keys; col++) {
+                add_key(KeymapKey{layer, col, 0, (rng() % 3) ? (uint16_t)KC_TRANSPARENT : (uint16_t)(KC_A + layer % 26)});
+            }
+        }
+    }
+
+    void expect_walk_results(const char *when) {
+        for (uint8_t col = 0; col < lookup_keys; col++) {
+            keypos_t key = {.col = col, .row = 0};
+            EXPECT_EQ(layer_switch_get_layer(key), walk_layers(key)) << when << ", layers " << std::hex << (layer_state | default_layer_state) << ", column " << +col;
+        }
+    }
+};
+
+TEST_F(LayerLookupCache, MatchesLayerWalkForRandomLayerStates) {
+    std::mt19937 rng(7);
+    set_random_keymap(rng);
+
+    for (int i = 0; i < 500; i++) {
+        layer_state_set(rng());
+        default_layer_set((layer_state_t)1 << (rng() % 4));
+        expect_walk_results("first lookup");
+        // Now served from the cache
+        expect_walk_results("cached lookup");
+    }
+    layer_clear();
+    default_layer_set(1);
+}
+
+TEST_F(LayerLookupCache, LayerStateAssignedDirectly) {
+    std::mt19937 rng(11);
+    set_random_keymap(rng);
+    expect_walk_results("layer 0");
+
+    // Split keyboard slaves and user code may assign the state without layer_state_set()
+    for (int i = 0; i < 100; i++) {
+        layer_state = rng();
+        expect_walk_results("assigned");
+    }
+    layer_state = 0;
+}
+
+TEST_F(LayerLookupCache, KeymapChangeIsPickedUp) {
+    std::mt19937 rng(3);
+    set_random_keymap(rng);
+    layer_state_set(((layer_state_t)1 << MAX_LAYER) - 1);
+    expect_walk_results("before");
+
+    // Replacing the keymap clears the cache, as dynamic keymap writes do
+    set_random_keymap(rng);
+    expect_walk_results("after");
+    layer_clear();
+}
+
+TEST_F(LayerLookupCache, MomentaryLayerKeyRelease) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  layer_key = KeymapKey{0, 0, 0, MO(1)};
+    KeymapKey  key_a     = KeymapKey{0, 1, 0, KC_A};
+    KeymapKey  key_b     = KeymapKey{1, 1, 0, KC_B};
+
+    set_keymap({layer_key, key_a, key_b, KeymapKey{1, 0, 0, KC_TRANSPARENT}});
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The key stays on the layer it was pressed on
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,5 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+OUTPUT_QUEUE_ENABLE = yes
+EXTRAKEY_ENABLE = yes
@@ -0,0 +1,195 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+namespace {
+
+std::function<void(void)> on_macro_press;
+int                       regular_presses;
+
+} // namespace
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == QK_USER_0) {
+        if (record->event.pressed && on_macro_press) {
+            on_macro_press();
+        }
+        return false;
+    }
+    if (keycode == KC_B && record->event.pressed) {
+        regular_presses++;
+    }
+    return true;
+}
+
+class OutputQueue : public TestFixture {
+   public:
+    void SetUp() override {
+        on_macro_press  = nullptr;
+        regular_presses = 0;
+    }
+};
+
+TEST_F(OutputQueue, TapCodeDelayDoesNotBlock) {
+    TestDriver driver;
+    InSequence s;
+    auto       macro_key   = KeymapKey(0, 0, 0, QK_USER_0);
+    auto       regular_key = KeymapKey(0, 1, 0, KC_B);
+    set_keymap({macro_key, regular_key});
+    on_macro_press = []() { tap_code_delay(KC_A, 300); };
+
+    /* The press is sent straight away, and the release is held back */
+    EXPECT_REPORT(driver, (KC_A));
+    macro_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    macro_key.release();
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Keys are still processed, but what they send waits its turn */
+    EXPECT_NO_REPORT(driver);
+    regular_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(regular_presses, 1);
+    idle_for(150);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(OutputQueue, ModTapReleaseDoesNotBlock) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_B);
+    set_keymap({mod_tap_key, regular_key});
+
+    /* Tapping sends the tap on release, then releases it TAP_CODE_DELAY later */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    regular_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(regular_presses, 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    idle_for(TAP_CODE_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(OutputQueue, ExtraReportsKeepTheirPlace) {
+    TestDriver driver;
+    InSequence s;
+    auto       macro_key = KeymapKey(0, 0, 0, QK_USER_0);
+    set_keymap({macro_key});
+    on_macro_press = []() {
+        tap_code_delay(KC_A, 50);
+        tap_code_delay(KC_AUDIO_MUTE, 0);
+    };
+
+    EXPECT_REPORT(driver, (KC_A));
+    macro_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(0);
+    macro_key.release();
+    idle_for(40);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(2);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(OutputQueue, MouseReportsKeepTheirPlace) {
+    TestDriver driver;
+    InSequence s;
+    auto       macro_key = KeymapKey(0, 0, 0, QK_USER_0);
+    set_keymap({macro_key});
+    on_macro_press = []() {
+        tap_code_delay(KC_A, 50);
+        report_mouse_t report = {};
+        report.buttons        = MOUSE_BTN_MASK(0);
+        host_mouse_send(&report);
+    };
+
+    /* The click mustn't overtake the release of the tap before it */
+    EXPECT_REPORT(driver, (KC_A));
+    macro_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    macro_key.release();
+    idle_for(40);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_mouse_mock(_));
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(OutputQueue, FullQueueFallsBackToWaiting) {
+    TestDriver driver;
+    InSequence s;
+    auto       macro_key = KeymapKey(0, 0, 0, QK_USER_0);
+    set_keymap({macro_key});
+    on_macro_press = []() {
+        for (uint8_t keycode = KC_A; keycode <= KC_E; keycode++) {
+            tap_code_delay(keycode, 20);
+        }
+    };
+
+    /* Five taps don't fit in the queue, so it's emptied by waiting whenever it fills, and only the last release is left */
+    for (uint8_t keycode = KC_A; keycode <= KC_D; keycode++) {
+        EXPECT_REPORT(driver, (keycode));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    EXPECT_REPORT(driver, (KC_E));
+    macro_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    macro_key.release();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
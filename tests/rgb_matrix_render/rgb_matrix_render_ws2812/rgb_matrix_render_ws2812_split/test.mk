@@ -0,0 +1,10 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = WS2812
+WS2812_DRIVER = custom
+
+# Shares the test and its ws2812_custom.c with the parent folder
+VPATH += $(TEST_PATH)/..
+SRC += ../test_rgb_matrix_ws2812.cpp
@@ -0,0 +1,49 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+extern LED_TYPE rgb_matrix_ws2812_array[RGB_MATRIX_LED_COUNT];
+extern bool     test_keyboard_left;
+}
+
+class RgbMatrixWs2812 : public TestFixture {
+   public:
+    RGB colors[RGB_MATRIX_LED_COUNT];
+
+    void SetUp() override {
+        test_keyboard_left = true;
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            colors[i] = {(uint8_t)(i * 11), (uint8_t)(255 - i * 7), (uint8_t)(i * 3 + 100)};
+        }
+    }
+
+    /* Checks a batched run leaves the buffer exactly as setting each led of the run in turn does. */
+    void check_run(int index, uint8_t count) {
+        LED_TYPE expected[RGB_MATRIX_LED_COUNT];
+        memset(rgb_matrix_ws2812_array, 0x55, sizeof(rgb_matrix_ws2812_array));
+        for (uint8_t i = 0; i < count; i++) {
+            rgb_matrix_driver.set_color(index + i, colors[index + i].r, colors[index + i].g, colors[index + i].b);
+        }
+        memcpy(expected, rgb_matrix_ws2812_array, sizeof(expected));
+
+        memset(rgb_matrix_ws2812_array, 0x55, sizeof(rgb_matrix_ws2812_array));
+        rgb_matrix_driver.set_color_batch(index, &colors[index], count);
+        EXPECT_EQ(memcmp(rgb_matrix_ws2812_array, expected, sizeof(expected)), 0) << (test_keyboard_left ? "left" : "right") << " half, run of " << +count << " from " << index;
+    }
+};
+
+TEST_F(RgbMatrixWs2812, BatchMatchesSingle) {
+    for (bool left : {true, false}) {
+        test_keyboard_left = left;
+        for (int index = 0; index < RGB_MATRIX_LED_COUNT; index++) {
+            for (int count = 1; index + count <= RGB_MATRIX_LED_COUNT; count++) {
+                check_run(index, count);
+            }
+        }
+    }
+}
@@ -0,0 +1,14 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+#include "ws2812.h"
+
+led_config_t g_led_config;
+bool         test_keyboard_left = true;
+
+bool is_keyboard_left(void) {
+    return test_keyboard_left;
+}
+
+void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds) {}
@@ -0,0 +1,55 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "rgb_matrix.h"
+
+#define GRID_COLUMNS 12
+#define GRID_ROWS (RGB_MATRIX_LED_COUNT / GRID_COLUMNS)
+
+RGB      test_rgb_matrix_frame[RGB_MATRIX_LED_COUNT];
+uint32_t test_rgb_matrix_flushes;
+
+led_config_t g_led_config;
+
+static void init(void) {
+    // Keys first, then the rest of a 12 x 10 grid as underglow
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            g_led_config.matrix_co[row][col] = row * MATRIX_COLS + col;
+        }
+    }
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        g_led_config.point[i].x = (i % GRID_COLUMNS) * 224 / (GRID_COLUMNS - 1);
+        g_led_config.point[i].y = (i / GRID_COLUMNS) * 64 / (GRID_ROWS - 1);
+        g_led_config.flags[i]   = i < MATRIX_ROWS * MATRIX_COLS ? LED_FLAG_KEYLIGHT : LED_FLAG_UNDERGLOW;
+    }
+}
+
+static void flush(void) {
+    test_rgb_matrix_flushes++;
+}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    test_rgb_matrix_frame[index].r = r;
+    test_rgb_matrix_frame[index].g = g;
+    test_rgb_matrix_frame[index].b = b;
+}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        set_color(i, r, g, b);
+    }
+}
+
+static void set_color_batch(int index, const RGB *colors, uint8_t count) {
+    memcpy(&test_rgb_matrix_frame[index], colors, count * sizeof(RGB));
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init            = init,
+    .flush           = flush,
+    .set_color       = set_color,
+    .set_color_all   = set_color_all,
+    .set_color_batch = set_color_batch,
+};
@@ -0,0 +1,160 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <string>
+#include "test_common.hpp"
+#include "test_benchmark.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+extern RGB      test_rgb_matrix_frame[RGB_MATRIX_LED_COUNT];
+extern uint32_t test_rgb_matrix_flushes;
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+struct Effect {
+    uint8_t     mode;
+    const char *name;
+    uint32_t    checksum; // of the first 8 frames, identical with and without RGB_MATRIX_BATCH_RENDER
+};
+
+// clang-format off
+const Effect effects[] = {
+    {RGB_MATRIX_SOLID_COLOR,            "solid_color",            4041643717u},
+    {RGB_MATRIX_BREATHING,              "breathing",              2060360357u},
+    {RGB_MATRIX_GRADIENT_UP_DOWN,       "gradient_up_down",       722957349u},
+    {RGB_MATRIX_GRADIENT_LEFT_RIGHT,    "gradient_left_right",    2017098885u},
+    {RGB_MATRIX_BAND_VAL,               "band_val",               121668573u},
+    {RGB_MATRIX_BAND_SPIRAL_VAL,        "band_spiral_val",        1947641612u},
+    {RGB_MATRIX_CYCLE_ALL,              "cycle_all",              2225467917u},
+    {RGB_MATRIX_CYCLE_LEFT_RIGHT,       "cycle_left_right",       570889889u},
+    {RGB_MATRIX_CYCLE_PINWHEEL,         "cycle_pinwheel",         2349186628u},
+    {RGB_MATRIX_CYCLE_SPIRAL,           "cycle_spiral",           2991685774u},
+    {RGB_MATRIX_DUAL_BEACON,            "dual_beacon",            512813668u},
+    {RGB_MATRIX_RAINBOW_MOVING_CHEVRON, "rainbow_moving_chevron", 2059824143u},
+    {RGB_MATRIX_SOLID_REACTIVE_SIMPLE,  "solid_reactive_simple",  1637325393u},
+    {RGB_MATRIX_SOLID_MULTISPLASH,      "solid_multisplash",      1118309945u},
+};
+// clang-format on
+
+constexpr uint32_t default_frames = 2000;
+
+#ifdef RGB_MATRIX_BATCH_RENDER
+constexpr const char *render_path = "batch";
+#else
+constexpr const char *render_path = "per_led";
+#endif
+
+} // namespace
+
+class RgbMatrixRender : public TestFixture {
+   public:
+    void SetUp() override {
+        BenchmarkRecorder::instance().reset();
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(32, 200, 255);
+        rgb_matrix_set_speed_noeeprom(128);
+        rgb_matrix_set_flags_noeeprom(LED_FLAG_ALL);
+    }
+
+    /* Runs rgb_matrix_task() until a whole frame has been flushed, and lets the next one start straight away. */
+    void render_frame() {
+        uint32_t flushes = test_rgb_matrix_flushes;
+        for (int i = 0; i < 100 && test_rgb_matrix_flushes == flushes; i++) {
+            rgb_matrix_task();
+        }
+        ASSERT_NE(test_rgb_matrix_flushes, flushes);
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+    }
+
+    void start(const Effect &effect) {
+        rgb_matrix_mode_noeeprom(effect.mode);
+        render_frame();
+        // Reactive effects need something to react to
+        process_rgb_matrix(1, 2, true);
+        process_rgb_matrix(3, 7, true);
+    }
+};
+
+TEST_F(RgbMatrixRender, BatchConversionMatchesSingle) {
+    HSV hsv[256];
+    RGB rgb[256];
+    RGB rgb_nocie[256];
+    for (uint16_t h = 0; h < 256; h++) {
+        for (uint16_t s = 0; s < 256; s++) {
+            for (uint16_t v = 0; v < 256; v++) {
+                hsv[v] = {(uint8_t)h, (uint8_t)s, (uint8_t)v};
+            }
+            hsv_to_rgb_batch(hsv, rgb, 255);
+            hsv_to_rgb_batch(&hsv[255], &rgb[255], 1);
+            hsv_to_rgb_batch_nocie(hsv, rgb_nocie, 255);
+            hsv_to_rgb_batch_nocie(&hsv[255], &rgb_nocie[255], 1);
+            for (uint16_t v = 0; v < 256; v++) {
+                RGB expected = hsv_to_rgb(hsv[v]);
+                ASSERT_TRUE(rgb[v].r == expected.r && rgb[v].g == expected.g && rgb[v].b == expected.b) << "hsv " << h << " " << s << " " << v;
+                expected = hsv_to_rgb_nocie(hsv[v]);
+                ASSERT_TRUE(rgb_nocie[v].r == expected.r && rgb_nocie[v].g == expected.g && rgb_nocie[v].b == expected.b) << "hsv " << h << " " << s << " " << v;
+            }
+        }
+    }
+}
+
+TEST_F(RgbMatrixRender, EffectsRenderExpectedFrames) {
+    for (auto &effect : effects) {
+        start(effect);
+        // FNV-1a over every frame
+        uint32_t checksum = 2166136261u;
+        for (int frame = 0; frame < 8; frame++) {
+            render_frame();
+            auto bytes = (const uint8_t *)test_rgb_matrix_frame;
+            for (size_t i = 0; i < sizeof(test_rgb_matrix_frame); i++) {
+                checksum = (checksum ^ bytes[i]) * 16777619u;
+            }
+        }
+        EXPECT_EQ(checksum, effect.checksum) << effect.name;
+    }
+}
+
+TEST_F(RgbMatrixRender, LedsWithoutFlagsAreLeftAlone) {
+    rgb_matrix_set_flags_noeeprom(LED_FLAG_KEYLIGHT);
+    for (auto &effect : effects) {
+        start(effect);
+        for (uint8_t i = MATRIX_ROWS * MATRIX_COLS; i < RGB_MATRIX_LED_COUNT; i++) {
+            test_rgb_matrix_frame[i].r = 1;
+            test_rgb_matrix_frame[i].g = 2;
+            test_rgb_matrix_frame[i].b = 3;
+        }
+        render_frame();
+        for (uint8_t i = MATRIX_ROWS * MATRIX_COLS; i < RGB_MATRIX_LED_COUNT; i++) {
+            ASSERT_TRUE(test_rgb_matrix_frame[i].r == 1 && test_rgb_matrix_frame[i].g == 2 && test_rgb_matrix_frame[i].b == 3) << effect.name << " led " << +i;
+        }
+    }
+}
+
+TEST_F(RgbMatrixRender, FramesPerSecond) {
+    const uint32_t frames   = BenchmarkRecorder::loops(default_frames);
+    auto          &recorder = BenchmarkRecorder::instance();
+
+    for (auto &effect : effects) {
+        start(effect);
+        for (uint32_t frame = 0; frame < frames; frame++) {
+            auto start = std::chrono::steady_clock::now();
+            render_frame();
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            recorder.record(effect.name, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }
+
+    auto summaries = recorder.summarize();
+    for (auto &effect : effects) {
+        EXPECT_EQ(summaries[effect.name].count, frames) << effect.name;
+    }
+
+    std::string path = BenchmarkRecorder::output_path(std::string("rgb_matrix_render_") + render_path);
+    EXPECT_TRUE(recorder.write_json(path, {{"benchmark", "rgb_matrix_render"}, {"render_path", render_path}, {"frames", std::to_string(frames)}, {"led_count", std::to_string(RGB_MATRIX_LED_COUNT)}}));
+}
@@ -0,0 +1,5 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+NKRO_ENABLE = yes
+SEND_STRING_ASYNC_ENABLE = yes
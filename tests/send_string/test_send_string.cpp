@@ -0,0 +1,326 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+using testing::Invoke;
+
+#ifndef SEND_STRING_ASYNC_MAX_KEYS
+#    define SEND_STRING_ASYNC_MAX_KEYS 1 // As send_string.c
+#endif
+
+namespace {
+
+int regular_presses;
+
+bool lut_bit(const uint8_t lut[16], uint8_t ascii_code) {
+    return (pgm_read_byte(&lut[ascii_code / 8]) >> (ascii_code % 8)) & 0x01;
+}
+
+const char *text = "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs!\n"
+                   "SPHINX OF BLACK QUARTZ, JUDGE MY VOW: \"42\" <tags> & {braces} [1, 2, 3] (a|b) ~/path_to-file.txt\n"
+                   "How vexingly quick daft zebras jump; 100% of 7 * 6 = 42, isn't it? #hashtag @user $5 ^caret `code`\n";
+
+/* Types what the host would make of a stream of keyboard reports, using the send_string look-up tables in reverse. */
+class HostDecoder {
+   public:
+    HostDecoder() {
+        for (int ascii_code = 1; ascii_code < 128; ascii_code++) {
+            uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[ascii_code]);
+            uint8_t mods    = (lut_bit(ascii_to_shift_lut, ascii_code) ? MOD_BIT(KC_LEFT_SHIFT) : 0) | (lut_bit(ascii_to_altgr_lut, ascii_code) ? MOD_BIT(KC_RIGHT_ALT) : 0);
+            if (keycode != KC_NO) {
+                chars_.emplace(std::make_pair(keycode, mods), ascii_code);
+            }
+        }
+    }
+
+    void report(const report_keyboard_t &report) {
+        std::vector<uint8_t> keys;
+        uint8_t              mods = report.mods;
+        if (keymap_config.nkro) {
+            // Hosts act on the keys of an NKRO report in keycode order
+            mods = report.nkro.mods;
+            for (int i = 0; i < KEYBOARD_REPORT_BITS * 8; i++) {
+                if (report.nkro.bits[i / 8] & (1 << (i % 8))) {
+                    keys.push_back(i);
+                }
+            }
+        } else {
+            for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                if (report.keys[i]) {
+                    keys.push_back(report.keys[i]);
+                }
+            }
+        }
+        for (auto key : keys) {
+            if (std::find(held_.begin(), held_.end(), key) == held_.end()) {
+                auto c = chars_.find(std::make_pair(key, mods & (MOD_BIT(KC_LEFT_SHIFT) | MOD_BIT(KC_RIGHT_ALT))));
+                typed += c != chars_.end() ? c->second : '?';
+            }
+        }
+        held_ = keys;
+        reports++;
+    }
+
+    std::string typed;
+    int         reports = 0;
+
+   private:
+    std::map<std::pair<uint8_t, uint8_t>, char> chars_;
+    std::vector<uint8_t>                        held_;
+};
+
+} // namespace
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == KC_B && record->event.pressed) {
+        regular_presses++;
+    }
+    return true;
+}
+
+class SendString : public TestFixture {
+   public:
+    void SetUp() override {
+        regular_presses    = 0;
+        keymap_config.nkro = false;
+    }
+
+    void TearDown() override {
+        keymap_config.nkro = false;
+    }
+
+    /* Runs the main loop until the string being typed in the background is done, returning how long that took. */
+    uint32_t idle_until_typed() {
+        uint32_t start = timer_read32();
+        while (send_string_async_active() && timer_elapsed32(start) < 100000) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(send_string_async_active()) << "String was never finished";
+        return timer_elapsed32(start);
+    }
+};
+
+TEST_F(SendString, AsyncTypesTheSameText) {
+    TestDriver  driver;
+    HostDecoder host;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) { host.report(report); }));
+
+    send_string_async(text);
+    idle_until_typed();
+    EXPECT_EQ(host.typed, text);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, AsyncHoldsModifiersAcrossCharacters) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_H));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_I));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("HIa");
+    idle_until_typed();
+    VERIFY_AND_CLEAR(driver);
+}
+
+#if SEND_STRING_ASYNC_MAX_KEYS > 1
+TEST_F(SendString, AsyncPacksAscendingKeysWithNkro) {
+    TestDriver driver;
+    InSequence s;
+    keymap_config.nkro = true;
+
+    /* "el" ascend, the second "l" can't be pressed while the first is, and "lo" ascend again */
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_H));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_E, KC_L));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_L, KC_O));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("Hello");
+    idle_until_typed();
+    VERIFY_AND_CLEAR(driver);
+
+    HostDecoder host;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) { host.report(report); }));
+    send_string_async(text);
+    idle_until_typed();
+    EXPECT_EQ(host.typed, text);
+    VERIFY_AND_CLEAR(driver);
+}
+#else
+TEST_F(SendString, AsyncDoesNotPackByDefault) {
+    TestDriver driver;
+    InSequence s;
+    keymap_config.nkro = true;
+
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_L));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_O));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("elo");
+    idle_until_typed();
+    VERIFY_AND_CLEAR(driver);
+}
+#endif
+
+TEST_F(SendString, AsyncKeepsScanning) {
+    TestDriver driver;
+    auto       regular_key = KeymapKey(0, 0, 0, KC_B);
+    set_keymap({regular_key});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    send_string_async("abcdefghijklmnopqrstuvwxyz" SS_DELAY(500) "abcdefghijklmnopqrstuvwxyz");
+    idle_for(20);
+    EXPECT_TRUE(send_string_async_active());
+
+    regular_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(regular_presses, 1) << "Key press wasn't processed during playback";
+    regular_key.release();
+    run_one_scan_loop();
+
+    EXPECT_GE(idle_until_typed(), 500) << "Delay should have been waited out";
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, AsyncTapCodes) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async(SS_LCTL("c") SS_DELAY(50) SS_TAP(X_F1));
+    idle_for(40);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Nothing more happens until the delay has passed */
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_F1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_until_typed();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, AsyncStopReleasesEverything) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("AAAA");
+    idle_for(2);
+    send_string_async_stop();
+    EXPECT_FALSE(send_string_async_active());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, AsyncLeavesHeldKeysDown) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 0, 0, KC_B);
+    set_keymap({regular_key});
+
+    EXPECT_REPORT(driver, (KC_B));
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The held "b" is neither typed nor released */
+    EXPECT_REPORT(driver, (KC_B, KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B))).Times(AnyNumber());
+    send_string_async("abc");
+    idle_until_typed();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B))).Times(AnyNumber());
+    send_string_async("bbbb");
+    idle_for(2);
+    send_string_async_stop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, CharactersPerSecond) {
+    TestDriver driver;
+    struct {
+        std::string typed;
+        uint32_t    ms;
+    } blocking, async, nkro;
+
+    /* send_string() waits for nothing here, but each report takes a USB frame to reach the host */
+    {
+        HostDecoder host;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) { host.report(report); }));
+        send_string(text);
+        blocking = {host.typed, (uint32_t)host.reports};
+        VERIFY_AND_CLEAR(driver);
+    }
+    {
+        HostDecoder host;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) { host.report(report); }));
+        send_string_async(text);
+        async = {"", idle_until_typed()};
+        async.typed = host.typed;
+        VERIFY_AND_CLEAR(driver);
+    }
+    keymap_config.nkro = true;
+    {
+        HostDecoder host;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) { host.report(report); }));
+        send_string_async(text);
+        nkro = {"", idle_until_typed()};
+        nkro.typed = host.typed;
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    EXPECT_EQ(blocking.typed, text);
+    EXPECT_EQ(async.typed, text);
+    EXPECT_EQ(nkro.typed, text);
+
+    EXPECT_LE(async.ms, blocking.ms) << "Holding modifiers shouldn't cost reports";
+#if SEND_STRING_ASYNC_MAX_KEYS > 1
+    EXPECT_LT(nkro.ms * 4, blocking.ms * 3) << "Expected packing to save at least a quarter of the reports";
+#else
+    EXPECT_EQ(nkro.ms, async.ms) << "Keys shouldn't be packed unless asked for";
+#endif
+}
@@ -0,0 +1,22 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define PERMISSIVE_HOLD_PER_KEY
+#define HOLD_ON_OTHER_KEY_PRESS_PER_KEY
+#define QUICK_TAP_TERM_PER_KEY
+
+#include <stdbool.h>
+
+// Switched by the test, so each roll is played with and without the waiting buffer shortcut
+#ifdef __cplusplus
+extern "C" {
+#endif
+extern bool roll_stress_settle;
+#ifdef __cplusplus
+}
+#endif
+#define WAITING_BUFFER_SETTLE roll_stress_settle
@@ -0,0 +1,176 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+extern "C" {
+bool roll_stress_settle = true;
+
+bool get_permissive_hold(uint16_t keycode, keyrecord_t *record) {
+    return keycode == LSFT_T(KC_F) || keycode == RSFT_T(KC_J);
+}
+
+bool get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record) {
+    return IS_QK_LAYER_TAP(keycode);
+}
+
+uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record) {
+    return IS_QK_LAYER_TAP(keycode) ? 0 : 120;
+}
+}
+
+namespace {
+
+constexpr uint32_t roll_count = 10000;
+
+/* One key of a roll: pressed at `at` ms into the roll, released `hold` ms later. */
+struct RollPress {
+    uint32_t at;
+    uint32_t hold;
+    size_t   key;
+};
+
+/* A burst of 2 to 6 overlapping presses of different keys, as when typing quickly over home row mods. */
+std::vector<RollPress> random_roll(std::mt19937 &rng, size_t key_count) {
+    // Fisher-Yates over rng() directly, as std::shuffle's use of the generator is up to the standard library
+    std::vector<size_t> keys(key_count);
+    for (size_t i = 0; i < key_count; i++) {
+        keys[i] = i;
+    }
+    for (size_t i = key_count - 1; i > 0; i--) {
+        std::swap(keys[i], keys[rng() % (i + 1)]);
+    }
+
+    std::vector<RollPress> roll(2 + rng() % 5);
+    uint32_t               at = 0;
+    for (size_t i = 0; i < roll.size(); i++) {
+        roll[i] = {at, 5 + rng() % 250, keys[i]};
+        at += rng() % 80;
+    }
+    return roll;
+}
+
+/* A report, and when it was sent relative to the start of the roll. */
+struct SentReport {
+    uint32_t          at;
+    report_keyboard_t report;
+
+    bool operator==(const SentReport &other) const {
+        return at == other.at && report.mods == other.report.mods && memcmp(report.keys, other.report.keys, sizeof(report.keys)) == 0;
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const SentReport &sent) {
+    return os << sent.at << "ms: " << sent.report;
+}
+
+/* FNV-1a over the time, modifiers and keys of each report. */
+uint64_t hash_reports(uint64_t hash, const std::vector<SentReport> &reports) {
+    for (auto &sent : reports) {
+        std::vector<uint8_t> bytes = {(uint8_t)sent.at, (uint8_t)(sent.at >> 8), (uint8_t)(sent.at >> 16), (uint8_t)(sent.at >> 24), sent.report.mods};
+        bytes.insert(bytes.end(), sent.report.keys, sent.report.keys + sizeof(sent.report.keys));
+        for (auto byte : bytes) {
+            hash = (hash ^ byte) * 0x100000001b3;
+        }
+    }
+    return hash;
+}
+
+} // namespace
+
+class RollStress : public TestFixture {
+   public:
+    TestDriver              driver;
+    std::vector<SentReport> reports;
+    uint32_t                roll_start = 0;
+
+    void SetUp() override {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) { reports.push_back({timer_elapsed32(roll_start), report}); }));
+    }
+
+    /* Plays a roll from a standing start, and returns every report sent until the tapping state has timed out. */
+    std::vector<SentReport> play(std::vector<KeymapKey> &keys, const std::vector<RollPress> &roll) {
+        uint32_t end = 0;
+        for (auto &press : roll) {
+            end = std::max(end, press.at + press.hold);
+        }
+
+        // Some rolls leave a key stuck down, whichever way the buffer is processed, so don't let it leak into the next
+        clear_keyboard();
+        layer_clear();
+
+        reports.clear();
+        roll_start = timer_read32();
+        for (uint32_t t = 0; t <= end; t++) {
+            for (auto &press : roll) {
+                if (press.at == t) {
+                    keys[press.key].press();
+                }
+                if (press.at + press.hold == t) {
+                    keys[press.key].release();
+                }
+            }
+            run_one_scan_loop();
+        }
+        idle_for(TAPPING_TERM + 50);
+        return reports;
+    }
+};
+
+/* Replays randomized rolls over home row mods, layer taps and regular keys, and checks that they send exactly the same
+ * reports, at the same times, as they did before the waiting buffer kept track of its keys. Each roll is also played
+ * examining held back records every tick, which must match leaving them alone until something changes. */
+TEST_F(RollStress, SettledWaitingBufferMatchesReference) {
+    // clang-format off
+    std::vector<KeymapKey> keys = {
+        KeymapKey(0, 0, 0, LGUI_T(KC_A)), KeymapKey(0, 1, 0, LALT_T(KC_S)), KeymapKey(0, 2, 0, LCTL_T(KC_D)), KeymapKey(0, 3, 0, LSFT_T(KC_F)),
+        KeymapKey(0, 4, 0, KC_G),         KeymapKey(0, 5, 0, KC_H),         KeymapKey(0, 6, 0, RSFT_T(KC_J)), KeymapKey(0, 7, 0, RCTL_T(KC_K)),
+        KeymapKey(0, 8, 0, RALT_T(KC_L)), KeymapKey(0, 9, 0, RGUI_T(KC_SCLN)),
+        KeymapKey(0, 0, 1, KC_Q),         KeymapKey(0, 1, 1, KC_W),         KeymapKey(0, 2, 1, KC_E),         KeymapKey(0, 3, 1, KC_R),
+        KeymapKey(0, 0, 2, LT(1, KC_SPC)),  KeymapKey(0, 1, 2, LT(1, KC_ENT)),
+    };
+    // clang-format on
+    const size_t roll_keys = keys.size();
+    for (auto &key : keys) {
+        add_key(key);
+        if (key.position.row < 2) {
+            // Digits under the home row, everything else falls through
+            add_key(KeymapKey(1, key.position.col, key.position.row, key.position.row == 0 ? KC_1 + key.position.col : KC_TRNS));
+        } else {
+            add_key(KeymapKey(1, key.position.col, key.position.row, KC_TRNS));
+        }
+    }
+
+    std::mt19937 rng(20);
+    size_t       report_count = 0;
+    uint64_t     report_hash  = 0xcbf29ce484222325;
+    for (uint32_t n = 0; n < roll_count; n++) {
+        auto roll = random_roll(rng, roll_keys);
+
+        roll_stress_settle = true;
+        auto settled       = play(keys, roll);
+        roll_stress_settle = false;
+        auto reference     = play(keys, roll);
+
+        ASSERT_EQ(settled, reference) << "Roll " << n;
+        report_count += settled.size();
+        report_hash = hash_reports(report_hash, settled);
+    }
+
+    // Recorded with the linear scans of the waiting buffer that came before
+    EXPECT_EQ(report_count, 72382);
+    EXPECT_EQ(report_hash, 0x18d50108dfb6a375ULL);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,140 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_benchmark.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+extern "C" {
+/* Sink for PROFILE_TASK()/PROFILE_TASK_NAMED() from quantum/basic_profiling.h */
+void profile_task_record(const char* name, uint32_t elapsed) {
+    BenchmarkRecorder::instance().record(name, elapsed);
+}
+}
+
+namespace {
+constexpr uint32_t sub_bucket_bits  = 5;
+constexpr uint32_t sub_bucket_count = 1 << sub_bucket_bits;
+constexpr size_t   bucket_count     = (32 - sub_bucket_bits + 1) * sub_bucket_count;
+} // namespace
+
+BenchmarkRecorder& BenchmarkRecorder::instance() {
+    static BenchmarkRecorder recorder;
+    return recorder;
+}
+
+size_t BenchmarkRecorder::bucket_of(uint32_t value) {
+    if (value < sub_bucket_count) {
+        return value;
+    }
+    // keep the top sub_bucket_bits + 1 bits of the value
+    uint32_t shift = (31 - __builtin_clz(value)) - sub_bucket_bits;
+    return ((shift + 1) * sub_bucket_count) + ((value >> shift) - sub_bucket_count);
+}
+
+uint32_t BenchmarkRecorder::bucket_value(size_t bucket) {
+    if (bucket < sub_bucket_count) {
+        return bucket;
+    }
+    uint32_t shift = (bucket / sub_bucket_count) - 1;
+    uint32_t base  = (bucket % sub_bucket_count) + sub_bucket_count;
+    // middle of the bucket
+    return (base << shift) + ((1u << shift) >> 1);
+}
+
+void BenchmarkRecorder::record(const char* name, uint32_t elapsed) {
+    auto known = m_names.find(name);
+    if (known == m_names.end()) {
+        known = m_names.emplace(name, name).first;
+    }
+
+    Histogram& histogram = m_histograms[known->second];
+    if (histogram.buckets.empty()) {
+        histogram.buckets.resize(bucket_count);
+    }
+    histogram.count++;
+    histogram.sum += elapsed;
+    histogram.min = std::min(histogram.min, elapsed);
+    histogram.max = std::max(histogram.max, elapsed);
+    histogram.buckets[bucket_of(elapsed)]++;
+}
+
+void BenchmarkRecorder::reset() {
+    m_histograms.clear();
+}
+
+bool BenchmarkRecorder::has(const std::string& name) const {
+    return m_histograms.count(name) > 0;
+}
+
+uint32_t BenchmarkRecorder::percentile(const Histogram& histogram, double fraction) {
+    uint64_t target = (uint64_t)(fraction * histogram.count);
+    uint64_t seen   = 0;
+    for (size_t bucket = 0; bucket < histogram.buckets.size(); bucket++) {
+        seen += histogram.buckets[bucket];
+        if (seen > target) {
+            return std::min(std::max(bucket_value(bucket), histogram.min), histogram.max);
+        }
+    }
+    return histogram.max;
+}
+
+std::map<std::string, BenchmarkRecorder::Summary> BenchmarkRecorder::summarize() const {
+    std::map<std::string, Summary> summaries;
+    for (auto& entry : m_histograms) {
+        const Histogram& histogram = entry.second;
+        summaries[entry.first]     = Summary{
+            histogram.count, histogram.min, histogram.max, (double)histogram.sum / histogram.count, percentile(histogram, 0.50), percentile(histogram, 0.90), percentile(histogram, 0.99), percentile(histogram, 0.999),
+        };
+    }
+    return summaries;
+}
+
+bool BenchmarkRecorder::write_json(const std::string& path, const std::map<std::string, std::string>& metadata) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << "{\n";
+    for (auto& entry : metadata) {
+        out << "  \"" << entry.first << "\": \"" << entry.second << "\",\n";
+    }
+    out << "  \"unit\": \"ns\",\n";
+    out << "  \"tasks\": {";
+    bool first = true;
+    for (auto& entry : summarize()) {
+        const Summary& summary = entry.second;
+        out << (first ? "\n" : ",\n");
+        out << "    \"" << entry.first << "\": {";
+        out << "\"count\": " << summary.count << ", ";
+        out << "\"mean\": " << std::fixed << std::setprecision(1) << summary.mean << ", ";
+        out << "\"min\": " << summary.min << ", ";
+        out << "\"p50\": " << summary.p50 << ", ";
+        out << "\"p90\": " << summary.p90 << ", ";
+        out << "\"p99\": " << summary.p99 << ", ";
+        out << "\"p999\": " << summary.p999 << ", ";
+        out << "\"max\": " << summary.max << "}";
+        first = false;
+    }
+    out << "\n  }\n}\n";
+    return out.good();
+}
+
+std::string BenchmarkRecorder::output_path(const std::string& name) {
+    const char* path = std::getenv("QMK_BENCHMARK_OUTPUT");
+    if (path && *path) {
+        return path;
+    }
+    return ".build/test/" + name + ".benchmark.json";
+}
+
+uint32_t BenchmarkRecorder::loops(uint32_t default_loops) {
+    const char* loops = std::getenv("QMK_BENCHMARK_LOOPS");
+    if (loops && *loops) {
+        return std::strtoul(loops, nullptr, 10);
+    }
+    return default_loops;
+}
@@ -0,0 +1,74 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Collects timing samples handed over by profile_task_record() (see
+ * quantum/basic_profiling.h) or recorded directly, and summarises them as
+ * percentiles.
+ *
+ * Samples are kept in a log-linear histogram with 32 sub-buckets per power of
+ * two, so memory stays constant no matter how many loops are run and the
+ * reported percentiles are accurate to about 3%.
+ */
+class BenchmarkRecorder {
+   public:
+    struct Summary {
+        uint64_t count;
+        uint32_t min;
+        uint32_t max;
+        double   mean;
+        uint32_t p50;
+        uint32_t p90;
+        uint32_t p99;
+        uint32_t p999;
+    };
+
+    static BenchmarkRecorder& instance();
+
+    void record(const char* name, uint32_t elapsed);
+    void reset();
+    bool has(const std::string& name) const;
+
+    std::map<std::string, Summary> summarize() const;
+
+    /**
+     * @brief Writes all summaries and `metadata` as JSON to `path`.
+     */
+    bool write_json(const std::string& path, const std::map<std::string, std::string>& metadata) const;
+
+    /**
+     * @brief Output path for a benchmark: `QMK_BENCHMARK_OUTPUT` if set in the
+     * environment, otherwise `.build/test/<name>.benchmark.json`.
+     */
+    static std::string output_path(const std::string& name);
+
+    /**
+     * @brief Loop count for a benchmark: `QMK_BENCHMARK_LOOPS` if set in the
+     * environment, otherwise `default_loops`.
+     */
+    static uint32_t loops(uint32_t default_loops);
+
+   private:
+    struct Histogram {
+        uint64_t              count = 0;
+        uint64_t              sum   = 0;
+        uint32_t              min   = UINT32_MAX;
+        uint32_t              max   = 0;
+        std::vector<uint64_t> buckets;
+    };
+
+    static size_t   bucket_of(uint32_t value);
+    static uint32_t bucket_value(size_t bucket);
+    static uint32_t percentile(const Histogram& histogram, double fraction);
+
+    std::unordered_map<const char*, std::string> m_names;
+    std::map<std::string, Histogram>             m_histograms;
+};
@@ -99,6 +99,9 @@ void TestFixture::add_key(KeymapKey key) {
     }
 
     this->keymap.push_back(key);
+#ifdef LAYER_LOOKUP_CACHE
+    clear_effective_layers_cache();
+#endif
 }
 
 void TestFixture::tap_key(KeymapKey key, unsigned delay_ms) {
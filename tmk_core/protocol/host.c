@@ -30,6 +30,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "joystick.h"
 #endif
 
+#ifdef OUTPUT_QUEUE_ENABLE
+#    include "output_queue.h"
+#endif
+
 #ifdef BLUETOOTH_ENABLE
 #    include "bluetooth.h"
 #    include "outputselect.h"
@@ -73,6 +77,10 @@ led_t host_keyboard_led_state(void) {
 
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
+#ifdef OUTPUT_QUEUE_ENABLE
+    if (output_queue_keyboard(report)) return;
+#endif
+
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_keyboard(report);
@@ -107,6 +115,9 @@ void host_keyboard_send(report_keyboard_t *report) {
 }
 
 void host_mouse_send(report_mouse_t *report) {
+#ifdef OUTPUT_QUEUE_ENABLE
+    if (output_queue_mouse(report)) return;
+#endif
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_mouse(report);
@@ -127,6 +138,9 @@ void host_mouse_send(report_mouse_t *report) {
 }
 
 void host_system_send(uint16_t usage) {
+#ifdef OUTPUT_QUEUE_ENABLE
+    if (output_queue_extra(REPORT_ID_SYSTEM, usage)) return;
+#endif
     if (usage == last_system_usage) return;
     last_system_usage = usage;
 
@@ -140,6 +154,9 @@ void host_system_send(uint16_t usage) {
 }
 
 void host_consumer_send(uint16_t usage) {
+#ifdef OUTPUT_QUEUE_ENABLE
+    if (output_queue_extra(REPORT_ID_CONSUMER, usage)) return;
+#endif
     if (usage == last_consumer_usage) return;
     last_consumer_usage = usage;
 
@@ -31,24 +31,79 @@ static int8_t cb_tail  = 0;
 static int8_t cb_count = 0;
 #endif
 
-/** \brief has_anykey
- *
- * FIXME: Needs doc
+/* Keys held in the report last worked on, one bit per keycode, so that finding a key or counting them doesn't need to
+ * scan the report. Working on another report, or the same one in the other protocol, rebuilds it from that report.
  */
-uint8_t has_anykey(report_keyboard_t* keyboard_report) {
-    uint8_t  cnt = 0;
-    uint8_t* p   = keyboard_report->keys;
-    uint8_t  lp  = sizeof(keyboard_report->keys);
+static struct {
+    report_keyboard_t* report;
+    bool               nkro;
+    uint8_t            count;
+    uint8_t            bits[256 / 8];
+} key_state;
+
+static inline bool is_nkro_report(void) {
 #ifdef NKRO_ENABLE
-    if (keyboard_protocol && keymap_config.nkro) {
-        p  = keyboard_report->nkro.bits;
-        lp = sizeof(keyboard_report->nkro.bits);
+    return keyboard_protocol && keymap_config.nkro;
+#else
+    return false;
+#endif
+}
+
+static inline bool key_state_has(uint8_t code) {
+    return key_state.bits[code >> 3] & (1 << (code & 7));
+}
+
+static inline void key_state_add(uint8_t code) {
+    if (code != KC_NO && !key_state_has(code)) {
+        key_state.bits[code >> 3] |= 1 << (code & 7);
+        key_state.count++;
+    }
+}
+
+static inline void key_state_del(uint8_t code) {
+    if (key_state_has(code)) {
+        key_state.bits[code >> 3] &= ~(1 << (code & 7));
+        key_state.count--;
+    }
+}
+
+static void key_state_reset(report_keyboard_t* keyboard_report, bool nkro) {
+    key_state.report = keyboard_report;
+    key_state.nkro   = nkro;
+    key_state.count  = 0;
+    memset(key_state.bits, 0, sizeof(key_state.bits));
+}
+
+static void key_state_sync(report_keyboard_t* keyboard_report, bool nkro) {
+    if (key_state.report == keyboard_report && key_state.nkro == nkro) {
+        return;
+    }
+
+    key_state_reset(keyboard_report, nkro);
+#ifdef NKRO_ENABLE
+    if (nkro) {
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_BITS; i++) {
+            for (uint8_t bits = keyboard_report->nkro.bits[i], bit = 0; bits; bits >>= 1, bit++) {
+                if (bits & 1) {
+                    key_state_add(i << 3 | bit);
+                }
+            }
+        }
+        return;
     }
 #endif
-    while (lp--) {
-        if (*p++) cnt++;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        key_state_add(keyboard_report->keys[i]);
     }
-    return cnt;
+}
+
+/** \brief has_anykey
+ *
+ * Returns the number of keys in the report, not counting modifiers
+ */
+uint8_t has_anykey(report_keyboard_t* keyboard_report) {
+    key_state_sync(keyboard_report, is_nkro_report());
+    return key_state.count;
 }
 
 /** \brief get_first_key
@@ -58,9 +113,17 @@ uint8_t has_anykey(report_keyboard_t* keyboard_report) {
 uint8_t get_first_key(report_keyboard_t* keyboard_report) {
 #ifdef NKRO_ENABLE
     if (keyboard_protocol && keymap_config.nkro) {
+        key_state_sync(keyboard_report, true);
+        if (!key_state.count) {
+            return KC_NO;
+        }
+        // Bounded all the same, in case the bitmap was written to behind key_state's back
         uint8_t i = 0;
         for (; i < KEYBOARD_REPORT_BITS && !keyboard_report->nkro.bits[i]; i++)
             ;
+        if (i == KEYBOARD_REPORT_BITS) {
+            return KC_NO;
+        }
         return i << 3 | biton(keyboard_report->nkro.bits[i]);
     }
 #endif
@@ -87,21 +150,8 @@ bool is_key_pressed(report_keyboard_t* keyboard_report, uint8_t key) {
     if (key == KC_NO) {
         return false;
     }
-#ifdef NKRO_ENABLE
-    if (keyboard_protocol && keymap_config.nkro) {
-        if ((key >> 3) < KEYBOARD_REPORT_BITS) {
-            return keyboard_report->nkro.bits[key >> 3] & 1 << (key & 7);
-        } else {
-            return false;
-        }
-    }
-#endif
-    for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
-        if (keyboard_report->keys[i] == key) {
-            return true;
-        }
-    }
-    return false;
+    key_state_sync(keyboard_report, is_nkro_report());
+    return key_state_has(key);
 }
 
 /** \brief add key byte
@@ -109,6 +159,7 @@ bool is_key_pressed(report_keyboard_t* keyboard_report, uint8_t key) {
  * FIXME: Needs doc
  */
 void add_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
+    key_state_sync(keyboard_report, false);
 #ifdef RING_BUFFERED_6KRO_REPORT_ENABLE
     int8_t i     = cb_head;
     int8_t empty = -1;
@@ -127,6 +178,7 @@ void add_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
                 // buffer is full
                 if (empty == -1) {
                     // pop head when has no empty space
+                    key_state_del(keyboard_report->keys[cb_head]);
                     cb_head = RO_INC(cb_head);
                     cb_count--;
                 } else {
@@ -152,20 +204,17 @@ void add_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
     keyboard_report->keys[cb_tail] = code;
     cb_tail                        = RO_INC(cb_tail);
     cb_count++;
+    key_state_add(code);
 #else
-    int8_t i     = 0;
-    int8_t empty = -1;
-    for (; i < KEYBOARD_REPORT_KEYS; i++) {
-        if (keyboard_report->keys[i] == code) {
-            break;
-        }
-        if (empty == -1 && keyboard_report->keys[i] == 0) {
-            empty = i;
-        }
+    // Keys that are already in, and any once the report is full, are left out
+    if (code == KC_NO || key_state_has(code) || key_state.count >= KEYBOARD_REPORT_KEYS) {
+        return;
     }
-    if (i == KEYBOARD_REPORT_KEYS) {
-        if (empty != -1) {
-            keyboard_report->keys[empty] = code;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard_report->keys[i] == 0) {
+            keyboard_report->keys[i] = code;
+            key_state_add(code);
+            break;
         }
     }
 #endif
@@ -176,12 +225,14 @@ void add_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
  * FIXME: Needs doc
  */
 void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
+    key_state_sync(keyboard_report, false);
 #ifdef RING_BUFFERED_6KRO_REPORT_ENABLE
     uint8_t i = cb_head;
     if (cb_count) {
         do {
             if (keyboard_report->keys[i] == code) {
                 keyboard_report->keys[i] = 0;
+                key_state_del(code);
                 cb_count--;
                 if (cb_count == 0) {
                     // reset head and tail
@@ -202,9 +253,14 @@ void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
         } while (i != cb_tail);
     }
 #else
+    if (!key_state_has(code)) {
+        return;
+    }
     for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
         if (keyboard_report->keys[i] == code) {
             keyboard_report->keys[i] = 0;
+            key_state_del(code);
+            break;
         }
     }
 #endif
@@ -216,8 +272,10 @@ void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
  * FIXME: Needs doc
  */
 void add_key_bit(report_keyboard_t* keyboard_report, uint8_t code) {
+    key_state_sync(keyboard_report, true);
     if ((code >> 3) < KEYBOARD_REPORT_BITS) {
         keyboard_report->nkro.bits[code >> 3] |= 1 << (code & 7);
+        key_state_add(code);
     } else {
         dprintf("add_key_bit: can't add: %02X\n", code);
     }
@@ -228,8 +286,10 @@ void add_key_bit(report_keyboard_t* keyboard_report, uint8_t code) {
  * FIXME: Needs doc
  */
 void del_key_bit(report_keyboard_t* keyboard_report, uint8_t code) {
+    key_state_sync(keyboard_report, true);
     if ((code >> 3) < KEYBOARD_REPORT_BITS) {
         keyboard_report->nkro.bits[code >> 3] &= ~(1 << (code & 7));
+        key_state_del(code);
     } else {
         dprintf("del_key_bit: can't del: %02X\n", code);
     }
@@ -270,6 +330,10 @@ void del_key_from_report(report_keyboard_t* keyboard_report, uint8_t key) {
  */
 void clear_keys_from_report(report_keyboard_t* keyboard_report) {
     // not clear mods
+    key_state_reset(keyboard_report, is_nkro_report());
+#ifdef RING_BUFFERED_6KRO_REPORT_ENABLE
+    cb_head = cb_tail = cb_count = 0;
+#endif
 #ifdef NKRO_ENABLE
     if (keyboard_protocol && keymap_config.nkro) {
         memset(keyboard_report->nkro.bits, 0, sizeof(keyboard_report->nkro.bits));
@@ -135,6 +135,8 @@ enum desktop_usages {
 #        define KEYBOARD_REPORT_BITS (NKRO_EPSIZE - 1)
 #        undef NKRO_SHARED_EP
 #        undef MOUSE_SHARED_EP
+#    elif defined(PROTOCOL_TEST)
+#        define KEYBOARD_REPORT_BITS 30
 #    else
 #        error "NKRO not supported with this protocol"
 #    endif
@@ -329,6 +331,9 @@ static inline uint16_t KEYCODE2CONSUMER(uint8_t key) {
     }
 }
 
+/* The functions below keep track of which keys are in the report they last worked on, instead of scanning it. A report
+ * that gets reused for something else, rather than changed through them, needs clearing with clear_keys_from_report().
+ */
 uint8_t has_anykey(report_keyboard_t* keyboard_report);
 uint8_t get_first_key(report_keyboard_t* keyboard_report);
 bool    is_key_pressed(report_keyboard_t* keyboard_report, uint8_t key);
@@ -0,0 +1,257 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <random>
+
+extern "C" {
+#include "report.h"
+#include "host.h"
+#include "keycode_config.h"
+
+uint8_t         keyboard_protocol = 1;
+keymap_config_t keymap_config;
+}
+
+namespace {
+
+/* What the report holds, found the slow way */
+bool in_report(const report_keyboard_t &report, uint8_t key) {
+    if (keyboard_protocol && keymap_config.nkro) {
+        return (key >> 3) < KEYBOARD_REPORT_BITS && (report.nkro.bits[key >> 3] & (1 << (key & 7)));
+    }
+    for (auto k : report.keys) {
+        if (k == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t keys_in_report(const report_keyboard_t &report) {
+    uint8_t count = 0;
+    for (int key = KC_A; key < 256; key++) {
+        count += in_report(report, key);
+    }
+    return count;
+}
+
+} // namespace
+
+class Report : public ::testing::Test {
+   protected:
+    report_keyboard_t report;
+
+    void SetUp() override {
+        keyboard_protocol  = 1;
+        keymap_config.nkro = false;
+        memset(&report, 0, sizeof(report));
+        clear_keys_from_report(&report);
+    }
+
+    void use_nkro(bool nkro) {
+        keymap_config.nkro = nkro;
+        clear_keys_from_report(&report);
+    }
+};
+
+TEST_F(Report, AddAndRemoveKeys) {
+    add_key_to_report(&report, KC_A);
+    add_key_to_report(&report, KC_B);
+    EXPECT_EQ(has_anykey(&report), 2);
+    EXPECT_TRUE(is_key_pressed(&report, KC_A));
+    EXPECT_TRUE(is_key_pressed(&report, KC_B));
+    EXPECT_FALSE(is_key_pressed(&report, KC_C));
+    EXPECT_EQ(report.keys[0], KC_A);
+    EXPECT_EQ(report.keys[1], KC_B);
+
+    del_key_from_report(&report, KC_A);
+    EXPECT_EQ(has_anykey(&report), 1);
+    EXPECT_FALSE(is_key_pressed(&report, KC_A));
+    EXPECT_EQ(report.keys[0], KC_NO);
+    EXPECT_EQ(report.keys[1], KC_B);
+}
+
+TEST_F(Report, AddingAKeyTwiceKeepsOneCopy) {
+    add_key_to_report(&report, KC_A);
+    add_key_to_report(&report, KC_A);
+    EXPECT_EQ(has_anykey(&report), 1);
+    EXPECT_EQ(report.keys[1], KC_NO);
+
+    del_key_from_report(&report, KC_A);
+    EXPECT_EQ(has_anykey(&report), 0);
+    EXPECT_FALSE(is_key_pressed(&report, KC_A));
+}
+
+TEST_F(Report, NoKeyIsNeverInTheReport) {
+    add_key_to_report(&report, KC_NO);
+    EXPECT_EQ(has_anykey(&report), 0);
+    EXPECT_FALSE(is_key_pressed(&report, KC_NO));
+    del_key_from_report(&report, KC_NO);
+    EXPECT_EQ(has_anykey(&report), 0);
+}
+
+TEST_F(Report, RemovingAMissingKeyChangesNothing) {
+    add_key_to_report(&report, KC_A);
+    report_keyboard_t before = report;
+    del_key_from_report(&report, KC_B);
+    EXPECT_EQ(memcmp(&before, &report, sizeof(report)), 0);
+    EXPECT_EQ(has_anykey(&report), 1);
+}
+
+TEST_F(Report, RolloverBeyondSixKeys) {
+    for (uint8_t key = KC_A; key < KC_A + KEYBOARD_REPORT_KEYS + 1; key++) {
+        add_key_to_report(&report, key);
+    }
+    EXPECT_EQ(has_anykey(&report), KEYBOARD_REPORT_KEYS);
+#ifdef RING_BUFFERED_6KRO_REPORT_ENABLE
+    // The oldest key makes room for the newest one
+    EXPECT_FALSE(is_key_pressed(&report, KC_A));
+    EXPECT_TRUE(is_key_pressed(&report, KC_G));
+#else
+    // The newest key is left out
+    EXPECT_TRUE(is_key_pressed(&report, KC_A));
+    EXPECT_FALSE(is_key_pressed(&report, KC_G));
+#endif
+    EXPECT_EQ(keys_in_report(report), KEYBOARD_REPORT_KEYS);
+
+    // A released key frees a slot for the next one pressed
+    del_key_from_report(&report, KC_C);
+    EXPECT_EQ(has_anykey(&report), KEYBOARD_REPORT_KEYS - 1);
+    add_key_to_report(&report, KC_H);
+    EXPECT_EQ(has_anykey(&report), KEYBOARD_REPORT_KEYS);
+    EXPECT_TRUE(is_key_pressed(&report, KC_H));
+    EXPECT_FALSE(is_key_pressed(&report, KC_C));
+}
+
+#ifndef RING_BUFFERED_6KRO_REPORT_ENABLE
+TEST_F(Report, ReleasedSlotIsReused) {
+    add_key_to_report(&report, KC_A);
+    add_key_to_report(&report, KC_B);
+    add_key_to_report(&report, KC_C);
+    del_key_from_report(&report, KC_B);
+    add_key_to_report(&report, KC_D);
+    EXPECT_EQ(report.keys[1], KC_D);
+    EXPECT_EQ(report.keys[3], KC_NO);
+}
+#endif
+
+TEST_F(Report, ClearingEmptiesTheReport) {
+    add_key_to_report(&report, KC_A);
+    add_key_to_report(&report, KC_B);
+    clear_keys_from_report(&report);
+    EXPECT_EQ(has_anykey(&report), 0);
+    EXPECT_FALSE(is_key_pressed(&report, KC_A));
+    EXPECT_EQ(keys_in_report(report), 0);
+}
+
+TEST_F(Report, NkroReportsEveryKey) {
+    use_nkro(true);
+    for (uint8_t key = KC_A; key <= KC_SLASH; key++) {
+        add_key_to_report(&report, key);
+    }
+    EXPECT_EQ(has_anykey(&report), KC_SLASH - KC_A + 1);
+    EXPECT_EQ(keys_in_report(report), KC_SLASH - KC_A + 1);
+    EXPECT_TRUE(is_key_pressed(&report, KC_A));
+    EXPECT_TRUE(is_key_pressed(&report, KC_SLASH));
+
+    del_key_from_report(&report, KC_M);
+    EXPECT_EQ(has_anykey(&report), KC_SLASH - KC_A);
+    EXPECT_FALSE(is_key_pressed(&report, KC_M));
+}
+
+TEST_F(Report, NkroIgnoresKeysBeyondTheBitmap) {
+    use_nkro(true);
+    uint8_t beyond = KEYBOARD_REPORT_BITS * 8;
+    add_key_to_report(&report, beyond);
+    EXPECT_EQ(has_anykey(&report), 0);
+    EXPECT_FALSE(is_key_pressed(&report, beyond));
+
+    uint8_t last = KEYBOARD_REPORT_BITS * 8 - 1;
+    add_key_to_report(&report, last);
+    EXPECT_EQ(has_anykey(&report), 1);
+    EXPECT_TRUE(is_key_pressed(&report, last));
+}
+
+TEST_F(Report, FirstKey) {
+    add_key_to_report(&report, KC_Z);
+    EXPECT_EQ(get_first_key(&report), KC_Z);
+
+    use_nkro(true);
+    EXPECT_EQ(get_first_key(&report), KC_NO);
+    add_key_to_report(&report, KC_Z);
+    add_key_to_report(&report, KC_C);
+    EXPECT_EQ(get_first_key(&report), KC_C);
+    del_key_from_report(&report, KC_C);
+    EXPECT_EQ(get_first_key(&report), KC_Z);
+}
+
+TEST_F(Report, FirstKeyOfABitmapClearedDirectly) {
+    use_nkro(true);
+    add_key_to_report(&report, KC_Z);
+    memset(report.nkro.bits, 0, sizeof(report.nkro.bits));
+    EXPECT_EQ(get_first_key(&report), KC_NO);
+}
+
+TEST_F(Report, BootProtocolUsesSixKeys) {
+    keymap_config.nkro = true;
+    keyboard_protocol  = 0;
+    clear_keys_from_report(&report);
+    for (uint8_t key = KC_A; key < KC_A + KEYBOARD_REPORT_KEYS + 2; key++) {
+        add_key_to_report(&report, key);
+    }
+    EXPECT_EQ(has_anykey(&report), KEYBOARD_REPORT_KEYS);
+    EXPECT_EQ(keys_in_report(report), KEYBOARD_REPORT_KEYS);
+}
+
+TEST_F(Report, SwitchingProtocolsAfterClearing) {
+    add_key_to_report(&report, KC_A);
+    use_nkro(true);
+    EXPECT_EQ(has_anykey(&report), 0);
+    add_key_to_report(&report, KC_B);
+    EXPECT_TRUE(is_key_pressed(&report, KC_B));
+    EXPECT_FALSE(is_key_pressed(&report, KC_A));
+
+    use_nkro(false);
+    EXPECT_EQ(has_anykey(&report), 0);
+    add_key_to_report(&report, KC_C);
+    EXPECT_EQ(report.keys[0], KC_C);
+    EXPECT_EQ(has_anykey(&report), 1);
+}
+
+TEST_F(Report, ReportsAreTrackedApart) {
+    report_keyboard_t other = {};
+    clear_keys_from_report(&other);
+    add_key_to_report(&other, KC_B);
+    add_key_to_report(&other, KC_C);
+    add_key_to_report(&report, KC_A);
+
+    EXPECT_EQ(has_anykey(&other), 2);
+    EXPECT_EQ(has_anykey(&report), 1);
+    EXPECT_TRUE(is_key_pressed(&other, KC_B));
+    EXPECT_FALSE(is_key_pressed(&report, KC_B));
+    del_key_from_report(&other, KC_B);
+    EXPECT_EQ(has_anykey(&other), 1);
+    EXPECT_TRUE(is_key_pressed(&report, KC_A));
+}
+
+TEST_F(Report, MatchesTheReportUnderRandomPresses) {
+    std::mt19937 rng(1);
+    for (bool nkro : {false, true}) {
+        use_nkro(nkro);
+        for (int i = 0; i < 10000; i++) {
+            // Few enough keys that 6KRO both fills up and empties out
+            uint8_t key = KC_A + rng() % 12;
+            if (rng() % 2) {
+                add_key_to_report(&report, key);
+            } else {
+                del_key_from_report(&report, key);
+            }
+            ASSERT_EQ(has_anykey(&report), keys_in_report(report)) << "step " << i;
+            for (uint8_t k = KC_A; k < KC_A + 12; k++) {
+                ASSERT_EQ(is_key_pressed(&report, k), in_report(report, k)) << "step " << i << " key " << +k;
+            }
+        }
+    }
+}
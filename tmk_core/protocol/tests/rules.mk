@@ -0,0 +1,9 @@
+report_DEFS := -DPROTOCOL_TEST -DNKRO_ENABLE -DNO_DEBUG
+
+report_SRC := \
+	$(TMK_PATH)/protocol/tests/report_tests.cpp \
+	$(TMK_PATH)/protocol/report.c \
+	$(QUANTUM_PATH)/bitwise.c
+
+report_ring_buffered_DEFS := $(report_DEFS) -DRING_BUFFERED_6KRO_REPORT_ENABLE
+report_ring_buffered_SRC := $(report_SRC)
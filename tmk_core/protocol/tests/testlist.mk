@@ -0,0 +1 @@
+TEST_LIST += report report_ring_buffered